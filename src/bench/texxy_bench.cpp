@@ -0,0 +1,608 @@
+// src/bench/texxy_bench.cpp
+/*
+  texxy/texxy_bench.cpp
+
+  Times loading, charset detection, highlighting, searching, sorting and layout
+  on generated texts and prints the results as JSON, so that releases can be
+  compared. It needs no display:
+
+      QT_QPA_PLATFORM=offscreen texxy_bench [--size MiB] [--runs N] [--output file]
+*/
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPlainTextDocumentLayout>
+#include <QStringEncoder>
+#include <QTemporaryDir>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "encoding.h"
+#include "highlighter.h"
+#include "linesplitter.h"
+#include "loading.h"
+#include "regexcache.h"
+#include "textedit.h"
+#include "textscan.h"
+
+namespace Texxy {
+
+namespace {
+
+// generated texts
+
+// a fixed generator, so that every run sees the same texts
+class Random {
+   public:
+    explicit Random(quint32 seed) : state_(seed) {}
+    int below(int n) {
+        state_ = state_ * 1664525u + 1013904223u;
+        return static_cast<int>((state_ >> 8) % static_cast<quint32>(n));
+    }
+
+   private:
+    quint32 state_;
+};
+
+QString asciiLog(qint64 size) {
+    static const char* const levels[] = {"INFO ", "DEBUG", "WARN ", "ERROR"};
+    Random rnd(1);
+    QString text;
+    text.reserve(size);
+    while (text.size() < size) {
+        text += QString::asprintf(
+            "2025-%02d-%02dT%02d:%02d:%02d.%03dZ %s [worker-%d] GET /api/v1/items/%d?page=%d status=%d "
+            "took=%dms user=\"user%d@example.org\"\n",
+            1 + rnd.below(12), 1 + rnd.below(28), rnd.below(24), rnd.below(60), rnd.below(60), rnd.below(1000),
+            levels[rnd.below(4)], rnd.below(32), rnd.below(100000), rnd.below(50),
+            rnd.below(8) ? 200 : 404 + rnd.below(100), rnd.below(2000), rnd.below(10000));
+    }
+    return text;
+}
+
+QString cjkText(qint64 size) {
+    Random rnd(2);
+    QString text;
+    text.reserve(size / 3);
+    while (text.size() * 3 < size) {  // mostly 3-byte sequences in UTF-8
+        const int words = 8 + rnd.below(24);
+        for (int i = 0; i < words; ++i) {
+            const int len = 1 + rnd.below(4);
+            for (int j = 0; j < len; ++j)
+                text += QChar(0x4E00 + rnd.below(0x51A6));
+            text += i + 1 == words ? QChar(0x3002) : rnd.below(6) ? QChar(0x3001) : QChar(QLatin1Char(' '));
+            if (rnd.below(10) == 0)
+                text += QString::number(rnd.below(10000));
+        }
+        text += QLatin1Char('\n');
+    }
+    return text;
+}
+
+QString minifiedJson(qint64 size) {
+    Random rnd(3);
+    QString text;
+    text.reserve(size);
+    text += QLatin1Char('[');
+    for (int id = 0; text.size() < size; ++id) {
+        if (id > 0)
+            text += QLatin1Char(',');
+        text += QString::asprintf(
+            "{\"id\":%d,\"name\":\"item %d\",\"price\":%d.%02d,\"tags\":[\"alpha\",\"beta\",\"t%d\"],"
+            "\"active\":%s,\"meta\":{\"created\":\"2025-01-%02d\",\"score\":0.%d,\"note\":null}}",
+            id, id, rnd.below(1000), rnd.below(100), rnd.below(50), rnd.below(2) ? "true" : "false",
+            1 + rnd.below(28), rnd.below(1000));
+    }
+    text += QLatin1Char(']');  // a single line
+    return text;
+}
+
+QString deepYaml(qint64 size) {
+    Random rnd(4);
+    QString text;
+    text.reserve(size);
+    text += QStringLiteral("---\nroot:\n");
+    for (int n = 0; text.size() < size; ++n) {
+        const int depth = 1 + rnd.below(12);
+        for (int d = 1; d <= depth; ++d)
+            text += QString(2 * d, QLatin1Char(' ')) + QStringLiteral("level%1_%2:\n").arg(d).arg(n);
+        const QString indent(2 * (depth + 1), QLatin1Char(' '));
+        text += indent + QStringLiteral("# entry %1\n").arg(n);
+        text += indent + QStringLiteral("name: \"node %1\"\n").arg(n);
+        text += indent + QStringLiteral("count: %1\n").arg(rnd.below(100000));
+        text += indent + QStringLiteral("enabled: %1\n").arg(rnd.below(2) ? QLatin1String("true")
+                                                                           : QLatin1String("false"));
+        text += indent + QStringLiteral("anchors: &a%1 'single quoted'\n").arg(n);
+        text += indent + QStringLiteral("items:\n");
+        for (int i = 0; i < 3; ++i)
+            text += indent + QStringLiteral("  - item %1 # %2\n").arg(i).arg(rnd.below(100));
+    }
+    return text;
+}
+
+QString shellScript(qint64 size) {
+    QString text;
+    text.reserve(size);
+    text += QStringLiteral("#!/bin/bash\nset -euo pipefail\n\n");
+    for (int n = 0; text.size() < size; ++n) {
+        text += QStringLiteral(
+                    "# build step %1\n"
+                    "build_%1() {\n"
+                    "    local dir=\"${1:-/tmp/build_%1}\"\n"
+                    "    if [[ -d \"$dir\" ]]; then\n"
+                    "        for f in \"$dir\"/*.o; do\n"
+                    "            echo \"removing $f\" >&2 && rm -f -- \"$f\"\n"
+                    "        done\n"
+                    "    fi\n"
+                    "    case \"${2:-}\" in\n"
+                    "        debug) CFLAGS='-O0 -g' ;;\n"
+                    "        *) CFLAGS=\"-O2 -DNDEBUG\" ;;\n"
+                    "    esac\n"
+                    "    cat <<EOF > \"$dir/config_%1.h\"\n"
+                    "#define STEP %1\n"
+                    "#define FLAGS \"$CFLAGS\"\n"
+                    "EOF\n"
+                    "    result=$(make -C \"$dir\" -j\"$(nproc)\" 2>&1 | tail -n 5)\n"
+                    "    printf '%s\\n' \"${result}\"  # keep the tail\n"
+                    "}\n\n")
+                    .arg(n);
+    }
+    return text;
+}
+
+QString cppSource(qint64 size) {
+    QString text;
+    text.reserve(size);
+    for (int n = 0; text.size() < size; ++n) {
+        text += QStringLiteral(
+                    "/* Returns the sum of the values in range %1. */\n"
+                    "template <typename T>\n"
+                    "static inline T sum%1(const std::vector<T>& values, std::size_t from = 0) {\n"
+                    "    T total{};  // accumulates \"values\"\n"
+                    "    for (std::size_t i = from; i < values.size(); ++i)\n"
+                    "        total += values[i] * 0x%1 + 'a';\n"
+                    "    return total;\n"
+                    "}\n\n")
+                    .arg(n);
+    }
+    return text;
+}
+
+QString pythonSource(qint64 size) {
+    QString text;
+    text.reserve(size);
+    for (int n = 0; text.size() < size; ++n) {
+        text += QStringLiteral(
+                    "class Item%1(Base):\n"
+                    "    \"\"\"An item with\n"
+                    "    a multi-line docstring.\"\"\"\n"
+                    "\n"
+                    "    def value(self, factor: float = 1.5) -> float:\n"
+                    "        # scale the value\n"
+                    "        return sum(x * factor for x in self.values if x > %1) or None\n"
+                    "\n"
+                    "    def __repr__(self):\n"
+                    "        return f'Item%1({self.name!r}, {len(self.values)})'\n\n")
+                    .arg(n);
+    }
+    return text;
+}
+
+// Java is highlighted with thousands of class names
+QString javaSource(qint64 size) {
+    QString text;
+    text.reserve(size);
+    for (int n = 0; text.size() < size; ++n) {
+        text += QStringLiteral(
+                    "/** Collects the entries of map %1. */\n"
+                    "public static List<Map.Entry<String, Integer>> entries%1(HashMap<String, Integer> map) {\n"
+                    "    ArrayList<Map.Entry<String, Integer>> list = new ArrayList<>(map.entrySet());\n"
+                    "    if (list.isEmpty()) throw new IllegalStateException(\"empty map %1\");\n"
+                    "    Collections.sort(list, (a, b) -> Integer.compare(a.getValue(), b.getValue()));\n"
+                    "    return Collections.unmodifiableList(list);  // sorted by value\n"
+                    "}\n\n")
+                    .arg(n);
+    }
+    return text;
+}
+
+QString markdownText(qint64 size) {
+    QString text;
+    text.reserve(size);
+    for (int n = 0; text.size() < size; ++n) {
+        text += QStringLiteral(
+                    "## Section %1\n\n"
+                    "Some *emphasized* and **strong** text with `code`, a [link](https://example.org/%1) and\n"
+                    "a list:\n\n"
+                    "- first item\n"
+                    "- second item with ~~strikeout~~\n\n"
+                    "```sh\necho \"block %1\"\n```\n\n"
+                    "> a quotation\n\n")
+                    .arg(n);
+    }
+    return text;
+}
+
+QString htmlText(qint64 size) {
+    QString text;
+    text.reserve(size);
+    text += QStringLiteral("<!DOCTYPE html>\n<html>\n<body>\n");
+    for (int n = 0; text.size() < size; ++n) {
+        text += QStringLiteral(
+                    "<div class=\"row\" id=\"r%1\" style=\"color: #336; margin: 2px\">\n"
+                    "  <!-- row %1 -->\n"
+                    "  <a href=\"/items/%1?x=1&amp;y=2\">Item %1</a>\n"
+                    "  <script>let n = %1; if (n > 0) { console.log('row', n); }</script>\n"
+                    "</div>\n")
+                    .arg(n);
+    }
+    text += QStringLiteral("</body>\n</html>\n");
+    return text;
+}
+
+QByteArray utf16Bytes(const QString& text) {
+    QStringEncoder encoder(QStringConverter::Utf16LE, QStringConverter::Flag::WriteBom);
+    return encoder.encode(text);
+}
+
+// timing and reporting
+
+struct Timing {
+    double minMs = 0;
+    double medianMs = 0;
+};
+
+// "prepare" runs before each timed call and isn't timed
+Timing measure(int runs, const std::function<void()>& work, const std::function<void()>& prepare = {}) {
+    std::vector<double> times;
+    times.reserve(static_cast<std::size_t>(runs));
+    for (int i = 0; i < runs; ++i) {
+        if (prepare)
+            prepare();
+        QElapsedTimer timer;
+        timer.start();
+        work();
+        times.push_back(static_cast<double>(timer.nsecsElapsed()) / 1e6);
+    }
+    std::sort(times.begin(), times.end());
+    return {times.front(), times.at(times.size() / 2)};
+}
+
+class Report {
+   public:
+    void add(const QString& name, const QString& corpus, qint64 bytes, const Timing& t, QJsonObject extra = {}) {
+        extra.insert(QStringLiteral("name"), name);
+        extra.insert(QStringLiteral("corpus"), corpus);
+        extra.insert(QStringLiteral("bytes"), bytes);
+        extra.insert(QStringLiteral("min_ms"), t.minMs);
+        extra.insert(QStringLiteral("median_ms"), t.medianMs);
+        if (bytes > 0 && t.minMs > 0)
+            extra.insert(QStringLiteral("mib_per_s"), bytes / (1024.0 * 1024.0) / (t.minMs / 1000.0));
+        results_.append(extra);
+        QTextStream(stderr) << name << ' ' << corpus << ": " << t.minMs << " ms" << Qt::endl;
+    }
+    QJsonArray results() const { return results_; }
+
+   private:
+    QJsonArray results_;
+};
+
+// benchmarks
+
+void benchLoading(Report& report, int runs, const QString& corpus, const QString& path, qint64 bytes) {
+    QString charset;
+    qsizetype chars = 0;
+    const Timing t = measure(runs, [&] {
+        Loading loading(path, QString(), false, 0, 0, false, false);
+        loading.setSkipNonText(false);
+        QObject::connect(
+            &loading, &Loading::completed, &loading,
+            [&](const QString& text, const QString&, const QString& cs) {
+                charset = cs;
+                chars = text.size();
+            },
+            Qt::DirectConnection);
+        loading.start();
+        loading.wait();
+    });
+    report.add(QStringLiteral("load"), corpus, bytes, t,
+               {{QStringLiteral("charset"), charset}, {QStringLiteral("chars"), static_cast<qint64>(chars)}});
+}
+
+void benchCharset(Report& report, int runs, const QString& corpus, const QByteArray& data) {
+    QString charset;
+    Timing t = measure(runs, [&] { charset = detectCharset(data); });
+    report.add(QStringLiteral("detect_charset"), corpus, data.size(), t, {{QStringLiteral("charset"), charset}});
+    t = measure(runs, [&] { charset = detectCharsetFromSamples(data); });
+    report.add(QStringLiteral("detect_charset_samples"), corpus, data.size(), t,
+               {{QStringLiteral("charset"), charset}});
+}
+
+// lines that are too long are split like when the file is opened
+QString asLoaded(const QString& text) {
+    LineSplitter splitter;
+    return splitter.split(text);
+}
+
+void benchHighlighting(Report& report, int runs, const QString& lang, const QString& text) {
+    QTextDocument doc;
+    doc.setDocumentLayout(new QPlainTextDocumentLayout(&doc));
+    doc.setPlainText(asLoaded(text));
+    QTextCursor end(&doc);
+    end.movePosition(QTextCursor::End);
+    // the whole document is "visible", so that every block gets its full formatting
+    Highlighter highlighter(&doc, lang, QTextCursor(&doc), end, false, false, false, 180);
+    // patterns that are built while highlighting should be compiled once, not once per block
+    const quint64 compilations = RegexCache::compilations();
+    const Timing t = measure(runs, [&] { highlighter.rehighlight(); });
+    report.add(QStringLiteral("highlight"), lang, text.toUtf8().size(), t,
+               {{QStringLiteral("blocks"), doc.blockCount()},
+                {QStringLiteral("us_per_block"), t.minMs * 1000.0 / std::max(1, doc.blockCount())},
+                {QStringLiteral("regex_compilations"), qint64(RegexCache::compilations() - compilations)}});
+}
+
+void benchPropagation(Report& report, int runs, const QString& lang, const QString& text) {
+    QTextDocument doc;
+    doc.setDocumentLayout(new QPlainTextDocumentLayout(&doc));
+    doc.setPlainText(asLoaded(text));
+    QTextCursor end(doc.findBlockByNumber(std::min(60, doc.blockCount() - 1)));
+    // only the first page is "visible"; a change shouldn't be carried further
+    Highlighter highlighter(&doc, lang, QTextCursor(&doc), end, false, false, false, 180);
+    highlighter.rehighlight();
+    const Timing t = measure(runs, [&] {
+        QTextCursor cursor(&doc);
+        cursor.insertText(QStringLiteral("/*"));  // opens a comment to the end of the document
+        cursor.setPosition(0);
+        cursor.setPosition(2, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+        QCoreApplication::processEvents();
+    });
+    report.add(QStringLiteral("propagate"), lang, text.toUtf8().size(), t,
+               {{QStringLiteral("blocks"), doc.blockCount()}});
+}
+
+// runs the event loop until "done" (false after a few seconds)
+bool waitFor(const std::function<bool()>& done) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        if (timer.hasExpired(10000))
+            return false;
+        QCoreApplication::processEvents();
+        QThread::usleep(100);
+    }
+    return true;
+}
+
+/* Highlights the first page of a document in the worker thread, as the editor does,
+   and then the page after an edit that changes it, until the formats are applied. */
+void benchWorker(Report& report, int runs, const QString& lang, const QString& text) {
+    QTextDocument doc;
+    doc.setDocumentLayout(new QPlainTextDocumentLayout(&doc));
+    doc.setPlainText(asLoaded(text));
+    // the last line of the page that has text; every visible line with text gets formats
+    QTextBlock probe = doc.findBlockByNumber(std::min(60, doc.blockCount() - 1));
+    while (probe.previous().isValid() && probe.text().isEmpty())
+        probe = probe.previous();
+    const QTextCursor end(probe);
+    auto formats = [&probe] { return probe.layout()->formats(); };
+
+    std::unique_ptr<Highlighter> highlighter;
+    bool complete = true;
+    Timing t = measure(
+        runs,
+        [&] {
+            highlighter = std::make_unique<Highlighter>(&doc, lang, QTextCursor(&doc), end, false, false, false, 180,
+                                                        QHash<QString, QColor>(), true);
+            complete &= waitFor([&] { return !formats().isEmpty(); });
+        },
+        [&] { highlighter.reset(); });  // its formats are cleared
+    report.add(QStringLiteral("worker_first_page"), lang, text.toUtf8().size(), t,
+               {{QStringLiteral("blocks"), doc.blockCount()}, {QStringLiteral("complete"), complete}});
+
+    const QList<QTextLayout::FormatRange> before = formats();
+    t = measure(runs, [&] {
+        QTextCursor cursor(&doc);
+        cursor.insertText(QStringLiteral("/*"));  // the page becomes a comment
+        complete &= waitFor([&] { return formats() != before; });
+        cursor.setPosition(0);
+        cursor.setPosition(2, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+        complete &= waitFor([&] { return formats() == before; });
+    });
+    report.add(QStringLiteral("worker_edit"), lang, text.toUtf8().size(), t,
+               {{QStringLiteral("blocks"), doc.blockCount()}, {QStringLiteral("complete"), complete}});
+}
+
+void benchFinding(Report& report, int runs, const QString& corpus, TextEdit& textEdit, const QString& str,
+                  QTextDocument::FindFlags flags, bool regex) {
+    int matches = 0;
+    const Timing t = measure(runs, [&] {
+        matches = 0;
+        QTextCursor cursor(textEdit.document());
+        while (!(cursor = textEdit.finding(str, cursor, flags, regex)).isNull())
+            ++matches;
+    });
+    report.add(regex ? QStringLiteral("find_regex") : QStringLiteral("find"), corpus,
+               textEdit.document()->characterCount(), t,
+               {{QStringLiteral("pattern"), str}, {QStringLiteral("matches"), matches}});
+}
+
+void benchReplaceAll(Report& report, int runs, const QString& corpus, TextEdit& textEdit, const QString& text,
+                     const QString& str, const QString& replacement, bool regex) {
+    int count = 0;
+    const Timing t = measure(
+        runs, [&] { count = textEdit.replaceAll(str, replacement, QTextDocument::FindCaseSensitively, regex); },
+        [&] { textEdit.setPlainText(text); });
+    report.add(regex ? QStringLiteral("replace_all_regex") : QStringLiteral("replace_all"), corpus,
+               text.size(), t, {{QStringLiteral("pattern"), str}, {QStringLiteral("replacements"), count}});
+}
+
+void benchSortLines(Report& report, int runs, const QString& corpus, TextEdit& textEdit, const QString& text) {
+    const Timing t = measure(
+        runs, [&] { textEdit.sortLines(); },
+        [&] {
+            textEdit.setPlainText(text);
+            textEdit.selectAll();
+        });
+    report.add(QStringLiteral("sort_lines"), corpus, text.size(), t,
+               {{QStringLiteral("lines"), textEdit.document()->blockCount()}});
+}
+
+void benchLayout(Report& report, int runs, const QString& corpus, TextEdit& textEdit, const QString& text) {
+    QAbstractTextDocumentLayout* layout = nullptr;
+    const Timing t = measure(
+        runs,
+        [&] {
+            // blockBoundingRect() lays a block out if it isn't laid out yet
+            for (QTextBlock block = textEdit.document()->firstBlock(); block.isValid(); block = block.next())
+                layout->blockBoundingRect(block);
+        },
+        [&] {
+            textEdit.setPlainText(text);
+            layout = textEdit.document()->documentLayout();
+        });
+    report.add(QStringLiteral("layout"), corpus, text.toUtf8().size(), t,
+               {{QStringLiteral("blocks"), textEdit.document()->blockCount()},
+                {QStringLiteral("wrap"), textEdit.lineWrapMode() != QPlainTextEdit::NoWrap}});
+}
+
+}  // namespace
+
+}  // namespace Texxy
+
+int main(int argc, char** argv) {
+    using namespace Texxy;
+
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("texxy_bench"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Times Texxy's text handling on generated files."));
+    parser.addHelpOption();
+    const QCommandLineOption sizeOption(QStringLiteral("size"), QStringLiteral("Size of each corpus in MiB."),
+                                        QStringLiteral("MiB"), QStringLiteral("8"));
+    const QCommandLineOption runsOption(QStringLiteral("runs"), QStringLiteral("Runs of each benchmark."),
+                                        QStringLiteral("N"), QStringLiteral("3"));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+                                          QStringLiteral("Write the JSON report to a file instead of stdout."),
+                                          QStringLiteral("file"));
+    parser.addOption(sizeOption);
+    parser.addOption(runsOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    const qint64 size = std::max(1, parser.value(sizeOption).toInt()) * 1024LL * 1024;
+    const int runs = std::max(1, parser.value(runsOption).toInt());
+    const qint64 editSize = std::max<qint64>(size / 8, 64 * 1024);  // editing is much slower than loading
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        QTextStream(stderr) << "cannot create a temporary directory" << Qt::endl;
+        return 1;
+    }
+
+    Report report;
+
+    // loading and charset detection
+    const QString log = asciiLog(size);
+    const QString yaml = deepYaml(size);
+    const QString shell = shellScript(size);
+    const QString json = minifiedJson(size);
+    const QList<QPair<QString, QByteArray>> files = {
+        {QStringLiteral("ascii_log"), log.toUtf8()},
+        {QStringLiteral("utf8_cjk"), cjkText(size).toUtf8()},
+        {QStringLiteral("utf16"), utf16Bytes(log.left(size / 2))},
+        {QStringLiteral("minified_json"), json.toUtf8()},
+        {QStringLiteral("deep_yaml"), yaml.toUtf8()},
+        {QStringLiteral("shell"), shell.toUtf8()},
+    };
+    for (const auto& [corpus, data] : files) {
+        const QString path = dir.filePath(corpus);
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+            QTextStream(stderr) << "cannot write " << path << Qt::endl;
+            return 1;
+        }
+        file.close();
+        benchLoading(report, runs, corpus, path, data.size());
+        benchCharset(report, runs, corpus, data);
+    }
+
+    // highlighting per language
+    const QList<QPair<QString, QString>> languages = {
+        {QStringLiteral("log"), log.left(editSize)},
+        {QStringLiteral("json"), json.left(editSize)},
+        {QStringLiteral("yaml"), yaml.left(editSize)},
+        {QStringLiteral("sh"), shell.left(editSize)},
+        {QStringLiteral("cpp"), cppSource(editSize)},
+        {QStringLiteral("python"), pythonSource(editSize)},
+        {QStringLiteral("java"), javaSource(editSize)},
+        {QStringLiteral("markdown"), markdownText(editSize)},
+        {QStringLiteral("html"), htmlText(editSize)},
+    };
+    for (const auto& [lang, text] : languages)
+        benchHighlighting(report, runs, lang, text);
+    benchPropagation(report, runs, QStringLiteral("cpp"), cppSource(editSize));
+    benchWorker(report, runs, QStringLiteral("cpp"), cppSource(editSize));
+
+    // searching and editing
+    TextEdit textEdit;
+    textEdit.resize(1200, 900);
+    textEdit.show();
+
+    const QString editLog = log.left(editSize);
+    textEdit.setPlainText(editLog);
+    benchFinding(report, runs, QStringLiteral("ascii_log"), textEdit, QStringLiteral("error"),
+                 QTextDocument::FindFlags(), false);
+    benchFinding(report, runs, QStringLiteral("ascii_log"), textEdit, QStringLiteral("status=40\\d"),
+                 QTextDocument::FindCaseSensitively, true);
+    benchReplaceAll(report, runs, QStringLiteral("ascii_log"), textEdit, editLog, QStringLiteral("GET"),
+                    QStringLiteral("POST"), false);
+    benchReplaceAll(report, runs, QStringLiteral("ascii_log"), textEdit, editLog,
+                    QStringLiteral("took=(\\d+)ms"), QStringLiteral("took=\\1 ms"), true);
+    benchSortLines(report, runs, QStringLiteral("ascii_log"), textEdit, editLog);
+
+    // layout of the visible document
+    benchLayout(report, runs, QStringLiteral("ascii_log"), textEdit, editLog);
+    benchLayout(report, runs, QStringLiteral("minified_json"), textEdit, asLoaded(json.left(editSize)));
+    benchLayout(report, runs, QStringLiteral("utf8_cjk"), textEdit, cjkText(editSize));
+
+    QJsonObject root;
+    root.insert(QStringLiteral("qt"), QString::fromLatin1(qVersion()));
+    root.insert(QStringLiteral("scan_kernel"), QString::fromLatin1(scanKernelName()));
+    root.insert(QStringLiteral("corpus_bytes"), size);
+    root.insert(QStringLiteral("runs"), runs);
+    root.insert(QStringLiteral("results"), report.results());
+    const QByteArray output = QJsonDocument(root).toJson();
+
+    if (parser.isSet(outputOption)) {
+        QFile out(parser.value(outputOption));
+        if (!out.open(QIODevice::WriteOnly) || out.write(output) != output.size()) {
+            QTextStream(stderr) << "cannot write " << out.fileName() << Qt::endl;
+            return 1;
+        }
+    }
+    else {
+        QFile out;
+        if (!out.open(stdout, QIODevice::WriteOnly))
+            return 1;
+        out.write(output);
+    }
+    return 0;
+}
@@ -88,6 +88,7 @@ Config::Config()
       curRecentFilesNumber_(10),
       autoSaveInterval_(1),
       textTabSize_(4),
+      loaderThreads_(0),
       winSize_(QSize(700, 500)),
       startSize_(QSize(700, 500)),
       winPos_(QPoint(0, 0)),
@@ -216,6 +217,7 @@ void Config::readConfig() {
     pastePaths_ = readBool(settings, "pastePaths", false);
 
     maxSHSize_ = readClampedInt(settings, "maxSHSize", 2, 1, 10);
+    loaderThreads_ = readClampedInt(settings, "loaderThreads", 0, 0, kLoaderThreadsMax);
 
     // keep light backgrounds light enough and dark backgrounds dark enough
     lightBgColorValue_ = readClampedInt(settings, "lightBgColorValue", 255, 230, 255);
@@ -407,6 +409,7 @@ void Config::writeConfig() {
     settings.setValue("selectionHighlighting", selectionHighlighting_);
     settings.setValue("pastePaths", pastePaths_);
     settings.setValue("maxSHSize", maxSHSize_);
+    settings.setValue("loaderThreads", loaderThreads_);
     settings.setValue("lightBgColorValue", lightBgColorValue_);
     settings.setValue("dateFormat", dateFormat_);
     settings.setValue("darkBgColorValue", darkBgColorValue_);
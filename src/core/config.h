@@ -43,6 +43,7 @@ class Config {
     static constexpr int kRecentFilesMax = 50;
     static constexpr int kMaxTabPos = 3;  // 0..3 where 0 = default platform
     static constexpr int kMinTabPos = 0;
+    static constexpr int kLoaderThreadsMax = 16;
 
     Config();
     ~Config();
@@ -180,6 +181,10 @@ class Config {
     [[nodiscard]] int getMaxSHSize() const noexcept { return maxSHSize_; }
     void setMaxSHSize(int max) noexcept { maxSHSize_ = max; }
 
+    // 0 means automatic (based on the number of CPU cores)
+    [[nodiscard]] int getLoaderThreads() const noexcept { return loaderThreads_; }
+    void setLoaderThreads(int threads) noexcept { loaderThreads_ = std::clamp(threads, 0, kLoaderThreadsMax); }
+
     [[nodiscard]] bool getSkipNonText() const noexcept { return skipNonText_; }
     void setSkipNonText(bool skip) noexcept { skipNonText_ = skip; }
 
@@ -312,7 +317,7 @@ class Config {
         saveUnmodified_, selectionHighlighting_, pastePaths_, closeWithLastTab_, sharedSearchHistory_,
         disableMenubarAccel_, sysIcons_;
     int vLineDistance_, tabPosition_, maxSHSize_, lightBgColorValue_, darkBgColorValue_, recentFilesNumber_,
-        curRecentFilesNumber_, autoSaveInterval_, textTabSize_;
+        curRecentFilesNumber_, autoSaveInterval_, textTabSize_, loaderThreads_;
     QString dateFormat_;
     QSize winSize_, startSize_, prefSize_;
     QPoint winPos_;
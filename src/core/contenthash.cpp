@@ -0,0 +1,157 @@
+// src/core/contenthash.cpp
+/*
+  texxy/contenthash.cpp
+*/
+
+#include "contenthash.h"
+
+#include <QFile>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace Texxy {
+
+namespace {
+
+constexpr quint64 kPrime1 = 11400714785074694791ULL;
+constexpr quint64 kPrime2 = 14029467366897019727ULL;
+constexpr quint64 kPrime3 = 1609587929392839161ULL;
+constexpr quint64 kPrime4 = 9650029242287828579ULL;
+constexpr quint64 kPrime5 = 2870177450012600261ULL;
+
+constexpr qint64 kReadChunk = 1 << 20;
+
+inline quint64 rotl(quint64 x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline quint64 read64(const uchar* p) noexcept {
+    quint64 v;
+    std::memcpy(&v, p, sizeof(v));
+    return qFromLittleEndian(v);
+}
+
+inline quint32 read32(const uchar* p) noexcept {
+    quint32 v;
+    std::memcpy(&v, p, sizeof(v));
+    return qFromLittleEndian(v);
+}
+
+inline quint64 round(quint64 acc, quint64 input) noexcept {
+    acc += input * kPrime2;
+    return rotl(acc, 31) * kPrime1;
+}
+
+inline quint64 mergeRound(quint64 acc, quint64 val) noexcept {
+    acc ^= round(0, val);
+    return acc * kPrime1 + kPrime4;
+}
+
+}  // namespace
+
+ContentHash::ContentHash() noexcept : acc_{kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1}, buffered_(0), total_(0) {}
+
+void ContentHash::add(const uchar* data, qint64 size) noexcept {
+    if (size <= 0)
+        return;
+    total_ += static_cast<quint64>(size);
+
+    if (buffered_ + size < 32) {
+        std::memcpy(buffer_ + buffered_, data, static_cast<size_t>(size));
+        buffered_ += size;
+        return;
+    }
+
+    const uchar* p = data;
+    const uchar* const end = data + size;
+    if (buffered_ > 0) {
+        const qint64 fill = 32 - buffered_;
+        std::memcpy(buffer_ + buffered_, p, static_cast<size_t>(fill));
+        for (int i = 0; i < 4; ++i)
+            acc_[i] = round(acc_[i], read64(buffer_ + 8 * i));
+        p += fill;
+        buffered_ = 0;
+    }
+
+    // the four lanes are independent, which keeps the CPU busy
+    quint64 v1 = acc_[0], v2 = acc_[1], v3 = acc_[2], v4 = acc_[3];
+    while (end - p >= 32) {
+        v1 = round(v1, read64(p));
+        v2 = round(v2, read64(p + 8));
+        v3 = round(v3, read64(p + 16));
+        v4 = round(v4, read64(p + 24));
+        p += 32;
+    }
+    acc_[0] = v1;
+    acc_[1] = v2;
+    acc_[2] = v3;
+    acc_[3] = v4;
+
+    if (p < end) {
+        buffered_ = end - p;
+        std::memcpy(buffer_, p, static_cast<size_t>(buffered_));
+    }
+}
+
+quint64 ContentHash::result() const noexcept {
+    quint64 h;
+    if (total_ >= 32) {
+        h = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + rotl(acc_[3], 18);
+        for (int i = 0; i < 4; ++i)
+            h = mergeRound(h, acc_[i]);
+    }
+    else {
+        h = acc_[2] + kPrime5;  // the seed
+    }
+    h += total_;
+
+    const uchar* p = buffer_;
+    const uchar* const end = buffer_ + buffered_;
+    while (end - p >= 8) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * kPrime1 + kPrime4;
+        p += 8;
+    }
+    if (end - p >= 4) {
+        h ^= static_cast<quint64>(read32(p)) * kPrime1;
+        h = rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= static_cast<quint64>(*p) * kPrime5;
+        h = rotl(h, 11) * kPrime1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+quint64 ContentHash::of(const uchar* begin, const uchar* end) noexcept {
+    ContentHash hash;
+    hash.add(begin, end - begin);
+    return hash.result();
+}
+
+bool ContentHash::ofFile(const QString& fname, quint64& hash) {
+    QFile file(fname);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+    // read rather than mapped: a file that is truncated meanwhile only ends the reading
+    ContentHash h;
+    QByteArray chunk(static_cast<qsizetype>(kReadChunk), Qt::Uninitialized);
+    qint64 n;
+    while ((n = file.read(chunk.data(), kReadChunk)) > 0)
+        h.add(reinterpret_cast<const uchar*>(chunk.constData()), n);
+    if (n < 0)
+        return false;
+    hash = h.result();
+    return true;
+}
+
+}  // namespace Texxy
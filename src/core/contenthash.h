@@ -0,0 +1,47 @@
+// src/core/contenthash.h
+/*
+  texxy/contenthash.h
+*/
+
+#ifndef CONTENTHASH_H
+#define CONTENTHASH_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include "textscan.h"
+
+namespace Texxy {
+
+/* A fast, non-cryptographic fingerprint of file contents (XXH64), for knowing
+   whether a file that was touched has really changed. The bytes may be given
+   in parts of any size; the result is the same as for the whole. */
+class ContentHash {
+   public:
+    ContentHash() noexcept;
+
+    void add(const uchar* data, qint64 size) noexcept;
+    quint64 result() const noexcept;
+
+    /* Adds the bytes that a line scan passes (see scanLines()). */
+    ScanSink sink() noexcept {
+        return ScanSink{[](void* context, const unsigned char* begin, const unsigned char* end) {
+                            static_cast<ContentHash*>(context)->add(begin, end - begin);
+                        },
+                        this};
+    }
+
+    static quint64 of(const uchar* begin, const uchar* end) noexcept;
+    /* Reads the file; returns false if it cannot be read. */
+    static bool ofFile(const QString& fname, quint64& hash);
+
+   private:
+    quint64 acc_[4];
+    uchar buffer_[32];  // the bytes of an incomplete stripe
+    qint64 buffered_;
+    quint64 total_;
+};
+
+}  // namespace Texxy
+
+#endif  // CONTENTHASH_H
@@ -0,0 +1,255 @@
+// src/core/decompressor.cpp
+/*
+  texxy/decompressor.cpp
+*/
+
+#include "decompressor.h"
+
+#include <cstring>
+
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAS_LZMA
+#include <lzma.h>
+#endif
+#ifdef HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace Texxy {
+
+namespace {
+
+constexpr uchar kGzipMagic[] = {0x1F, 0x8B};
+constexpr uchar kXzMagic[] = {0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00};
+constexpr uchar kZstdMagic[] = {0x28, 0xB5, 0x2F, 0xFD};
+
+// the libraries count input bytes with 32-bit integers
+constexpr qint64 kMaxInput = 1LL << 30;
+
+template <std::size_t N>
+bool startsWith(const uchar* data, qint64 size, const uchar (&magic)[N]) {
+    return size >= static_cast<qint64>(N) && std::memcmp(data, magic, N) == 0;
+}
+
+}  // namespace
+
+struct Decompressor::State {
+    Format format = Format::None;
+    const uchar* next = nullptr;  // the first byte not yet given to the library
+    const uchar* end = nullptr;
+    bool ended = false;
+    bool error = false;
+#ifdef HAS_ZLIB
+    z_stream zs{};
+#endif
+#ifdef HAS_LZMA
+    lzma_stream xz = LZMA_STREAM_INIT;
+#endif
+#ifdef HAS_ZSTD
+    ZSTD_DStream* zd = nullptr;
+    ZSTD_inBuffer zin{nullptr, 0, 0};
+    size_t frameLeft = 0;  // nonzero inside an unfinished frame
+#endif
+
+    qint64 takeInput() {
+        const qint64 n = qMin(kMaxInput, static_cast<qint64>(end - next));
+        next += n;
+        return n;
+    }
+};
+
+Decompressor::Format Decompressor::detect(const uchar* data, qint64 size) noexcept {
+    if (!data)
+        return Format::None;
+    if (startsWith(data, size, kGzipMagic))
+        return Format::Gzip;
+    if (startsWith(data, size, kXzMagic))
+        return Format::Xz;
+    if (startsWith(data, size, kZstdMagic))
+        return Format::Zstd;
+    return Format::None;
+}
+
+bool Decompressor::isAvailable(Format format) noexcept {
+    switch (format) {
+#ifdef HAS_ZLIB
+        case Format::Gzip:
+            return true;
+#endif
+#ifdef HAS_LZMA
+        case Format::Xz:
+            return true;
+#endif
+#ifdef HAS_ZSTD
+        case Format::Zstd:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+Decompressor::Decompressor(Format format, const uchar* begin, const uchar* end) : d_(new State) {
+    d_->format = isAvailable(format) ? format : Format::None;
+    d_->next = begin;
+    d_->end = end;
+    switch (d_->format) {
+#ifdef HAS_ZLIB
+        case Format::Gzip:
+            // 15 + 16: a gzip wrapper with the largest window
+            d_->error = inflateInit2(&d_->zs, 15 + 16) != Z_OK;
+            break;
+#endif
+#ifdef HAS_LZMA
+        case Format::Xz:
+            d_->error = lzma_stream_decoder(&d_->xz, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK;
+            break;
+#endif
+#ifdef HAS_ZSTD
+        case Format::Zstd:
+            d_->zd = ZSTD_createDStream();
+            d_->error = !d_->zd || ZSTD_isError(ZSTD_initDStream(d_->zd));
+            break;
+#endif
+        default:
+            d_->error = true;
+            break;
+    }
+}
+
+Decompressor::~Decompressor() {
+    switch (d_->format) {
+#ifdef HAS_ZLIB
+        case Format::Gzip:
+            inflateEnd(&d_->zs);
+            break;
+#endif
+#ifdef HAS_LZMA
+        case Format::Xz:
+            lzma_end(&d_->xz);
+            break;
+#endif
+#ifdef HAS_ZSTD
+        case Format::Zstd:
+            ZSTD_freeDStream(d_->zd);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+bool Decompressor::atEnd() const noexcept {
+    return d_->ended || d_->error;
+}
+
+bool Decompressor::hasError() const noexcept {
+    return d_->error;
+}
+
+qint64 Decompressor::read(char* out, qint64 maxSize) {
+    if (d_->ended || maxSize <= 0)
+        return 0;
+    if (d_->error)
+        return -1;
+    maxSize = qMin(maxSize, kMaxInput);
+    qint64 produced = 0;
+
+    switch (d_->format) {
+#ifdef HAS_ZLIB
+        case Format::Gzip: {
+            z_stream& zs = d_->zs;
+            zs.next_out = reinterpret_cast<Bytef*>(out);
+            zs.avail_out = static_cast<uInt>(maxSize);
+            while (zs.avail_out > 0) {
+                if (zs.avail_in == 0 && d_->next < d_->end) {
+                    zs.next_in = const_cast<Bytef*>(d_->next);
+                    zs.avail_in = static_cast<uInt>(d_->takeInput());
+                }
+                const int ret = inflate(&zs, Z_NO_FLUSH);
+                if (ret == Z_STREAM_END) {
+                    // rotated logs may have several members; anything else after one is ignored
+                    const bool anotherMember = zs.avail_in > 0
+                                                   ? startsWith(zs.next_in, zs.avail_in, kGzipMagic)
+                                                   : startsWith(d_->next, d_->end - d_->next, kGzipMagic);
+                    if (!anotherMember || inflateReset(&zs) != Z_OK) {
+                        d_->ended = true;
+                        break;
+                    }
+                }
+                else if (ret != Z_OK) {
+                    d_->error = true;  // Z_BUF_ERROR here means that the input was truncated
+                    break;
+                }
+            }
+            produced = maxSize - zs.avail_out;
+            break;
+        }
+#endif
+#ifdef HAS_LZMA
+        case Format::Xz: {
+            lzma_stream& xz = d_->xz;
+            xz.next_out = reinterpret_cast<uint8_t*>(out);
+            xz.avail_out = static_cast<size_t>(maxSize);
+            while (xz.avail_out > 0) {
+                if (xz.avail_in == 0 && d_->next < d_->end) {
+                    xz.next_in = d_->next;
+                    xz.avail_in = static_cast<size_t>(d_->takeInput());
+                }
+                const lzma_action action = xz.avail_in == 0 ? LZMA_FINISH : LZMA_RUN;
+                const lzma_ret ret = lzma_code(&xz, action);
+                if (ret == LZMA_STREAM_END) {
+                    d_->ended = true;
+                    break;
+                }
+                if (ret != LZMA_OK) {
+                    d_->error = true;
+                    break;
+                }
+            }
+            produced = maxSize - static_cast<qint64>(xz.avail_out);
+            break;
+        }
+#endif
+#ifdef HAS_ZSTD
+        case Format::Zstd: {
+            ZSTD_outBuffer zout{out, static_cast<size_t>(maxSize), 0};
+            ZSTD_inBuffer& zin = d_->zin;
+            while (zout.pos < zout.size) {
+                if (zin.pos == zin.size) {
+                    if (d_->next >= d_->end) {
+                        // the output is flushed; an unfinished frame means truncated input
+                        if (d_->frameLeft != 0)
+                            d_->error = true;
+                        else
+                            d_->ended = true;
+                        break;
+                    }
+                    zin.src = d_->next;
+                    zin.size = static_cast<size_t>(d_->takeInput());
+                    zin.pos = 0;
+                }
+                const size_t ret = ZSTD_decompressStream(d_->zd, &zout, &zin);
+                if (ZSTD_isError(ret)) {
+                    d_->error = true;
+                    break;
+                }
+                d_->frameLeft = ret;
+            }
+            produced = static_cast<qint64>(zout.pos);
+            break;
+        }
+#endif
+        default:
+            d_->error = true;
+            break;
+    }
+
+    if (produced == 0 && d_->error)
+        return -1;
+    return produced;
+}
+
+}  // namespace Texxy
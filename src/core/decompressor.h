@@ -0,0 +1,48 @@
+// src/core/decompressor.h
+/*
+  texxy/decompressor.h
+*/
+
+#ifndef DECOMPRESSOR_H
+#define DECOMPRESSOR_H
+
+#include <QtGlobal>
+
+#include <memory>
+
+namespace Texxy {
+
+/* Streaming decompression of gzip, xz and zstd data, which is recognized by
+   its magic bytes. The compressed data is read in place (e.g., from a mapped
+   file) and only as much of it is decompressed as is asked for, so that neither
+   the whole input nor the whole output has to be held in a buffer. A format is
+   available only if Texxy was built with its library (zlib, liblzma, libzstd). */
+class Decompressor {
+    Q_DISABLE_COPY_MOVE(Decompressor)
+
+   public:
+    enum class Format { None, Gzip, Xz, Zstd };
+
+    /* The compression format of data starting at "data", by its magic bytes. */
+    static Format detect(const uchar* data, qint64 size) noexcept;
+    static bool isAvailable(Format format) noexcept;
+
+    Decompressor(Format format, const uchar* begin, const uchar* end);
+    ~Decompressor();
+
+    /* Decompresses up to "maxSize" bytes into "out" and returns their number,
+       which is 0 at the end of the stream and -1 if the data is invalid or
+       truncated (the bytes before a problem are returned first). */
+    qint64 read(char* out, qint64 maxSize);
+
+    bool atEnd() const noexcept;
+    bool hasError() const noexcept;
+
+   private:
+    struct State;
+    std::unique_ptr<State> d_;
+};
+
+}  // namespace Texxy
+
+#endif  // DECOMPRESSOR_H
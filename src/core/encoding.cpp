@@ -5,135 +5,20 @@
 */
 
 #include "encoding.h"
+#include "textscan.h"
 
+#include <algorithm>
 #include <cstddef>
-#include <cstdint>
-#include <cstring>
 #include <string_view>
 
-#if defined(__has_cpp_attribute)
-#if __has_cpp_attribute(likely) && __cplusplus >= 202002L
-#define TXY_LIKELY [[likely]]
-#define TXY_UNLIKELY [[unlikely]]
-#else
-#define TXY_LIKELY
-#define TXY_UNLIKELY
-#endif
-#else
-#define TXY_LIKELY
-#define TXY_UNLIKELY
-#endif
-
 // keep heavy logic out of Qt namespace pollution
 namespace {
 
-// returns pointer advanced past consecutive ASCII bytes using wide chunks
-// uses memcpy to avoid UB on unaligned loads
-static inline const unsigned char* skip_ascii(const unsigned char* p, const unsigned char* end) noexcept {
-    // process 8 bytes at a time while possible
-    while (static_cast<size_t>(end - p) >= sizeof(uint64_t)) {
-        uint64_t chunk;
-        std::memcpy(&chunk, p, sizeof(chunk));
-        if (chunk & 0x8080808080808080ULL)
-            break;  // some byte has high bit set
-        p += sizeof(uint64_t);
-    }
-    // process 4 bytes
-    if (static_cast<size_t>(end - p) >= sizeof(uint32_t)) {
-        uint32_t chunk32;
-        std::memcpy(&chunk32, p, sizeof(chunk32));
-        if ((chunk32 & 0x80808080U) == 0)
-            p += sizeof(uint32_t);
-    }
-    // process residual bytes
-    while (p < end && (*p < 0x80))
-        ++p;
-    return p;
-}
-
 // strict UTF-8 validator rejecting overlongs and surrogates
+// the vectorized kernel is chosen at runtime
 static inline bool validate_utf8(std::string_view bytes) noexcept {
     const unsigned char* p = reinterpret_cast<const unsigned char*>(bytes.data());
-    const unsigned char* const end = p + bytes.size();
-
-    while (p < end) {
-        p = skip_ascii(p, end);
-        if (p >= end)
-            break;
-
-        const unsigned char c = *p++;
-
-        // two-byte form: [C2..DF] [80..BF]
-        if (c >= 0xC2 && c <= 0xDF)
-            TXY_LIKELY {
-                if (p == end)
-                    TXY_UNLIKELY
-                return false;  // need 1 more byte
-                if ((p[0] & 0xC0) != 0x80)
-                    TXY_UNLIKELY
-                return false;  // invalid continuation
-                ++p;
-                continue;
-            }
-
-        // three-byte form: [E0..EF] [80..BF] [80..BF]
-        if (c >= 0xE0 && c <= 0xEF) {
-            if (end - p < 2)
-                TXY_UNLIKELY
-            return false;  // need 2 more bytes
-            const unsigned char c1 = p[0], c2 = p[1];
-            if ((c1 & 0xC0) != 0x80 || (c2 & 0xC0) != 0x80)
-                TXY_UNLIKELY
-            return false;  // invalid continuation
-
-            // minimal checks
-            if (c == 0xE0 && c1 < 0xA0)
-                TXY_UNLIKELY
-            return false;  // overlong
-            if (c == 0xED && c1 >= 0xA0)
-                TXY_UNLIKELY
-            return false;  // surrogate half
-
-            // extra surrogate guard
-            const unsigned int code = ((c & 0x0F) << 12) | ((c1 & 0x3F) << 6) | (c2 & 0x3F);
-            if (code >= 0xD800 && code <= 0xDFFF)
-                TXY_UNLIKELY
-            return false;  // surrogates invalid
-            p += 2;
-            continue;
-        }
-
-        // four-byte form: [F0..F4] [80..BF] [80..BF] [80..BF]
-        if (c >= 0xF0 && c <= 0xF4) {
-            if (end - p < 3)
-                TXY_UNLIKELY
-            return false;  // need 3 more bytes
-            const unsigned char c1 = p[0], c2 = p[1], c3 = p[2];
-            if ((c1 & 0xC0) != 0x80 || (c2 & 0xC0) != 0x80 || (c3 & 0xC0) != 0x80)
-                TXY_UNLIKELY
-            return false;  // invalid continuation
-
-            // minimal and upper bound checks
-            if (c == 0xF0 && c1 < 0x90)
-                TXY_UNLIKELY
-            return false;  // overlong
-            if (c == 0xF4 && c1 > 0x8F)
-                TXY_UNLIKELY
-            return false;  // beyond U+10FFFF
-
-            const unsigned int code = ((c & 0x07) << 18) | ((c1 & 0x3F) << 12) | ((c2 & 0x3F) << 6) | (c3 & 0x3F);
-            if (code > 0x10FFFF)
-                TXY_UNLIKELY
-            return false;  // outside Unicode range
-            p += 3;
-            continue;
-        }
-
-        // anything in [80..C1] or [F5..FF] is invalid
-        return false;
-    }
-
-    return true;
+    return Texxy::isValidUtf8(p, p + bytes.size());
 }
 
 // minimal BOM probe to prefer explicit encodings when possible
@@ -168,36 +53,17 @@ static inline Guess guess_wide_enc(std::string_view bytes) noexcept {
 
     const unsigned char* d = reinterpret_cast<const unsigned char*>(bytes.data());
 
-    // count zeros at positions modulo 2 and 4
-    size_t zero_even = 0, zero_odd = 0, zero_mod4_0 = 0, zero_mod4_1_2_3[3] = {0, 0, 0};
-    for (size_t i = 0; i < n; ++i) {
-        if (d[i] == 0) {
-            if ((i & 1) == 0)
-                ++zero_even;
-            else
-                ++zero_odd;
-            switch (i & 3) {
-                case 0:
-                    ++zero_mod4_0;
-                    break;
-                case 1:
-                    ++zero_odd;
-                    break;
-                case 2:
-                    ++zero_mod4_1_2_3[1];
-                    break;
-                case 3:
-                    ++zero_mod4_1_2_3[2];
-                    break;
-            }
-        }
-    }
+    // count zeros at positions modulo 4 (and so modulo 2)
+    size_t zeros[4] = {0, 0, 0, 0};
+    Texxy::countZerosMod4(d, d + n, zeros);
+    const size_t zero_even = zeros[0] + zeros[2];
+    const size_t zero_odd = zeros[1] + zeros[3];
 
     const double total = static_cast<double>(n);
     const double even_ratio = zero_even / total;
     const double odd_ratio = zero_odd / total;
-    const double m4_0_ratio = zero_mod4_0 / total;
-    const double m4_2_ratio = zero_mod4_1_2_3[1] / total;
+    const double m4_0_ratio = zeros[0] / total;
+    const double m4_2_ratio = zeros[2] / total;
 
     // thresholds are conservative to avoid false positives on binary data
     // prefer UTF-32 if every 2nd or 4th byte is frequently zero
@@ -211,6 +77,27 @@ static inline Guess guess_wide_enc(std::string_view bytes) noexcept {
     return {nullptr, 0.0};
 }
 
+// a window of UTF-8 text that neither starts nor ends inside a multibyte sequence
+static inline std::string_view utf8_window(std::string_view bytes, size_t from, size_t len) noexcept {
+    const size_t n = bytes.size();
+    const unsigned char* d = reinterpret_cast<const unsigned char*>(bytes.data());
+    size_t to = from + len < n ? from + len : n;
+
+    // skip continuation bytes at the start
+    for (int i = 0; i < 3 && from < to && (d[from] & 0xC0) == 0x80; ++i)
+        ++from;
+
+    if (to < n) {
+        // drop a sequence that would continue after the window
+        size_t lead = to;
+        for (int i = 0; i < 3 && lead > from && (d[lead - 1] & 0xC0) == 0x80; ++i)
+            --lead;
+        if (lead > from && d[lead - 1] >= 0xC0)
+            to = lead - 1;
+    }
+    return bytes.substr(from, to > from ? to - from : 0);
+}
+
 }  // anonymous namespace
 
 namespace Texxy {
@@ -238,4 +125,45 @@ QString detectCharset(const QByteArray& byteArray) {
     return QStringLiteral("ISO-8859-1");
 }
 
+QString detectCharsetFromSamples(const QByteArray& byteArray) {
+    const char* data = byteArray.constData();
+    const qint64 size = byteArray.size();
+    return detectCharsetFromSamples(size, [data, size](qint64 from, qint64 length) {
+        return QByteArray::fromRawData(data + from, static_cast<qsizetype>(std::min(length, size - from)));
+    });
+}
+
+QString detectCharsetFromSamples(qint64 size, const std::function<QByteArray(qint64 from, qint64 length)>& read) {
+    constexpr size_t kPrefix = 64 * 1024;
+    constexpr size_t kWindow = 8 * 1024;
+    constexpr size_t kWindows = 7;
+    constexpr size_t kTail = 3;  // read after a window, to know whether it ends inside a sequence
+
+    const size_t n = static_cast<size_t>(size);
+    if (n <= kPrefix + kWindows * kWindow)
+        return detectCharset(read(0, size));  // sampling would read about as much
+
+    const QByteArray head = read(0, kPrefix + kTail);
+    const std::string_view sv{head.constData(), static_cast<size_t>(head.size())};
+    if (const char* bom = probe_bom(sv))
+        return QString::fromLatin1(bom);
+
+    const std::string_view prefix = utf8_window(sv, 0, kPrefix);
+    bool utf8 = validate_utf8(prefix);
+    // windows spread over the rest of the data, the last one at its end
+    for (size_t i = 1; utf8 && i <= kWindows; ++i) {
+        const size_t from = i == kWindows ? n - kWindow : (n / kWindows) * i;
+        const QByteArray window = read(static_cast<qint64>(from), kWindow + kTail);
+        utf8 = validate_utf8(utf8_window({window.constData(), static_cast<size_t>(window.size())}, 0, kWindow));
+    }
+    if (utf8)
+        return QStringLiteral("UTF-8");
+
+    const Guess g = guess_wide_enc(prefix);
+    if (g.name && g.score > 0.45)
+        return QString::fromLatin1(g.name);
+
+    return QStringLiteral("ISO-8859-1");
+}
+
 }  // namespace Texxy
@@ -9,10 +9,21 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QString>
 
+#include <functional>
+
 namespace Texxy {
 
 QString detectCharset(const QByteArray& byteArray);
 
+/* Like detectCharset() but decides from a prefix and a few windows spread over
+   the data. A "UTF-8" result is a guess for the parts that were not sampled, so
+   the decoder should report errors (QStringDecoder::hasError()). */
+QString detectCharsetFromSamples(const QByteArray& byteArray);
+
+/* The same for "size" bytes that are only read as far as they are sampled:
+   "read" gives at most "length" bytes from "from" (fewer if the data is shorter). */
+QString detectCharsetFromSamples(qint64 size, const std::function<QByteArray(qint64 from, qint64 length)>& read);
+
 }  // namespace Texxy
 
 #endif  // ENCODING_H
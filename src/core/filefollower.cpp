@@ -0,0 +1,133 @@
+// src/core/filefollower.cpp
+/*
+  texxy/filefollower.cpp
+*/
+
+#include "filefollower.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSysInfo>
+
+#include "loading.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace Texxy {
+
+// a rotated log has the same name but another inode
+static quint64 fileId(const QString& fname) {
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(fname).constData(), &st) == 0)
+        return static_cast<quint64>(st.st_ino);
+#else
+    Q_UNUSED(fname);
+#endif
+    return 0;
+}
+
+FileFollower::FileFollower(const QString& fname, const QString& charset, qint64 offset, QObject* parent)
+    : QObject(parent), fname_(fname), offset_(offset), replacesLast_(false), fileId_(fileId(fname)), replaced_(false) {
+    alignOffset(charset);
+    timer_.setSingleShot(true);
+    connect(&timer_, &QTimer::timeout, this, &FileFollower::readNew);
+    connect(&watcher_, &QFileSystemWatcher::fileChanged, this, &FileFollower::onFileChanged);
+    watcher_.addPath(fname_);
+    // what was written since the file was loaded
+    timer_.start(0);
+}
+
+/* The text may have been loaded while a character was being written; then its
+   bytes are read again. UTF-16/32 without a BOM is taken to be in the byte order
+   of the host, as by the decoder of Loading. */
+void FileFollower::alignOffset(const QString& charset) {
+    QStringConverter::Encoding encoding = Loading::converterFor(charset);
+    QFile file(fname_);
+    if (offset_ > 0 && encoding != QStringConverter::Latin1 && file.open(QIODevice::ReadOnly)) {
+        qint64 start = offset_;
+        if (encoding == QStringConverter::Utf8) {
+            // the lead byte of the last sequence may be up to 3 bytes back
+            const qint64 from = qMax<qint64>(0, offset_ - 3);
+            const QByteArray tail = file.seek(from) ? file.read(offset_ - from) : QByteArray();
+            for (qsizetype i = tail.size() - 1; i >= 0; --i) {
+                const auto c = static_cast<uchar>(tail.at(i));
+                if ((c & 0xC0) == 0x80)
+                    continue;
+                const qsizetype length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+                if (length > tail.size() - i)
+                    start = from + i;
+                break;
+            }
+        }
+        else {
+            const bool utf16 = encoding == QStringConverter::Utf16;
+            const QByteArray bom = file.read(4);
+            bool bigEndian = QSysInfo::ByteOrder == QSysInfo::BigEndian;
+            if (utf16 ? bom.startsWith("\xFE\xFF") : bom == QByteArray("\0\0\xFE\xFF", 4))
+                bigEndian = true;
+            else if (utf16 ? bom.startsWith("\xFF\xFE") : bom == QByteArray("\xFF\xFE\0\0", 4))
+                bigEndian = false;
+            encoding = utf16 ? (bigEndian ? QStringConverter::Utf16BE : QStringConverter::Utf16LE)
+                             : (bigEndian ? QStringConverter::Utf32BE : QStringConverter::Utf32LE);
+            start -= offset_ % (utf16 ? 2 : 4);
+        }
+        replacesLast_ = start < offset_;
+        offset_ = start;
+    }
+    // a BOM that isn't at the start of the file is a character
+    decoder_ = QStringDecoder(encoding, offset_ > 0 ? QStringConverter::Flag::ConvertInitialBom
+                                                    : QStringConverter::Flag::Default);
+}
+
+void FileFollower::onFileChanged() {
+    // a steady stream of writes shouldn't postpone reading forever
+    if (!replaced_ && (!timer_.isActive() || timer_.remainingTime() > kDelay))
+        timer_.start(kDelay);
+}
+
+void FileFollower::readNew() {
+    if (replaced_)
+        return;
+
+    const QFileInfo info(fname_);  // stats the file once
+    if (!info.exists()) {
+        // between the rename and the creation of a rotated log
+        timer_.start(kPollInterval);
+        return;
+    }
+    // a removed or renamed file isn't watched anymore
+    if (!watcher_.files().contains(fname_))
+        watcher_.addPath(fname_);
+
+    QFile file(fname_);
+    const qint64 size = info.size();
+    const quint64 id = fileId(fname_);
+    if (size < offset_ || (fileId_ != 0 && id != 0 && id != fileId_) || !file.open(QIODevice::ReadOnly)) {
+        replaced_ = true;
+        watcher_.removePath(fname_);
+        emit replaced();
+        return;
+    }
+
+    if (size > offset_ && file.seek(offset_)) {
+        const QByteArray bytes = file.read(qMin(size - offset_, kMaxRead));
+        offset_ += bytes.size();
+        QString text = carry_ + decoder_.decode(bytes);
+        carry_.clear();
+        if (text.endsWith(QLatin1Char('\r'))) {
+            text.chop(1);
+            carry_ = QStringLiteral("\r");
+        }
+        if (!text.isEmpty()) {
+            emit appended(text, replacesLast_, info.lastModified());
+            replacesLast_ = false;
+        }
+    }
+
+    timer_.start(offset_ < size ? 0 : kPollInterval);
+}
+
+}  // namespace Texxy
@@ -0,0 +1,62 @@
+// src/core/filefollower.h
+/*
+  texxy/filefollower.h
+*/
+
+#ifndef FILEFOLLOWER_H
+#define FILEFOLLOWER_H
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QStringDecoder>
+#include <QTimer>
+
+namespace Texxy {
+
+/* Follows a growing file, like "tail -f". The bytes written after "offset" are
+   decoded and reported by appended(); the decoder state is kept between reads,
+   so that a sequence split by a write is decoded whole. For the same reason,
+   reading starts at the character that contains "offset". Changes come from a file
+   system watcher, with a slow poll for file systems that don't report them. If
+   the file is truncated or replaced (e.g., by log rotation), replaced() is emitted
+   once it exists again, and nothing more is read. */
+class FileFollower : public QObject {
+    Q_OBJECT
+
+   public:
+    FileFollower(const QString& fname, const QString& charset, qint64 offset, QObject* parent = nullptr);
+
+    qint64 offset() const noexcept { return offset_; }  // the bytes that are read
+    bool isReplaced() const noexcept { return replaced_; }
+
+   signals:
+    /* "replacesLast" means that the last character of the loaded text was the
+       incomplete start of the first one of "text". */
+    void appended(const QString& text, bool replacesLast, const QDateTime& lastModified);
+    void replaced();
+
+   private:
+    void onFileChanged();
+    void readNew();
+    void alignOffset(const QString& charset);
+
+    static constexpr int kDelay = 100;           // ms to collect the changes of several writes
+    static constexpr int kPollInterval = 2000;   // ms
+    static constexpr qint64 kMaxRead = 1 << 22;  // bytes read at once (the rest is read later)
+
+    QFileSystemWatcher watcher_;
+    QTimer timer_;
+    QString fname_;
+    QStringDecoder decoder_;
+    QString carry_;  // a CR that may be the first half of CRLF
+    qint64 offset_;
+    bool replacesLast_;  // the first read starts before the offset it was given
+    quint64 fileId_;     // inode (0 if unknown)
+    bool replaced_;
+};
+
+}  // namespace Texxy
+
+#endif  // FILEFOLLOWER_H
@@ -0,0 +1,153 @@
+// src/core/filewatcher.cpp
+/*
+  texxy/filewatcher.cpp
+*/
+
+#include "filewatcher.h"
+#include "contenthash.h"
+
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+namespace Texxy {
+
+FileWatcher::FileWatcher(QObject* parent) : QObject(parent), context_(new QObject), fsWatcher_(nullptr) {
+    context_->moveToThread(&thread_);
+    connect(&thread_, &QThread::finished, context_, &QObject::deleteLater);
+    thread_.setObjectName(QStringLiteral("FileWatcher"));
+    thread_.start(QThread::LowPriority);
+
+    QMetaObject::invokeMethod(context_, [this] {
+        fsWatcher_ = new QFileSystemWatcher(context_);
+        connect(fsWatcher_, &QFileSystemWatcher::fileChanged, context_, [this](const QString& path) {
+            // a removed or replaced file isn't watched anymore
+            if (!fsWatcher_->files().contains(path))
+                fsWatched_.remove(path);
+            stat(path);
+        });
+        auto* timer = new QTimer(context_);
+        connect(timer, &QTimer::timeout, context_, [this] {
+            for (const QString& path : std::as_const(paths_))
+                stat(path);
+        });
+        timer->start(kPollInterval);
+    });
+}
+
+FileWatcher::~FileWatcher() {
+    thread_.quit();
+    thread_.wait();
+}
+
+void FileWatcher::watch(const QString& path, QObject* owner) {
+    if (!owner)
+        return;
+    const auto it = owners_.constFind(owner);
+    if (it != owners_.constEnd()) {
+        if (it.value() == path)
+            return;
+        unwatch(owner);
+    }
+    if (path.isEmpty())
+        return;
+
+    owners_.insert(owner, path);
+    connect(owner, &QObject::destroyed, this, &FileWatcher::unwatch, Qt::UniqueConnection);
+    if (ownerCounts_[path]++ > 0)
+        return;
+    QMetaObject::invokeMethod(context_, [this, path] {
+        paths_.insert(path);
+        stat(path);
+    });
+}
+
+void FileWatcher::unwatch(QObject* owner) {
+    const QString path = owners_.take(owner);
+    if (path.isEmpty())
+        return;
+    auto it = ownerCounts_.find(path);
+    if (it == ownerCounts_.end() || --it.value() > 0)
+        return;
+    ownerCounts_.erase(it);
+    states_.remove(path);
+    QMetaObject::invokeMethod(context_, [this, path] {
+        paths_.remove(path);
+        contents_.remove(path);
+        if (fsWatched_.remove(path))
+            fsWatcher_->removePath(path);
+    });
+}
+
+void FileWatcher::refresh(const QString& path) {
+    if (!ownerCounts_.contains(path))
+        return;
+    QMetaObject::invokeMethod(context_, [this, path] {
+        if (paths_.contains(path))
+            stat(path);
+    });
+}
+
+void FileWatcher::noteContent(const QString& path, const QDateTime& lastModified, qint64 size, quint64 hash) {
+    if (!ownerCounts_.contains(path))
+        return;
+    State& state = states_[path];
+    state.known = true;
+    state.exists = true;
+    state.sameContent = true;
+    state.lastModified = lastModified;
+    QMetaObject::invokeMethod(context_, [this, path, lastModified, size, hash] {
+        if (!paths_.contains(path))
+            return;
+        if (hash != 0)
+            contents_.insert(path, Content{size, hash, lastModified, true});
+        else
+            contents_.remove(path);
+        stat(path);  // for the permissions and a new inode
+    });
+}
+
+void FileWatcher::stat(const QString& path) {
+    const QFileInfo info(path);
+    const bool exists = info.exists();
+    const bool executable = exists && info.isExecutable();
+    const QDateTime lastModified = exists ? info.lastModified() : QDateTime();
+    bool sameContent = false;
+    auto it = contents_.find(path);
+    if (exists && it != contents_.end() && info.size() == it->size) {
+        if (it->checked != lastModified) {  // touched; only the bytes can tell
+            quint64 hash = 0;
+            it->same = ContentHash::ofFile(path, hash) && hash == it->hash;
+            it->checked = lastModified;
+        }
+        sameContent = it->same;
+    }
+    // a file that is replaced or created again has to be watched again
+    if (exists && !fsWatched_.contains(path) && fsWatcher_->addPath(path))
+        fsWatched_.insert(path);
+    QMetaObject::invokeMethod(this, [this, path, exists, executable, sameContent, lastModified] {
+        onStated(path, exists, executable, sameContent, lastModified);
+    });
+}
+
+void FileWatcher::onStated(const QString& path,
+                           bool exists,
+                           bool executable,
+                           bool sameContent,
+                           const QDateTime& lastModified) {
+    if (!ownerCounts_.contains(path))
+        return;  // not watched anymore
+    State& state = states_[path];
+    if (state.known && state.exists == exists && state.executable == executable &&
+        state.sameContent == sameContent && state.lastModified == lastModified) {
+        return;
+    }
+    state.known = true;
+    state.exists = exists;
+    state.executable = executable;
+    state.sameContent = sameContent;
+    state.lastModified = lastModified;
+    emit stateChanged(path);
+}
+
+}  // namespace Texxy
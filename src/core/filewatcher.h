@@ -0,0 +1,88 @@
+// src/core/filewatcher.h
+/*
+  texxy/filewatcher.h
+*/
+
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThread>
+
+class QFileSystemWatcher;
+
+namespace Texxy {
+
+/* An app-wide watcher of the open files. The files are watched and stat'ed in
+   a thread of their own (with a slow poll for file systems without change
+   notifications), and their last known states are cached here, so that the
+   GUI can know about changes made elsewhere without waiting for slow mounts.
+   The public functions are for the GUI thread. */
+class FileWatcher : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(FileWatcher)
+
+   public:
+    struct State {
+        bool known = false;  // the file hasn't been stat'ed yet
+        bool exists = false;
+        bool executable = false;
+        bool sameContent = false;  // the bytes are those noted last, whatever the time
+        QDateTime lastModified;
+    };
+
+    explicit FileWatcher(QObject* parent = nullptr);
+    ~FileWatcher() override;
+
+    /* "owner" (e.g., a text edit) shows the file "path". The file is watched until
+       its last owner is destroyed or shows another file. */
+    void watch(const QString& path, QObject* owner);
+    void unwatch(QObject* owner);
+
+    /* Asks for the state of a watched file to be checked again in the background. */
+    void refresh(const QString& path);
+    /* The file was read or written by Texxy, so its state is known without a check.
+       With a fingerprint (see ContentHash), a later change of the modification time
+       makes the file be hashed in the background, and it counts as modified only if
+       its bytes differ. */
+    void noteContent(const QString& path, const QDateTime& lastModified, qint64 size = -1, quint64 hash = 0);
+
+    /* The last known state of a watched file; this never accesses the file system. */
+    State state(const QString& path) const { return states_.value(path); }
+
+   signals:
+    void stateChanged(const QString& path);
+
+   private:
+    void stat(const QString& path);  // in the watcher's thread
+    void onStated(const QString& path, bool exists, bool executable, bool sameContent, const QDateTime& lastModified);
+
+    static constexpr int kPollInterval = 5000;  // ms
+
+    struct Content {
+        qint64 size = -1;
+        quint64 hash = 0;
+        QDateTime checked;  // the modification time at the last comparison
+        bool same = true;
+    };
+
+    QThread thread_;
+    QObject* context_;  // lives in thread_
+    // used only in thread_
+    QFileSystemWatcher* fsWatcher_;
+    QSet<QString> fsWatched_;  // the files of fsWatcher_, which are stated too often to ask it
+    QSet<QString> paths_;
+    QHash<QString, Content> contents_;
+    // used only in the GUI thread
+    QHash<QObject*, QString> owners_;
+    QHash<QString, int> ownerCounts_;
+    QHash<QString, State> states_;
+};
+
+}  // namespace Texxy
+
+#endif  // FILEWATCHER_H
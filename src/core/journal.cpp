@@ -0,0 +1,318 @@
+// src/core/journal.cpp
+/*
+  texxy/journal.cpp
+*/
+
+#include "journal.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include <algorithm>
+
+namespace Texxy {
+
+namespace {
+
+constexpr quint32 kMagic = 0x54584a31;  // "TXJ1"
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_6_0;
+
+// a journal is a base record (of a file or a snapshot) followed by deltas
+constexpr quint8 kFileBase = 'F';
+constexpr quint8 kSnapshot = 'S';
+constexpr quint8 kDelta = 'D';
+
+QString instanceDir() {
+    const QString root = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    if (root.isEmpty())
+        return QString();
+    return root + QStringLiteral("/journals/") + QString::number(QCoreApplication::applicationPid()) +
+           QLatin1Char('-') + QString::number(QDateTime::currentMSecsSinceEpoch());
+}
+
+QByteArray fileBaseRecord(const QString& fileName, const QString& encoding, quint64 hash, int characterCount) {
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(kStreamVersion);
+    out << kMagic << kFileBase << fileName << encoding << hash << qint32(characterCount);
+    return bytes;
+}
+
+QByteArray snapshotRecord(const QString& fileName, const QString& encoding, const QString& text) {
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(kStreamVersion);
+    out << kMagic << kSnapshot << fileName << encoding << text;
+    return bytes;
+}
+
+QByteArray deltaRecord(int position, int removed, const QString& text) {
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(kStreamVersion);
+    out << kDelta << qint32(position) << qint32(removed) << text;
+    return bytes;
+}
+
+bool readJournal(const QString& path, Journal::Recovery& recovery) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    in.setVersion(kStreamVersion);
+
+    quint32 magic = 0;
+    quint8 type = 0;
+    in >> magic >> type;
+    if (in.status() != QDataStream::Ok || magic != kMagic)
+        return false;
+    if (type == kFileBase) {
+        qint32 characterCount = 0;
+        in >> recovery.fileName >> recovery.encoding >> recovery.contentHash >> characterCount;
+        recovery.fromFile = true;
+        recovery.characterCount = characterCount;
+    }
+    else if (type == kSnapshot) {
+        in >> recovery.fileName >> recovery.encoding >> recovery.snapshot;
+    }
+    else {
+        return false;
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    for (;;) {
+        qint32 position = 0, removed = 0;
+        QString text;
+        in >> type;
+        if (in.status() != QDataStream::Ok || type != kDelta)
+            break;
+        in >> position >> removed >> text;
+        if (in.status() != QDataStream::Ok)
+            break;  // the process ended while writing it
+        recovery.deltas.append({position, removed, text});
+    }
+    return true;
+}
+
+}  // namespace
+
+void Journal::Recovery::replay(QTextDocument* doc) const {
+    QTextCursor cursor(doc);
+    cursor.beginEditBlock();
+    if (!fromFile) {
+        cursor.select(QTextCursor::Document);
+        if (snapshot.isEmpty())
+            cursor.removeSelectedText();
+        else
+            cursor.insertText(snapshot);
+    }
+    for (const Delta& delta : deltas) {
+        // a change may include the last (implicit) block separator
+        const int last = doc->characterCount() - 1;
+        cursor.setPosition(std::min(delta.position, last));
+        cursor.setPosition(std::min(delta.position + delta.removed, last), QTextCursor::KeepAnchor);
+        if (delta.text.isEmpty())
+            cursor.removeSelectedText();
+        else
+            cursor.insertText(delta.text);
+    }
+    cursor.endEditBlock();
+}
+
+Journal::Journal(QObject* parent)
+    : QObject(parent),
+      dir_(instanceDir()),
+      lock_(dir_ + QStringLiteral("/lock")),
+      keepAll_(false),
+      fileCount_(0),
+      context_(new QObject) {
+    if (dir_.isEmpty() || !QDir().mkpath(dir_) || !lock_.tryLock(0))
+        dir_.clear();  // nothing is journaled
+
+    context_->moveToThread(&thread_);
+    connect(&thread_, &QThread::finished, context_, &QObject::deleteLater);
+    thread_.setObjectName(QStringLiteral("Journal"));
+    thread_.start(QThread::LowPriority);
+}
+
+Journal::~Journal() {
+    // what is queued should be written before the thread quits
+    QMetaObject::invokeMethod(context_, [] {}, Qt::BlockingQueuedConnection);
+    thread_.quit();
+    thread_.wait();
+    qDeleteAll(files_);
+    files_.clear();
+
+    if (dir_.isEmpty())
+        return;
+    lock_.unlock();  // the kept journals will be found on the next start
+    if (!keepAll_ || QDir(dir_).isEmpty())
+        QDir(dir_).removeRecursively();
+}
+
+void Journal::track(QTextDocument* doc, const QString& fileName, const QString& encoding, quint64 contentHash) {
+    if (!doc || dir_.isEmpty())
+        return;
+    auto it = entries_.find(doc);
+    if (it == entries_.end()) {
+        it = entries_.insert(doc, Entry());
+        connect(doc, &QTextDocument::contentsChange, this, &Journal::onContentsChange);
+        connect(doc, &QTextDocument::modificationChanged, this, &Journal::onModificationChanged);
+        connect(doc, &QObject::destroyed, this, &Journal::onDestroyed);
+    }
+    // an open journal still starts from its old base
+    it->fileName = fileName;
+    it->encoding = encoding;
+    it->contentHash = contentHash;
+    it->revision = doc->revision();
+}
+
+void Journal::untrack(QTextDocument* doc) {
+    const auto it = entries_.find(doc);
+    if (it == entries_.end())
+        return;
+    removeFile(it.value());
+    entries_.erase(it);
+    disconnect(doc, nullptr, this, nullptr);
+}
+
+QList<Journal::Recovery> Journal::takeOrphans() {
+    QList<Recovery> recoveries;
+    if (dir_.isEmpty())
+        return recoveries;
+    const QFileInfo own(dir_);
+    const QFileInfoList dirs = own.dir().entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo& info : dirs) {
+        const QString path = info.absoluteFilePath();
+        if (path == own.absoluteFilePath())
+            continue;
+        QLockFile lock(path + QStringLiteral("/lock"));
+        if (!lock.tryLock(0))
+            continue;  // its process is running
+        QDir dir(path);
+        const QFileInfoList journals = dir.entryInfoList({QStringLiteral("*.journal")}, QDir::Files, QDir::Name);
+        for (const QFileInfo& journal : journals) {
+            Recovery recovery;
+            if (readJournal(journal.absoluteFilePath(), recovery) &&
+                (!recovery.deltas.isEmpty() || !recovery.snapshot.isEmpty())) {
+                recoveries.append(recovery);
+            }
+        }
+        lock.unlock();
+        dir.removeRecursively();
+    }
+    return recoveries;
+}
+
+void Journal::onContentsChange(int position, int removed, int added) {
+    auto* doc = qobject_cast<QTextDocument*>(QObject::sender());
+    const auto it = entries_.find(doc);
+    if (it == entries_.end() || !doc->isUndoRedoEnabled())
+        return;  // appending a loaded or followed text isn't an edit
+    Entry& entry = it.value();
+    const int revision = doc->revision();
+    if (removed == added && revision == entry.revision)
+        return;  // only the formats are changed (e.g., by the highlighter)
+    entry.revision = revision;
+
+    if (entry.path.isEmpty()) {
+        // the document becomes modified after this signal; if it wasn't, it had the text of its file
+        if (doc->isModified() || entry.fileName.isEmpty() || entry.contentHash == 0) {
+            writeSnapshot(entry, doc);  // with this change
+            return;
+        }
+        startFile(entry);
+        append(entry,
+               fileBaseRecord(entry.fileName, entry.encoding, entry.contentHash,
+                              doc->characterCount() - added + removed),
+               true);
+    }
+
+    const int last = doc->characterCount() - 1;
+    QTextCursor cursor(doc);
+    cursor.setPosition(std::min(position, last));
+    cursor.setPosition(std::min(position + added, last), QTextCursor::KeepAnchor);
+    append(entry, deltaRecord(position, removed, cursor.selectedText()));
+
+    // the cost of a new snapshot is less than that of the edits since the last one
+    if (entry.written > std::max(kMinCompaction, 4 * static_cast<qint64>(doc->characterCount())))
+        writeSnapshot(entry, doc);
+}
+
+void Journal::onModificationChanged(bool modified) {
+    auto* doc = qobject_cast<QTextDocument*>(QObject::sender());
+    const auto it = entries_.find(doc);
+    if (it == entries_.end())
+        return;
+    if (!modified)
+        removeFile(it.value());  // saved or undone
+    else if (it->path.isEmpty() && doc->isUndoRedoEnabled())
+        writeSnapshot(it.value(), doc);  // modified without an edit
+}
+
+void Journal::onDestroyed(QObject* doc) {
+    const auto it = entries_.find(doc);
+    if (it == entries_.end())
+        return;
+    if (!keepAll_)
+        removeFile(it.value());
+    entries_.erase(it);
+}
+
+void Journal::startFile(Entry& entry) {
+    entry.path = dir_ + QLatin1Char('/') + QString::number(++fileCount_) + QStringLiteral(".journal");
+    entry.written = 0;
+}
+
+void Journal::writeSnapshot(Entry& entry, QTextDocument* doc) {
+    if (entry.path.isEmpty())
+        startFile(entry);
+    entry.written = 0;
+    // the text is encoded in the thread; a journal isn't replaced before it is complete
+    QMetaObject::invokeMethod(context_, [this, path = entry.path, fileName = entry.fileName,
+                                         encoding = entry.encoding, text = doc->toRawText()] {
+        delete files_.take(path);
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(snapshotRecord(fileName, encoding, text));
+            file.commit();
+        }
+    });
+}
+
+void Journal::append(Entry& entry, const QByteArray& bytes, bool truncate) {
+    entry.written += bytes.size();
+    QMetaObject::invokeMethod(context_, [this, path = entry.path, bytes, truncate] {
+        QFile*& file = files_[path];
+        if (!file)
+            file = new QFile(path);
+        if (truncate)
+            file->close();
+        if (!file->isOpen() && !file->open(QIODevice::WriteOnly | (truncate ? QIODevice::Truncate : QIODevice::Append)))
+            return;
+        file->write(bytes);
+        file->flush();  // to be found after a crash
+    });
+}
+
+void Journal::removeFile(Entry& entry) {
+    if (entry.path.isEmpty())
+        return;
+    QMetaObject::invokeMethod(context_, [this, path = entry.path] {
+        delete files_.take(path);
+        QFile::remove(path);
+    });
+    entry.path.clear();
+    entry.written = 0;
+}
+
+}  // namespace Texxy
@@ -0,0 +1,110 @@
+// src/core/journal.h
+/*
+  texxy/journal.h
+*/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <QHash>
+#include <QList>
+#include <QLockFile>
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+class QFile;
+class QTextDocument;
+
+namespace Texxy {
+
+/* An app-wide keeper of crash-recovery journals. While a tracked document is
+   modified, the edits reported by QTextDocument::contentsChange are appended to
+   a journal file of its own, so that the cost of journaling is proportional to
+   what is typed, not to the size of the text. A journal starts from the file that
+   the document was loaded from or saved to (known by its fingerprint, see
+   ContentHash) or, when there is no such file, from a snapshot of the text. When
+   the edits outgrow the text, the journal is replaced by a new snapshot. Files
+   are written in a thread of their own, and a journal is removed as soon as its
+   document is unmodified or closed.
+
+   The journals of a process are in a directory that is locked while it runs, so
+   that those of a process that didn't end properly can be found on startup. */
+class Journal : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(Journal)
+
+   public:
+    struct Delta {
+        int position = 0;
+        int removed = 0;
+        QString text;  // what replaced the removed characters (with U+2029 between blocks)
+    };
+
+    /* The unsaved text of a document, as it was left in a journal. */
+    struct Recovery {
+        QString fileName;  // empty for an untitled document
+        QString encoding;
+        bool fromFile = false;  // the deltas apply to the text of "fileName" as it was loaded
+        quint64 contentHash = 0;
+        int characterCount = 0;
+        QString snapshot;  // otherwise, they apply to this text
+        QList<Delta> deltas;
+
+        /* Puts the text into "doc" as an undoable edit. With "fromFile", "doc" should
+           have the text of the file, as can be checked with "contentHash" and
+           "characterCount". */
+        void replay(QTextDocument* doc) const;
+    };
+
+    explicit Journal(QObject* parent = nullptr);
+    ~Journal() override;
+
+    /* Starts or goes on journaling the edits of "doc", whose unmodified text is
+       that of the file "fileName" with the fingerprint "contentHash" (0 if it isn't
+       known). This is also called when the document is saved. */
+    void track(QTextDocument* doc, const QString& fileName, const QString& encoding, quint64 contentHash);
+    void untrack(QTextDocument* doc);
+
+    /* The journals of the modified documents are kept on exit (e.g., on logout). */
+    void keepAll() { keepAll_ = true; }
+
+    /* Reads and removes the journals that were left by the processes that didn't
+       end properly. */
+    QList<Recovery> takeOrphans();
+
+   private:
+    struct Entry {
+        QString fileName;
+        QString encoding;
+        quint64 contentHash = 0;
+        int revision = -1;
+        QString path;        // of the journal file; empty while there is none
+        qint64 written = 0;  // bytes since the last snapshot
+    };
+
+    void onContentsChange(int position, int removed, int added);
+    void onModificationChanged(bool modified);
+    void onDestroyed(QObject* doc);
+
+    void startFile(Entry& entry);
+    void writeSnapshot(Entry& entry, QTextDocument* doc);
+    void append(Entry& entry, const QByteArray& bytes, bool truncate = false);
+    void removeFile(Entry& entry);
+
+    static constexpr qint64 kMinCompaction = 1 << 20;  // bytes of deltas that are always kept
+
+    QString dir_;
+    QLockFile lock_;
+    bool keepAll_;
+    int fileCount_;
+    QHash<QObject*, Entry> entries_;  // used only in the GUI thread
+
+    QThread thread_;
+    QObject* context_;            // lives in thread_
+    QHash<QString, QFile*> files_;  // used only in thread_
+};
+
+}  // namespace Texxy
+
+#endif  // JOURNAL_H
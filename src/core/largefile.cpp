@@ -0,0 +1,261 @@
+// src/core/largefile.cpp
+/*
+  texxy/largefile.cpp
+*/
+
+#include "largefile.h"
+#include "contenthash.h"
+#include "encoding.h"
+
+#include <QStringDecoder>
+
+#include <cstring>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <atomic>
+#include <csetjmp>
+#include <csignal>
+
+#include <sys/stat.h>
+#endif
+
+namespace Texxy {
+
+namespace {
+
+inline bool isWideCharset(const QString& charset) {
+    return charset.startsWith(QLatin1String("UTF-16")) || charset.startsWith(QLatin1String("UTF-32"));
+}
+
+#ifdef Q_OS_UNIX
+/* Reading a page of the mapping that is past the end of a file truncated in the
+   meantime raises SIGBUS. The signal is caught only while the mapping is read by
+   readMapped(); otherwise, the previous action is restored and the fault repeats. */
+thread_local sigjmp_buf* busJump = nullptr;
+struct sigaction previousBusAction;
+
+void onBusError(int, siginfo_t*, void*) {
+    if (sigjmp_buf* jump = busJump) {
+        busJump = nullptr;
+        siglongjmp(*jump, 1);
+    }
+    ::sigaction(SIGBUS, &previousBusAction, nullptr);
+}
+
+void installBusHandler() {
+    static const bool installed = [] {
+        struct sigaction sa{};
+        sa.sa_sigaction = onBusError;
+        sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&sa.sa_mask);
+        return ::sigaction(SIGBUS, &sa, &previousBusAction) == 0;
+    }();
+    Q_UNUSED(installed);
+}
+
+/* Runs "read", which reads the mapping and may be left in the middle. So it must
+   neither allocate nor own anything; its output goes into room made beforehand.
+   Returns false if the file was truncated under it. */
+template <typename Read>
+bool readMapped(Read&& read) {
+    installBusHandler();
+    sigjmp_buf jump;
+    if (sigsetjmp(jump, 1) != 0)
+        return false;
+    busJump = &jump;
+    std::atomic_signal_fence(std::memory_order_seq_cst);  // the reads stay inside
+    read();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    busJump = nullptr;
+    return true;
+}
+#else
+constexpr qint64 kReadChunk = 1 << 20;
+#endif
+
+}  // namespace
+
+LargeFile::LargeFile(const QString& fname)
+    : file_(fname),
+      fileName_(fname),
+      data_(nullptr),
+      size_(0),
+      device_(0),
+      inode_(0),
+      hasNull_(false),
+      intact_(true),
+      contentHash_(0) {}
+
+LargeFile::~LargeFile() {
+    unmap();
+    file_.close();
+}
+
+void LargeFile::unmap() {
+    if (data_)
+        file_.unmap(const_cast<uchar*>(data_));
+    data_ = nullptr;
+}
+
+bool LargeFile::isIntact() const {
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::fstat(file_.handle(), &st) != 0 || st.st_size < size_)
+        return false;
+    return ::stat(QFile::encodeName(fileName_).constData(), &st) == 0 && st.st_dev == device_ && st.st_ino == inode_;
+#else
+    return file_.size() >= size_;
+#endif
+}
+
+bool LargeFile::open(const QString& charset) {
+    if (!file_.open(QFile::ReadOnly))
+        return false;
+    size_ = file_.size();
+    if (size_ <= 0)
+        return false;
+
+    // the samples are read rather than taken from the mapping, which a truncation would break
+    hasNull_ = file_.read(kSampleBytes).contains('\0');
+    charset_ = charset;
+    if (charset_.isEmpty()) {
+        if (hasNull_)
+            charset_ = QStringLiteral("UTF-8");  // a non-text file is still viewable
+        else  // the prefix and windows spread over the whole file
+            charset_ = detectCharsetFromSamples(size_, [this](qint64 from, qint64 length) {
+                return file_.seek(from) ? file_.read(length) : QByteArray();
+            });
+    }
+    // the newline index is byte-based and cannot describe wide encodings
+    if (isWideCharset(charset_))
+        return false;
+
+    ContentHash hash;  // in the pass that indexes the lines
+    const ScanSink sink = hash.sink();
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::fstat(file_.handle(), &st) != 0)
+        return false;
+    device_ = st.st_dev;
+    inode_ = st.st_ino;
+    data_ = file_.map(0, size_);
+    if (!data_)
+        return false;
+    index_.reserve(size_);
+    if (!readMapped([this, &sink] { index_.build(data_, data_ + size_, LineIndex::kNoLimit, &sink); }))
+        return false;
+    index_.squeeze();
+#else
+    if (!file_.seek(0) || !index_.build(&file_, size_, &sink))
+        return false;
+    size_ = index_.size();  // in case the file has become shorter
+#endif
+    contentHash_ = hash.result();
+    return true;
+}
+
+void LargeFile::checkFile() {
+    if (intact_ && !isIntact()) {
+        intact_ = false;
+        unmap();  // the view is emptied, instead of crashing at the next read
+    }
+}
+
+#ifdef Q_OS_UNIX
+bool LargeFile::readLines(qint64 first, std::vector<Span>& spans, size_t& found, QByteArray& bytes) {
+    /* the lines are found and copied out of the mapping before being decoded,
+       so that a truncation of the file can only interrupt reading */
+    qint64 total = 0;
+    if (!readMapped([this, first, &spans, &found, &total] {
+            qint64 start = index_.lineStart(data_, first);
+            while (found < spans.size() && total < kMaxWindowBytes) {
+                const qint64 end = LineIndex::lineEnd(data_, size_, start);
+                spans[found++] = {start, end - start};
+                total += qMin(end - start, kMaxLineBytes) + 1;
+                start = LineIndex::nextLineStart(data_, size_, end);
+            }
+        })) {
+        return false;
+    }
+    bytes.resize(static_cast<qsizetype>(total));
+    return readMapped([this, &spans, found, &bytes] {
+        char* out = bytes.data();
+        for (size_t i = 0; i < found; ++i) {
+            const qint64 len = qMin(spans[i].length, kMaxLineBytes);
+            std::memcpy(out, data_ + spans[i].start, static_cast<size_t>(len));
+            out += len + 1;
+        }
+    });
+}
+#else
+bool LargeFile::readLines(qint64 first, std::vector<Span>& spans, size_t& found, QByteArray& bytes) {
+    qint64 start = 0;  // of the current line
+    qint64 line = index_.checkpoint(first, start);
+    if (!file_.seek(start))
+        return true;  // nothing to read
+    qint64 pos = start;
+    bool cr = false;  // the last byte was a CR
+    while (pos < size_) {
+        const QByteArray chunk = file_.read(qMin(kReadChunk, size_ - pos));
+        if (chunk.isEmpty())
+            break;  // the file has become shorter
+        for (const char c : chunk) {
+            if (c == '\n' && cr) {  // the LF of a CRLF
+                start = pos + 1;
+            }
+            else if (c == '\n' || c == '\r') {
+                if (line >= first) {
+                    spans[found++] = {start, pos - start};
+                    bytes += '\n';
+                    if (found == spans.size() || bytes.size() >= kMaxWindowBytes)
+                        return true;
+                }
+                ++line;
+                start = pos + 1;
+            }
+            else if (line >= first && pos - start < kMaxLineBytes) {
+                bytes += c;
+            }
+            cr = c == '\r';
+            ++pos;
+        }
+    }
+    if (line >= first)  // the last line
+        spans[found++] = {start, pos - start};
+    return true;
+}
+#endif
+
+QString LargeFile::lines(qint64 first, qint64 count) {
+    QString text;
+    if (first < 0 || first >= lineCount() || count <= 0 || !intact_)
+        return text;
+
+    std::vector<Span> spans(static_cast<size_t>(qMin(count, lineCount() - first)));
+    size_t found = 0;
+    QByteArray bytes;
+    if (!readLines(first, spans, found, bytes)) {
+        intact_ = false;
+        unmap();
+        return text;
+    }
+
+    const auto conv = charset_ == QLatin1String("UTF-8") ? QStringConverter::Utf8 : QStringConverter::Latin1;
+    const char* in = bytes.constData();
+    for (size_t i = 0; i < found; ++i) {
+        if (i > 0)
+            text += QLatin1Char('\n');
+        const bool truncated = spans[i].length > kMaxLineBytes;
+        const qint64 len = truncated ? kMaxLineBytes : spans[i].length;
+        QStringDecoder decoder(conv);
+        text += decoder.decode(QByteArrayView(in, static_cast<qsizetype>(len)));
+        text += decoder.decode({});
+        if (truncated)
+            text += QLatin1String("    LINE TRUNCATED IN LARGE FILE VIEW");
+        in += len + 1;
+    }
+    return text;
+}
+
+}  // namespace Texxy
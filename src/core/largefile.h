@@ -0,0 +1,91 @@
+// src/core/largefile.h
+/*
+  texxy/largefile.h
+*/
+
+#ifndef LARGEFILE_H
+#define LARGEFILE_H
+
+#include <QFile>
+#include <QMetaType>
+#include <QSharedPointer>
+#include <QString>
+
+#include <vector>
+
+#include "lineindex.h"
+
+namespace Texxy {
+
+/* A read-only, memory-mapped view of a file that is too large for QTextDocument.
+   Lines are found through a sparse LineIndex, so only the lines that are shown
+   need to be decoded. Where a truncated mapping cannot be read safely (outside
+   Unix), the file is read instead of being mapped. */
+class LargeFile {
+    Q_DISABLE_COPY_MOVE(LargeFile)
+
+   public:
+    static constexpr qint64 kSizeThreshold = 100LL * 1024 * 1024;  // files above this are viewed, not loaded
+    static constexpr qint64 kMaxLineBytes = 500000;                // longer lines are truncated when shown
+
+    explicit LargeFile(const QString& fname);
+    ~LargeFile();
+
+    /* Maps the file, decides its charset (if "charset" is empty), builds the line index
+       and fingerprints the contents. Returns false if the file cannot be mapped or has a wide (UTF-16/32) encoding. */
+    bool open(const QString& charset = QString());
+
+    QString fileName() const { return fileName_; }
+    QString charset() const { return charset_; }
+    qint64 size() const { return size_; }
+    qint64 lineCount() const { return index_.lineCount(); }
+    const LineIndex& lineIndex() const { return index_; }
+    bool hasNull() const { return hasNull_; }  // a NUL byte was found in the sampled prefix
+    quint64 contentHash() const { return contentHash_; }  // see ContentHash
+
+    /* Decodes at most "count" lines starting from "first", joined by '\n'. The
+       result is also limited to about kMaxWindowBytes so that a window of very
+       long lines cannot exhaust the memory.
+       Nothing is returned once the file has been truncated or replaced (see checkFile()). */
+    QString lines(qint64 first, qint64 count);
+
+    /* Stops reading the file if it has been truncated or replaced since it was opened;
+       its mapping is dropped then. This is done when the file watcher reports a change,
+       not before every read; a truncation in between is caught while reading. */
+    void checkFile();
+
+   private:
+    struct Span {
+        qint64 start;
+        qint64 length;  // without CR/LF
+    };
+
+    /* Whether the file at the path is still the opened one and hasn't shrunk. */
+    bool isIntact() const;
+    /* Finds the lines from "first" on (as many as "spans" has room for, but hardly more
+       than kMaxWindowBytes of them) and copies them into "bytes", each one followed by a
+       byte for its end. Returns false if the file was truncated under the mapping. */
+    bool readLines(qint64 first, std::vector<Span>& spans, size_t& found, QByteArray& bytes);
+    void unmap();
+
+    static constexpr qint64 kMaxWindowBytes = 16LL * 1024 * 1024;
+    static constexpr qint64 kSampleBytes = 1024 * 1024;
+
+    QFile file_;
+    QString fileName_;
+    QString charset_;
+    const uchar* data_;
+    qint64 size_;
+    quint64 device_;  // identify the mapped file (see isIntact())
+    quint64 inode_;
+    bool hasNull_;
+    bool intact_;  // see checkFile()
+    quint64 contentHash_;
+    LineIndex index_;
+};
+
+}  // namespace Texxy
+
+Q_DECLARE_METATYPE(QSharedPointer<Texxy::LargeFile>)
+
+#endif  // LARGEFILE_H
@@ -0,0 +1,133 @@
+// src/core/linediff.cpp
+/*
+  texxy/linediff.cpp
+*/
+
+#include "linediff.h"
+
+#include <QHash>
+
+#include <vector>
+
+namespace Texxy {
+
+QList<QStringView> splitBlocks(QStringView text) {
+    QList<QStringView> lines;
+    qsizetype start = 0;
+    const qsizetype size = text.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        const QChar c = text.at(i);
+        if (c == QLatin1Char('\n') || c == QLatin1Char('\r') || c == QChar::ParagraphSeparator) {
+            lines.append(text.mid(start, i - start));
+            if (c == QLatin1Char('\r') && i + 1 < size && text.at(i + 1) == QLatin1Char('\n'))
+                ++i;
+            start = i + 1;
+        }
+    }
+    lines.append(text.mid(start));
+    return lines;
+}
+
+bool diffLines(const QList<QStringView>& a, const QList<QStringView>& b, int maxEdits, QList<LineHunk>& hunks) {
+    hunks.clear();
+
+    // the common ends, which are all there is to most changes
+    int prefix = 0;
+    const int minSize = static_cast<int>(qMin(a.size(), b.size()));
+    while (prefix < minSize && a.at(prefix) == b.at(prefix))
+        ++prefix;
+    int suffix = 0;
+    while (suffix < minSize - prefix && a.at(a.size() - 1 - suffix) == b.at(b.size() - 1 - suffix))
+        ++suffix;
+    const int n = static_cast<int>(a.size()) - prefix - suffix;
+    const int m = static_cast<int>(b.size()) - prefix - suffix;
+    if (n == 0 && m == 0)
+        return true;
+    if (n == 0 || m == 0) {
+        hunks.append({prefix, n, prefix, m});
+        return n + m <= maxEdits;
+    }
+
+    // lines are compared by their hashes first
+    std::vector<size_t> hashA(static_cast<size_t>(n)), hashB(static_cast<size_t>(m));
+    for (int i = 0; i < n; ++i)
+        hashA[static_cast<size_t>(i)] = qHash(a.at(prefix + i));
+    for (int j = 0; j < m; ++j)
+        hashB[static_cast<size_t>(j)] = qHash(b.at(prefix + j));
+    auto equal = [&](int i, int j) {
+        return hashA[static_cast<size_t>(i)] == hashB[static_cast<size_t>(j)] && a.at(prefix + i) == b.at(prefix + j);
+    };
+
+    // forward Myers, keeping the furthest x of every diagonal k before each step d
+    const int maxD = qMin(maxEdits, n + m);
+    const int offset = maxD + 1;
+    std::vector<int> v(static_cast<size_t>(2 * offset + 1), 0);
+    std::vector<std::vector<int>> trace;
+    int found = -1;
+    for (int d = 0; d <= maxD && found < 0; ++d) {
+        trace.emplace_back(v.begin() + (offset - d - 1), v.begin() + (offset + d + 2));
+        for (int k = -d; k <= d; k += 2) {
+            const int kk = offset + k;
+            int x = (k == -d || (k != d && v[kk - 1] < v[kk + 1])) ? v[kk + 1] : v[kk - 1] + 1;
+            int y = x - k;
+            while (x < n && y < m && equal(x, y)) {
+                ++x;
+                ++y;
+            }
+            v[kk] = x;
+            if (x >= n && y >= m) {
+                found = d;
+                break;
+            }
+        }
+    }
+    if (found < 0)
+        return false;
+
+    // back from the end, marking the removed and inserted lines
+    std::vector<bool> removed(static_cast<size_t>(n), false), inserted(static_cast<size_t>(m), false);
+    int x = n, y = m;
+    for (int d = found; d > 0; --d) {
+        const std::vector<int>& prev = trace[static_cast<size_t>(d)];
+        auto at = [&](int k) { return prev[static_cast<size_t>(k + d + 1)]; };
+        const int k = x - y;
+        const int prevK = (k == -d || (k != d && at(k - 1) < at(k + 1))) ? k + 1 : k - 1;
+        const int prevX = at(prevK);
+        const int prevY = prevX - prevK;
+        while (x > prevX && y > prevY) {
+            --x;
+            --y;
+        }
+        if (x == prevX)
+            inserted[static_cast<size_t>(prevY)] = true;
+        else
+            removed[static_cast<size_t>(prevX)] = true;
+        x = prevX;
+        y = prevY;
+    }
+
+    // the runs of changes are the hunks
+    int i = 0, j = 0;
+    while (i < n || j < m) {
+        if (i < n && j < m && !removed[static_cast<size_t>(i)] && !inserted[static_cast<size_t>(j)]) {
+            ++i;
+            ++j;
+            continue;
+        }
+        LineHunk hunk{prefix + i, 0, prefix + j, 0};
+        while ((i < n && removed[static_cast<size_t>(i)]) || (j < m && inserted[static_cast<size_t>(j)])) {
+            if (i < n && removed[static_cast<size_t>(i)]) {
+                ++i;
+                ++hunk.oldCount;
+            }
+            else {
+                ++j;
+                ++hunk.newCount;
+            }
+        }
+        hunks.append(hunk);
+    }
+    return true;
+}
+
+}  // namespace Texxy
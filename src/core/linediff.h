@@ -0,0 +1,33 @@
+// src/core/linediff.h
+/*
+  texxy/linediff.h
+*/
+
+#ifndef LINEDIFF_H
+#define LINEDIFF_H
+
+#include <QList>
+#include <QStringView>
+
+namespace Texxy {
+
+/* "oldCount" lines from "oldStart" are replaced by "newCount" lines from "newStart". */
+struct LineHunk {
+    int oldStart = 0;
+    int oldCount = 0;
+    int newStart = 0;
+    int newCount = 0;
+};
+
+/* The lines of a text as QTextDocument makes blocks of them: CRLF, CR, LF and
+   U+2029 end a line, and there is always at least one (maybe empty) line. */
+QList<QStringView> splitBlocks(QStringView text);
+
+/* Finds the hunks that turn the lines "a" into the lines "b", in order, with the
+   Myers algorithm after the common ends are skipped. Returns false if more than
+   "maxEdits" lines would have to be removed or inserted. */
+bool diffLines(const QList<QStringView>& a, const QList<QStringView>& b, int maxEdits, QList<LineHunk>& hunks);
+
+}  // namespace Texxy
+
+#endif  // LINEDIFF_H
@@ -0,0 +1,114 @@
+// src/core/lineindex.cpp
+/*
+  texxy/lineindex.cpp
+*/
+
+#include "lineindex.h"
+
+#include <QIODevice>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Texxy {
+
+namespace {
+
+constexpr qint64 kReadChunk = 1 << 20;
+
+}  // namespace
+
+LineScan LineIndex::build(const uchar* begin, const uchar* end, qint64 maxLine, const ScanSink* sink) {
+    starts_.clear();
+    starts_.reserve(static_cast<std::size_t>((end - begin) / (kStride * 40) + 1));
+    const LineScan scan = scanLines(begin, end, maxLine, &starts_, kStride, sink);
+    lineCount_ = scan.lineCount;
+    longestLine_ = scan.longestLine;
+    size_ = scan.cutoff >= 0 ? scan.cutoff : end - begin;
+    return scan;
+}
+
+bool LineIndex::build(QIODevice* device, qint64 size, const ScanSink* sink) {
+    starts_.assign(1, 0);
+    lineCount_ = 1;
+    longestLine_ = 0;
+    size_ = 0;
+    std::vector<uchar> chunk(static_cast<std::size_t>(kReadChunk));
+    qint64 start = 0;  // of the current line
+    bool cr = false;   // the last byte was a CR
+    while (size_ < size) {
+        const qint64 n = device->read(reinterpret_cast<char*>(chunk.data()), std::min(kReadChunk, size - size_));
+        if (n < 0)
+            return false;
+        if (n == 0)
+            break;  // the file has become shorter
+        if (sink)
+            sink->consume(sink->context, chunk.data(), chunk.data() + n);
+        for (qint64 i = 0; i < n; ++i) {
+            const uchar c = chunk[static_cast<std::size_t>(i)];
+            if (c == '\n' && cr) {  // the LF of a CRLF moves the start of the line after it
+                start = size_ + i + 1;
+                if ((lineCount_ - 1) % kStride == 0)
+                    starts_.back() = start;
+            }
+            else if (c == '\n' || c == '\r') {
+                longestLine_ = std::max(longestLine_, size_ + i - start);
+                start = size_ + i + 1;
+                if (lineCount_++ % kStride == 0)
+                    starts_.push_back(start);
+            }
+            cr = c == '\r';
+        }
+        size_ += n;
+    }
+    longestLine_ = std::max(longestLine_, size_ - start);
+    return true;
+}
+
+void LineIndex::reserve(qint64 size) {
+    // a line ends with a byte at least, and only every kStride-th start is kept
+    starts_.reserve(static_cast<std::size_t>(size / kStride + 1));
+}
+
+qint64 LineIndex::lineEnd(const uchar* data, qint64 size, qint64 start) {
+    if (start >= size)
+        return size;
+    // look for CR only before the first LF, so that neither search runs to the end in vain
+    const uchar* p = data + start;
+    const auto* lf = static_cast<const uchar*>(std::memchr(p, '\n', static_cast<size_t>(size - start)));
+    const uchar* limit = lf ? lf : data + size;
+    const auto* cr = static_cast<const uchar*>(std::memchr(p, '\r', static_cast<size_t>(limit - p)));
+    return (cr ? cr : limit) - data;
+}
+
+qint64 LineIndex::nextLineStart(const uchar* data, qint64 size, qint64 end) {
+    if (end >= size)
+        return size;
+    if (data[end] == '\r' && end + 1 < size && data[end + 1] == '\n')
+        return end + 2;
+    return end + 1;
+}
+
+qint64 LineIndex::lineStart(const uchar* data, qint64 line) const {
+    if (line <= 0 || starts_.empty())
+        return 0;
+    if (line >= lineCount_)
+        return size_;
+    const qint64 cp = line / kStride;
+    qint64 offset = starts_.at(static_cast<std::size_t>(cp));
+    for (qint64 i = cp * kStride; i < line; ++i)
+        offset = nextLineStart(data, size_, lineEnd(data, size_, offset));
+    return offset;
+}
+
+qint64 LineIndex::checkpoint(qint64 line, qint64& start) const {
+    if (starts_.empty()) {
+        start = 0;
+        return 0;
+    }
+    const qint64 cp = std::clamp<qint64>(line, 0, lineCount_ - 1) / kStride;
+    start = starts_.at(static_cast<std::size_t>(cp));
+    return cp * kStride;
+}
+
+}  // namespace Texxy
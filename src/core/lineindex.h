@@ -0,0 +1,70 @@
+// src/core/lineindex.h
+/*
+  texxy/lineindex.h
+*/
+
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+
+#include <QtGlobal>
+
+#include <limits>
+#include <vector>
+
+#include "textscan.h"
+
+class QIODevice;
+
+namespace Texxy {
+
+/* Line starts in the raw bytes of a file, recorded by the scan that precedes
+   decoding. Lines end like QTextDocument blocks (with LF, CRLF or a lone CR),
+   so the line count of the index is the block count of the unedited document.
+   Only every kStride-th line start is kept; the others are found by scanning
+   forward from the nearest one. Byte-oriented encodings only. */
+class LineIndex {
+   public:
+    static constexpr qint64 kStride = 1024;
+    static constexpr qint64 kNoLimit = std::numeric_limits<qint64>::max() / 4;
+
+    LineIndex() = default;
+
+    /* Indexes the bytes up to the first line that is longer than "maxLine"
+       and returns what the scan found (see scanLines()). A sink gets all the bytes.
+       Nothing is allocated if reserve() has made room for the bytes. */
+    LineScan build(const uchar* begin,
+                   const uchar* end,
+                   qint64 maxLine = kNoLimit,
+                   const ScanSink* sink = nullptr);
+    /* Indexes at most "size" bytes read from "device", from its position on.
+       Returns false on a read error. */
+    bool build(QIODevice* device, qint64 size, const ScanSink* sink = nullptr);
+
+    /* Makes room for the line starts of any "size" bytes, and gives back what isn't used. */
+    void reserve(qint64 size);
+    void squeeze() { starts_.shrink_to_fit(); }
+
+    qint64 lineCount() const noexcept { return lineCount_; }
+    qint64 longestLine() const noexcept { return longestLine_; }  // in bytes, without CR/LF
+    qint64 size() const noexcept { return size_; }                // indexed bytes
+
+    /* The offset of the first byte of "line" in the indexed "data". */
+    qint64 lineStart(const uchar* data, qint64 line) const;
+    /* The nearest line at or before "line" whose start is kept, and that start. */
+    qint64 checkpoint(qint64 line, qint64& start) const;
+
+    /* The offset of the CR/LF that ends the line starting at "start" (or "size"). */
+    static qint64 lineEnd(const uchar* data, qint64 size, qint64 start);
+    /* The start of the next line if "end" is the end of a line. */
+    static qint64 nextLineStart(const uchar* data, qint64 size, qint64 end);
+
+   private:
+    std::vector<std::int64_t> starts_;  // starts of lines 0, kStride, 2*kStride...
+    qint64 lineCount_ = 1;
+    qint64 longestLine_ = 0;
+    qint64 size_ = 0;
+};
+
+}  // namespace Texxy
+
+#endif  // LINEINDEX_H
@@ -0,0 +1,90 @@
+// src/core/linesplitter.cpp
+/*
+  texxy/linesplitter.cpp
+*/
+
+#include "linesplitter.h"
+
+namespace Texxy {
+
+namespace {
+
+// breaking after these keeps tokens, numbers and words whole; spaces are
+// avoided because a segment ending with them could lose them on saving
+inline bool isBreakAfter(QChar c) {
+    switch (c.unicode()) {
+        case ',':
+        case ';':
+        case '>':
+        case ')':
+        case ']':
+        case '}':
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+QString LineSplitter::split(const QString& part, bool more) {
+    const QString text = pending_.isEmpty() ? part : pending_ + part;
+    pending_.clear();
+    const QChar* p = text.constData();
+    const qsizetype n = text.size();
+
+    QString out;
+    qsizetype copied = 0;  // the part of "text" that is already in "out"
+    qsizetype kept = n;    // where the held-back part begins
+    qsizetype start = 0;   // of the current line
+    for (;;) {
+        qsizetype end = start;
+        while (end < n && p[end] != u'\n' && p[end] != u'\r')
+            ++end;
+        const bool complete = end < n || !more;
+
+        qsizetype rest = start;  // of the line, after its soft breaks
+        if (huge_ || end - start > kHugeLine) {
+            while (end - rest > kSegmentLength) {
+                // break before p[cut], after a delimiter if one is near
+                qsizetype cut = rest + kSegmentLength;
+                for (qsizetype j = cut; j > cut - kBreakSlack; --j) {
+                    if (isBreakAfter(p[j - 1])) {
+                        cut = j;
+                        break;
+                    }
+                }
+                if (p[cut].isLowSurrogate())
+                    --cut;
+
+                if (out.isEmpty())
+                    out.reserve(n + n / (kSegmentLength - kBreakSlack) + 1);
+                out.append(p + copied, cut - copied);
+                out.append(QLatin1Char('\n'));
+                copied = cut;
+                softBreaks_.append(++block_);
+                rest = cut;
+            }
+            huge_ = !complete;
+        }
+        if (!complete) {
+            kept = rest;
+            pending_ = text.sliced(kept);
+            break;
+        }
+        if (end == n)
+            break;
+
+        if (p[end] == u'\r' && end + 1 < n && p[end + 1] == u'\n')
+            ++end;
+        ++block_;
+        start = end + 1;
+    }
+
+    if (copied == 0)
+        return kept == n ? text : text.first(kept);  // no huge line
+    out.append(p + copied, kept - copied);
+    return out;
+}
+
+}  // namespace Texxy
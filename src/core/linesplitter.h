@@ -0,0 +1,44 @@
+// src/core/linesplitter.h
+/*
+  texxy/linesplitter.h
+*/
+
+#ifndef LINESPLITTER_H
+#define LINESPLITTER_H
+
+#include <QList>
+#include <QString>
+
+namespace Texxy {
+
+/* Splits the lines of a decoded text that are too long to be laid out and
+   highlighted as single blocks (those of more than kHugeLine characters). Such a
+   line is broken into segments of about kSegmentLength characters, preferably
+   after a delimiter. The inserted line feeds are "soft breaks": the editor shows
+   the line numbers of the file and removes them when the text is saved.
+   The text may be given in consecutive parts; a CR ending a part should be kept
+   for the next one (see Loading). */
+class LineSplitter {
+   public:
+    static constexpr qsizetype kHugeLine = 500000;
+    static constexpr qsizetype kSegmentLength = 4096;
+    static constexpr qsizetype kBreakSlack = 256;  // how far back a delimiter is looked for
+
+    /* Returns "text" with soft breaks in its huge lines. If "more" is true, a part
+       follows, and the unfinished last line is held back until it is known whether
+       it is huge (its segments, as soon as they are complete). */
+    QString split(const QString& text, bool more = false);
+
+    /* The numbers of the blocks that begin after soft breaks, in order. */
+    const QList<int>& softBreaks() const noexcept { return softBreaks_; }
+
+   private:
+    QString pending_;     // the held-back start of a line
+    bool huge_ = false;   // "pending_" is the last segment of a huge line
+    int block_ = 0;       // block number of the current position
+    QList<int> softBreaks_;
+};
+
+}  // namespace Texxy
+
+#endif  // LINESPLITTER_H
@@ -0,0 +1,141 @@
+// src/core/loaderpool.cpp
+/*
+  texxy/loaderpool.cpp
+*/
+
+#include "loaderpool.h"
+
+#include <QTimer>
+
+#include <algorithm>
+
+namespace Texxy {
+
+namespace {
+
+// a few parallel reads are enough to keep the disk busy; more only compete for it
+constexpr int kAutoMaxThreads = 4;
+
+}  // namespace
+
+LoaderPool::LoaderPool(int maxThreads, QObject* parent) : QObject(parent), maxThreads_(1), startScheduled_(false) {
+    setMaxThreads(maxThreads);
+}
+
+LoaderPool::~LoaderPool() {
+    for (const Job& job : std::as_const(pending_))
+        delete job.thread;
+    pending_.clear();
+
+    // the threads cannot outlive their objects
+    for (const Job& job : std::as_const(running_))
+        job.thread->requestInterruption();
+    for (const Job& job : std::as_const(running_)) {
+        disconnect(job.thread, nullptr, this, nullptr);
+        job.thread->wait();
+        delete job.thread;
+    }
+    running_.clear();
+}
+
+void LoaderPool::setMaxThreads(int maxThreads) {
+    if (maxThreads <= 0)
+        maxThreads = std::clamp(QThread::idealThreadCount(), 1, kAutoMaxThreads);
+    maxThreads_ = maxThreads;
+    scheduleStart();
+}
+
+void LoaderPool::enqueue(QThread* thread, QObject* owner, bool urgent) {
+    if (!thread)
+        return;
+    connect(thread, &QThread::finished, this, &LoaderPool::onThreadFinished);
+
+    const Job job{thread, owner, urgent};
+    if (urgent) {
+        // after other urgent loaders but before the rest
+        const auto it = std::find_if(pending_.begin(), pending_.end(), [](const Job& j) { return !j.urgent; });
+        pending_.insert(it, job);
+    }
+    else
+        pending_.append(job);
+
+    if (urgent && running_.size() < maxThreads_)
+        startPending();  // no need to wait for the event loop
+    else
+        scheduleStart();
+}
+
+void LoaderPool::startNow(QThread* thread) {
+    const auto it =
+        std::find_if(pending_.begin(), pending_.end(), [thread](const Job& job) { return job.thread == thread; });
+    if (it == pending_.end())
+        return;  // running or finished
+    const Job job = *it;
+    pending_.erase(it);
+    running_.append(job);
+    job.thread->start();
+}
+
+void LoaderPool::cancel(QObject* owner) {
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->owner == owner || it->owner.isNull()) {
+            delete it->thread;
+            it = pending_.erase(it);
+        }
+        else
+            ++it;
+    }
+    for (const Job& job : std::as_const(running_)) {
+        if (job.owner == owner)
+            job.thread->requestInterruption();
+    }
+}
+
+void LoaderPool::cancelThread(QThread* thread) {
+    const auto it =
+        std::find_if(pending_.begin(), pending_.end(), [thread](const Job& job) { return job.thread == thread; });
+    if (it != pending_.end()) {
+        delete it->thread;
+        pending_.erase(it);
+    }
+    else if (std::any_of(running_.cbegin(), running_.cend(), [thread](const Job& job) { return job.thread == thread; }))
+        thread->requestInterruption();
+}
+
+void LoaderPool::onThreadFinished() {
+    auto* thread = qobject_cast<QThread*>(QObject::sender());
+    if (!thread)
+        return;
+    running_.erase(std::remove_if(running_.begin(), running_.end(),
+                                  [thread](const Job& job) { return job.thread == thread; }),
+                   running_.end());
+    thread->deleteLater();  // its queued results may still be delivered
+    scheduleStart();
+}
+
+/* Threads are started from the event loop, so that the results of finished
+   threads are handled before new ones arrive and the UI stays responsive
+   while many files are being opened. */
+void LoaderPool::scheduleStart() {
+    if (startScheduled_ || pending_.isEmpty())
+        return;
+    startScheduled_ = true;
+    QTimer::singleShot(0, this, [this] {
+        startScheduled_ = false;
+        startPending();
+    });
+}
+
+void LoaderPool::startPending() {
+    while (!pending_.isEmpty() && running_.size() < maxThreads_) {
+        const Job job = pending_.takeFirst();
+        if (job.owner.isNull()) {
+            delete job.thread;  // nobody waits for it
+            continue;
+        }
+        running_.append(job);
+        job.thread->start();
+    }
+}
+
+}  // namespace Texxy
@@ -0,0 +1,67 @@
+// src/core/loaderpool.h
+/*
+  texxy/loaderpool.h
+*/
+
+#ifndef LOADERPOOL_H
+#define LOADERPOOL_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QThread>
+
+namespace Texxy {
+
+/* An app-wide queue of the threads that read or write files (see Loading and
+   Saving). At most maxThreads() of them run at the same time, urgent ones (the
+   current tab) are started first, and the threads of a window can be cancelled
+   when it goes away. */
+class LoaderPool : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(LoaderPool)
+
+   public:
+    explicit LoaderPool(int maxThreads = 0, QObject* parent = nullptr);
+    ~LoaderPool() override;
+
+    /* 0 means a limit based on the number of CPU cores. */
+    void setMaxThreads(int maxThreads);
+    int maxThreads() const noexcept { return maxThreads_; }
+
+    /* Takes ownership of "thread". Its signals should be connected to "owner"
+       before this call; it is never started if "owner" is deleted first. */
+    void enqueue(QThread* thread, QObject* owner, bool urgent = false);
+
+    /* Starts a pending thread without waiting for its turn (e.g., because the GUI
+       waits for it). */
+    void startNow(QThread* thread);
+
+    /* Drops the pending threads of "owner" and interrupts its running ones;
+       loaders then exit without emitting their results. */
+    void cancel(QObject* owner);
+    /* The same for a single thread (e.g., a loader whose tab is closed). */
+    void cancelThread(QThread* thread);
+
+   private slots:
+    void onThreadFinished();
+
+   private:
+    struct Job {
+        QThread* thread;
+        QPointer<QObject> owner;
+        bool urgent;
+    };
+
+    void scheduleStart();
+    void startPending();
+
+    QList<Job> pending_;
+    QList<Job> running_;
+    int maxThreads_;
+    bool startScheduled_;
+};
+
+}  // namespace Texxy
+
+#endif  // LOADERPOOL_H
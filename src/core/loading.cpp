@@ -4,33 +4,48 @@
 */
 
 #include "loading.h"
+#include "contenthash.h"
 #include "encoding.h"
+#include "linesplitter.h"
+#include "textscan.h"
 
+#include <QCoreApplication>
 #include <QFile>
+#include <QPlainTextDocumentLayout>
 #include <QStringDecoder>
+#include <QTextDocument>
 #include <QtGlobal>
 
 namespace Texxy {
 
-static inline void appendHugeLineNotice(QString& out) {
-    // same message as original path but appended after streaming decode
-    static const QLatin1String msg("    HUGE LINE TRUNCATED: NO LINE WITH MORE THAN 500000 CHARACTERS");
-    out += msg;
+// a CR at the end of a streamed part may be the first half of CRLF,
+// so it is moved to the next part instead of starting an empty line
+static inline QString holdBackCR(QString& text) {
+    if (text.endsWith(QLatin1Char('\r'))) {
+        text.chop(1);
+        return QStringLiteral("\r");
+    }
+    return QString();
 }
 
 // scan buffer to
 //  - detect presence of NULs
-//  - compute first huge-line cutoff index if any
+//  - find the longest line
+//  - count the kinds of line ends
 //  - keep simple UTF-16/32 heuristics from the original logic
-// returns cutoff index or -1 if no cutoff is needed
 struct ScanResult {
     bool hasNull = false;
     bool likelyUtf16 = false;
     bool likelyUtf32 = false;
-    qint64 cutoff = -1;
+    qint64 longestLine = 0;  // in bytes
+    LineScan lines;          // line ends are meaningful only in byte encodings
 };
 
-static inline ScanResult scanBuffer(const uchar* begin, const uchar* end, bool enforced) {
+static inline ScanResult scanBuffer(const uchar* begin,
+                                    const uchar* end,
+                                    bool enforced,
+                                    LineIndex& index,
+                                    const ScanSink* sink = nullptr) {
     ScanResult r;
     if (!begin || begin >= end)
         return r;
@@ -74,41 +89,58 @@ static inline ScanResult scanBuffer(const uchar* begin, const uchar* end, bool e
         }
     }
 
-    // compute huge-line cutoff in a single walk without building a copy
-    // thresholds match original logic
-    const int thresholdText = 500000;
-    const int thresholdWide = 500004;  // multiple of 4
-    int lineLen = 0;
-    const int threshold = (enforced || r.likelyUtf16 || r.likelyUtf32) ? thresholdWide : thresholdText;
+    // NULs, the longest line, line ends and the line index come from one vectorized scan
+    r.lines = index.build(begin, end, LineIndex::kNoLimit, sink);
+    index.squeeze();
+    r.hasNull |= r.lines.hasNull;
+    r.longestLine = r.lines.longestLine;
 
-    // if we already peeked into the first bytes, seed line length
-    lineLen = peeks;
+    return r;
+}
 
-    // include the peeked bytes in cutoff consideration
-    for (qint64 i = 0; i < peeks; ++i) {
-        const char c = static_cast<char>(C[i]);
-        if (c == '\n' || c == '\r')
-            lineLen = 0;
-        if (lineLen > threshold && r.cutoff < 0)
-            r.cutoff = i;  // cutoff occurs right before this byte
+// in wide encodings, CR and LF are counted in the decoded text
+static LineScan countLineEnds(QStringView text) {
+    LineScan r;
+    const qsizetype n = text.size();
+    for (qsizetype i = 0; i < n; ++i) {
+        const char16_t c = text.at(i).unicode();
+        if (c == u'\n') {
+            ++r.lfCount;
+        }
+        else if (c == u'\r') {
+            if (i + 1 < n && text.at(i + 1) == QLatin1Char('\n')) {
+                ++r.crlfCount;
+                ++i;
+            }
+            else {
+                ++r.crCount;
+            }
+        }
     }
+    return r;
+}
 
-    // continue scanning from after the peek
-    for (const uchar* p = begin + peeks; p < end; ++p) {
-        const char c = static_cast<char>(*p);
-        r.hasNull |= (c == '\0');
-        if (c == '\n' || c == '\r')
-            lineLen = 0;
-        ++lineLen;
-
-        if (lineLen > threshold && r.cutoff < 0) {
-            // cutoff index is number of bytes to keep from start
-            r.cutoff = p - begin - (enforced || r.likelyUtf16 || r.likelyUtf32 ? ((lineLen - threshold) % 4) : 0);
-            break;  // first cutoff position is enough
-        }
+// the charset of a text whose charset isn't enforced; NULs make it "nonText"
+static QString guessCharset(const ScanResult& scan, const uchar* begin, const uchar* end, bool& nonText) {
+    nonText = false;
+    if (scan.hasNull) {
+        nonText = true;
+        return QStringLiteral("UTF-8");
     }
+    if (scan.likelyUtf16)
+        return QStringLiteral("UTF-16");
+    if (scan.likelyUtf32)
+        return QStringLiteral("UTF-32");
+    // zero-copy view into the data; only samples of it are read here because the decoder checks the rest
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(begin), static_cast<int>(end - begin));
+    return detectCharsetFromSamples(raw);
+}
 
-    return r;
+QStringConverter::Encoding Loading::converterFor(const QString& charset) {
+    return charset == "UTF-8"    ? QStringConverter::Utf8
+           : charset == "UTF-16" ? QStringConverter::Utf16
+           : charset == "UTF-32" ? QStringConverter::Utf32
+                                 : QStringConverter::Latin1;
 }
 
 // ctor definition to match header and resolve undefined reference
@@ -126,7 +158,29 @@ Loading::Loading(const QString& fname,
       posInLine_(posInLine),
       forceUneditable_(forceUneditable),
       multiple_(multiple),
-      skipNonText_(true) {}
+      skipNonText_(true),
+      progressive_(false),
+      streaming_(false),
+      decodingErrors_(false),
+      compressed_(false),
+      truncated_(false),
+      unchanged_(false),
+      mixedLineEnds_(false),
+      lineEnd_(LineEnd::Lf),
+      fileSize_(0),
+      contentHash_(0),
+      knownSize_(-1),
+      knownHash_(0),
+      baseRevision_(-1),
+      hasLineDiff_(false),
+      document_(nullptr) {
+    /* for passing large files through the queued completed() signal */
+    qRegisterMetaType<QSharedPointer<LargeFile>>();
+}
+
+Loading::~Loading() {
+    delete document_;  // not taken
+}
 
 void Loading::run() {
     if (!QFile::exists(fname_)) {
@@ -136,17 +190,48 @@ void Loading::run() {
     }
 
     QFile file(fname_);
-    const qint64 sizeLimit = 100LL * 1024 * 1024;
-    if (file.size() > sizeLimit) {
-        emit completed(QString(), fname_);
-        return;
-    }
     if (!file.open(QFile::ReadOnly)) {
         emit completed();
         return;
     }
 
-    const qint64 fsz = file.size();
+    fileSize_ = file.size();
+
+    // a compressed file is decompressed while it is decoded, whatever its size
+    const QByteArray magic = file.peek(8);
+    const auto compression =
+        Decompressor::detect(reinterpret_cast<const uchar*>(magic.constData()), static_cast<qint64>(magic.size()));
+    compressed_ = Decompressor::isAvailable(compression);
+
+    if (!compressed_ && file.size() > LargeFile::kSizeThreshold) {
+        file.close();
+        // indexing a large file again is wasted if it was only touched
+        if (reload_ && charset_.isEmpty() && knownHash_ != 0 && fileSize_ == knownSize_) {
+            quint64 hash = 0;
+            if (ContentHash::ofFile(fname_, hash) && hash == knownHash_) {
+                unchanged_ = true;
+                contentHash_ = hash;
+                emit completed(QString(), fname_, QString(), false, reload_);
+                return;
+            }
+        }
+        // too large for a document; show it through a memory-mapped, line-indexed view
+        auto largeFile = QSharedPointer<LargeFile>::create(fname_);
+        if (!largeFile->open(charset_)) {
+            emit completed(QString(), fname_);
+            return;
+        }
+        if (charset_.isEmpty() && skipNonText_ && largeFile->hasNull()) {
+            emit completed(QString(), QString(), "UTF-8");
+            return;
+        }
+        contentHash_ = largeFile->contentHash();
+        emit completed(QString(), fname_, largeFile->charset(), !charset_.isEmpty(), reload_, restoreCursor_,
+                       posInLine_, true, multiple_, largeFile);
+        return;
+    }
+
+    const qint64 fsz = fileSize_;
 
     // keep the mmap pointer writable for QFile::unmap, but expose a const view for scanning/decoding
     uchar* mapped = fsz ? file.map(0, fsz) : nullptr;
@@ -179,8 +264,23 @@ void Loading::run() {
 
     const bool enforced = !charset_.isEmpty();
 
-    // fast scan to determine nulls, cutoff, and wide enc guesses
-    const ScanResult scan = scanBuffer(begin, end, enforced);
+    if (isInterruptionRequested())
+        return;
+
+    if (compressed_) {
+        contentHash_ = ContentHash::of(begin, end);  // the compressed bytes are few and read once more anyway
+        loadCompressed(begin, end, compression);
+        file.close();
+        return;
+    }
+
+    // fast scan to determine nulls, the longest line, wide enc guesses and line starts
+    // the fingerprint of the file is taken in the same pass
+    auto index = QSharedPointer<LineIndex>::create();
+    ContentHash hash;
+    const ScanSink sink = hash.sink();
+    const ScanResult scan = scanBuffer(begin, end, enforced, *index, &sink);
+    contentHash_ = hash.result();
 
     // skip non-text if configured and nulls found with no charset decision
     if (!enforced && skipNonText_ && scan.hasNull && charset_.isEmpty()) {
@@ -190,61 +290,251 @@ void Loading::run() {
     }
 
     // decide charset
+    bool verifyUtf8 = false;  // UTF-8 was guessed from samples
     if (charset_.isEmpty()) {
-        if (scan.hasNull) {
-            // treat as non-text but still open as UTF-8 like original
-            forceUneditable_ = true;
-            charset_ = "UTF-8";
-        }
-        else if (scan.likelyUtf16) {
-            charset_ = "UTF-16";
-        }
-        else if (scan.likelyUtf32) {
-            charset_ = "UTF-32";
-        }
-        else {
-            // zero-copy view into mapped data for detection to avoid copying the whole file
-            const QByteArray raw =
-                QByteArray::fromRawData(reinterpret_cast<const char*>(begin), static_cast<int>(end - begin));
-            charset_ = detectCharset(raw);
-        }
+        bool nonText = false;
+        charset_ = guessCharset(scan, begin, end, nonText);
+        if (nonText)
+            forceUneditable_ = true;  // treat as non-text but still open as UTF-8 like original
+        verifyUtf8 = !nonText && charset_ == "UTF-8";
     }
 
     // choose decoder once
-    const auto conv = charset_ == "UTF-8"    ? QStringConverter::Utf8
-                      : charset_ == "UTF-16" ? QStringConverter::Utf16
-                      : charset_ == "UTF-32" ? QStringConverter::Utf32
-                                             : QStringConverter::Latin1;
-
+    auto conv = converterFor(charset_);
     QStringDecoder decoder(conv);
 
+    // an invalid sequence outside the samples means that the text isn't UTF-8;
+    // like detectCharset(), fall back to ISO-8859-1, which keeps every byte
+    auto fallBackToLatin1 = [&]() {
+        charset_ = "ISO-8859-1";
+        conv = QStringConverter::Latin1;
+        decoder = QStringDecoder(conv);
+        verifyUtf8 = false;
+    };
+
+    // CR/LF bytes are characters only in byte-oriented encodings, where the scan also tells
+    // whether there may be huge lines (a line has at least as many bytes as characters);
+    // otherwise, the splitter finds them in the decoded text
+    const bool byteEncoding = conv == QStringConverter::Utf8 || conv == QStringConverter::Latin1;
+    const bool splitLines = !byteEncoding || scan.longestLine > LineSplitter::kHugeLine;
+    LineSplitter splitter;
+
+    // soft breaks add blocks that aren't lines of the file
+    if (byteEncoding && !splitLines)
+        lineIndex_ = index;
+    if (byteEncoding)
+        setLineEnds(scan.lines);
+
     // stream decode directly from data view to avoid building a second full-size buffer
-    // if we need to truncate a huge line, decode only up to cutoff and then append the notice
     QString text;
-    text.reserve(static_cast<int>(qMin<qint64>(fsz, 1'500'000)));  // rough reservation to reduce reallocs
+    constexpr qint64 CHUNK = 1 << 20;  // 1 MiB chunks
+    const qint64 keepLen = end - begin;
+
+    // a big file is sent in parts, so that its first page can be shown without waiting for the rest
+    if (progressive_ && keepLen > kStreamThreshold) {
+        streaming_ = true;
+        const auto firstView = QByteArrayView(reinterpret_cast<const char*>(begin), static_cast<int>(kFirstPart));
+        text = decoder.decode(firstView);
+        if (verifyUtf8 && decoder.hasError()) {
+            fallBackToLatin1();
+            text = decoder.decode(firstView);
+        }
+        if (!byteEncoding)
+            setLineEnds(countLineEnds(text));
+        QString carry = holdBackCR(text);
+        if (splitLines)
+            text = splitter.split(text, true);
+        emit completed(text, fname_, charset_, enforced, reload_, restoreCursor_, posInLine_, forceUneditable_,
+                       multiple_);
 
-    const qint64 keepLen = scan.cutoff >= 0 ? scan.cutoff : (end - begin);
-    if (keepLen > 0) {
-        constexpr qint64 CHUNK = 1 << 20;  // 1 MiB chunks
-        qint64 processed = 0;
+        qint64 processed = kFirstPart;
         while (processed < keepLen) {
+            if (isInterruptionRequested())
+                return;  // the window is gone
             const qint64 n = qMin(CHUNK, keepLen - processed);
             const auto view = QByteArrayView(reinterpret_cast<const char*>(begin + processed), static_cast<int>(n));
-            text += decoder.decode(view);
+            QString chunk = carry + decoder.decode(view);
+            if (verifyUtf8 && decoder.hasError()) {
+                // too late for a fallback; the text is shown but cannot be saved as it is
+                verifyUtf8 = false;
+                decodingErrors_ = true;
+            }
+            carry = holdBackCR(chunk);
+            if (splitLines)
+                chunk = splitter.split(chunk, true);
+            emit chunkLoaded(chunk, false);
             processed += n;
         }
+
+        QString last = carry + decoder.decode({});
+        if (verifyUtf8 && decoder.hasError())
+            decodingErrors_ = true;  // an incomplete sequence at the end
+        if (splitLines) {
+            last = splitter.split(last);
+            softBreaks_ = splitter.softBreaks();
+        }
+        file.close();
+        emit chunkLoaded(last, true);
+        return;
+    }
+
+    text.reserve(static_cast<int>(qMin<qint64>(fsz, 1'500'000)));  // rough reservation to reduce reallocs
+    qint64 processed = 0;
+    while (processed < keepLen) {
+        if (isInterruptionRequested())
+            return;
+        const qint64 n = qMin(CHUNK, keepLen - processed);
+        const auto view = QByteArrayView(reinterpret_cast<const char*>(begin + processed), static_cast<int>(n));
+        text += decoder.decode(view);
+        processed += n;
+        if (verifyUtf8 && decoder.hasError()) {
+            fallBackToLatin1();
+            text.clear();
+            processed = 0;
+        }
     }
 
     // finalize the decoder state
     text += decoder.decode({});  // flush any pending partial sequence
+    if (verifyUtf8 && decoder.hasError()) {
+        // an incomplete sequence at the end
+        fallBackToLatin1();
+        text = decoder.decode(QByteArrayView(reinterpret_cast<const char*>(begin), static_cast<int>(keepLen)));
+    }
 
-    if (scan.cutoff >= 0) {
-        appendHugeLineNotice(text);
-        forceUneditable_ = true;
+    if (!byteEncoding)
+        setLineEnds(countLineEnds(text));
+    if (splitLines) {
+        text = splitter.split(text);
+        softBreaks_ = splitter.softBreaks();
+        if (byteEncoding && softBreaks_.isEmpty())
+            lineIndex_ = index;  // no line was huge after all
     }
 
     file.close();
 
+    // on reloading, only the changed lines need to be replaced
+    if (!baseText_.isNull() && softBreaks_.isEmpty()) {
+        if (isInterruptionRequested())
+            return;
+        hasLineDiff_ = diffLines(splitBlocks(baseText_), splitBlocks(text), kMaxDiffEdits, lineHunks_);
+        baseText_.clear();
+    }
+
+    if (!hasLineDiff_ && !makeDocument(text))
+        return;
+
+    emit completed(text, fname_, charset_, enforced, reload_, restoreCursor_, posInLine_, forceUneditable_, multiple_);
+}
+
+bool Loading::makeDocument(const QString& text) {
+    // creating the blocks of a long text would freeze the GUI thread, so they are
+    // created here; only the layout of what is shown is left to the editor
+    if (text.size() < kDocumentThreshold)
+        return true;
+    if (isInterruptionRequested())
+        return false;
+    auto* doc = new QTextDocument;
+    doc->setDocumentLayout(new QPlainTextDocumentLayout(doc));
+    doc->setPlainText(text);
+    doc->setModified(false);
+    doc->moveToThread(QCoreApplication::instance()->thread());
+    document_ = doc;
+    return true;
+}
+
+void Loading::loadCompressed(const uchar* begin, const uchar* end, Decompressor::Format format) {
+    Decompressor decompressor(format, begin, end);
+    constexpr qint64 CHUNK = 1 << 20;  // 1 MiB chunks, as with uncompressed files
+    const bool enforced = !charset_.isEmpty();
+
+    // the decompressed size isn't known beforehand, so the first part stands for the whole text
+    QByteArray part(static_cast<int>(CHUNK), Qt::Uninitialized);
+    part.resize(static_cast<int>(qMax<qint64>(decompressor.read(part.data(), kFirstPart), 0)));
+    const auto* partBegin = reinterpret_cast<const uchar*>(part.constData());
+    LineIndex index;  // only for the scan
+    const ScanResult scan = scanBuffer(partBegin, partBegin + part.size(), enforced, index);
+
+    if (!enforced && skipNonText_ && scan.hasNull) {
+        emit completed(QString(), QString(), "UTF-8");
+        return;
+    }
+
+    bool verifyUtf8 = false;
+    if (!enforced) {
+        bool nonText = false;
+        charset_ = guessCharset(scan, partBegin, partBegin + part.size(), nonText);
+        verifyUtf8 = !nonText && charset_ == "UTF-8";
+    }
+    forceUneditable_ = true;  // the text isn't written back compressed
+
+    QStringDecoder decoder(converterFor(charset_));
+    QString text = decoder.decode(part);
+    if (verifyUtf8 && decoder.hasError()) {
+        charset_ = "ISO-8859-1";
+        decoder = QStringDecoder(QStringConverter::Latin1);
+        verifyUtf8 = false;
+        text = decoder.decode(part);
+    }
+    // the first part stands for the whole text here too
+    setLineEnds(charset_ == "UTF-16" || charset_ == "UTF-32" ? countLineEnds(text) : scan.lines);
+
+    // huge lines are found as they arrive
+    LineSplitter splitter;
+    QString carry;
+    streaming_ = progressive_;
+    if (streaming_) {
+        carry = holdBackCR(text);
+        emit completed(splitter.split(text, true), fname_, charset_, enforced, reload_, restoreCursor_, posInLine_,
+                       forceUneditable_, multiple_);
+        text.clear();
+    }
+
+    // the size limit of documents applies to the decompressed text
+    qint64 total = part.size();
+    while (!decompressor.atEnd()) {
+        if (isInterruptionRequested())
+            return;
+        if (total >= LargeFile::kSizeThreshold) {
+            truncated_ = decompressor.read(part.data(), 1) > 0;
+            break;
+        }
+        part.resize(static_cast<int>(CHUNK));
+        const qint64 n = decompressor.read(part.data(), qMin(CHUNK, LargeFile::kSizeThreshold - total));
+        if (n <= 0)
+            break;
+        part.resize(static_cast<int>(n));
+        total += n;
+        QString chunk = carry + decoder.decode(part);
+        if (verifyUtf8 && decoder.hasError()) {
+            // the decompressed bytes aren't kept, so there is no fallback
+            verifyUtf8 = false;
+            decodingErrors_ = true;
+        }
+        if (streaming_) {
+            carry = holdBackCR(chunk);
+            emit chunkLoaded(splitter.split(chunk, true), false);
+        }
+        else {
+            text += chunk;
+        }
+    }
+    truncated_ |= decompressor.hasError();  // damaged or cut short
+
+    QString last = carry + decoder.decode({});
+    if (verifyUtf8 && decoder.hasError())
+        decodingErrors_ = true;
+    if (streaming_) {
+        last = splitter.split(last);
+        softBreaks_ = splitter.softBreaks();
+        emit chunkLoaded(last, true);
+        return;
+    }
+
+    text = splitter.split(text + last);
+    softBreaks_ = splitter.softBreaks();
+    if (!makeDocument(text))
+        return;
     emit completed(text, fname_, charset_, enforced, reload_, restoreCursor_, posInLine_, forceUneditable_, multiple_);
 }
 
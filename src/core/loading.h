@@ -5,6 +5,14 @@
 
 #include <QThread>
 #include <QString>
+#include <QStringConverter>
+
+class QTextDocument;
+
+#include "decompressor.h"
+#include "largefile.h"
+#include "linediff.h"
+#include "lineindex.h"
 
 namespace Texxy {
 
@@ -20,9 +28,78 @@ class Loading : public QThread {
                      int posInLine,
                      bool forceUneditable,
                      bool multiple);
-    ~Loading() override = default;
+    ~Loading() override;
+
+    /* The decoder used for a charset that Loading has decided or was given. */
+    static QStringConverter::Encoding converterFor(const QString& charset);
 
     void setSkipNonText(bool skip) noexcept { skipNonText_ = skip; }
+    void setProgressive(bool progressive) noexcept { progressive_ = progressive; }
+
+    /* True if completed() carried only the first part of the text
+       and the rest follows through chunkLoaded(). */
+    bool isStreaming() const noexcept { return streaming_; }
+
+    /* True if a streamed text turned out not to be the UTF-8 it was taken for
+       after its first part had been sent. Valid when the last chunk arrives. */
+    bool hasDecodingErrors() const noexcept { return decodingErrors_; }
+
+    /* On reloading, the text in the editor and the revision of its document. A loaded
+       text that isn't streamed is compared with it line by line (see lineHunks()). */
+    void setBaseText(const QString& text, int revision) {
+        baseText_ = text;
+        baseRevision_ = revision;
+    }
+    int baseRevision() const noexcept { return baseRevision_; }
+
+    /* True if the loaded text differs from the base text in few enough lines to be
+       patched into the document through lineHunks(). Then there is no document
+       to take. Valid with completed(). */
+    bool hasLineDiff() const noexcept { return hasLineDiff_; }
+    const QList<LineHunk>& lineHunks() const noexcept { return lineHunks_; }
+
+    /* The size of the file when it was read. */
+    qint64 fileSize() const noexcept { return fileSize_; }
+
+    /* The fingerprint of the file as it was read (0 if unknown; see ContentHash). */
+    quint64 contentHash() const noexcept { return contentHash_; }
+
+    /* On reloading a large file, the size and fingerprint it had. If it still has them,
+       nothing is loaded, and completed() comes with an empty charset and isUnchanged(). */
+    void setKnownContent(qint64 size, quint64 hash) noexcept {
+        knownSize_ = size;
+        knownHash_ = hash;
+    }
+    bool isUnchanged() const noexcept { return unchanged_; }
+
+    /* True if the file was compressed (gzip, xz or zstd); such a text is uneditable. */
+    bool isCompressed() const noexcept { return compressed_; }
+
+    /* True if only the beginning of a compressed text was loaded because the data was
+       damaged or the text would exceed LargeFile::kSizeThreshold. Valid with the whole text. */
+    bool isTruncated() const noexcept { return truncated_; }
+
+    /* The line index of the loaded text (null for wide encodings and split lines). */
+    QSharedPointer<LineIndex> lineIndex() const { return lineIndex_; }
+
+    /* The most common line end of the file and whether it had other ones too. They
+       are counted by the byte scan or, in wide encodings, in the decoded text (only
+       in the first part of a streamed text). Valid with completed(). */
+    LineEnd lineEnd() const noexcept { return lineEnd_; }
+    bool hasMixedLineEnds() const noexcept { return mixedLineEnds_; }
+
+    /* The blocks that follow the soft breaks of split lines (see LineSplitter).
+       Valid when the whole text has been sent. */
+    const QList<int>& softBreaks() const noexcept { return softBreaks_; }
+
+    /* A long text that isn't streamed is also put into a document with a plain
+       text layout, which belongs to the GUI thread. The caller takes ownership
+       (null if there is no document or it was taken). Valid with completed(). */
+    QTextDocument* takeDocument() {
+        QTextDocument* doc = document_;
+        document_ = nullptr;
+        return doc;
+    }
 
    signals:
     void completed(const QString& text = QString(),
@@ -33,12 +110,26 @@ class Loading : public QThread {
                    int restoreCursor = 0,
                    int posInLine = 0,
                    bool uneditable = false,
-                   bool multiple = false);
+                   bool multiple = false,
+                   const QSharedPointer<LargeFile>& largeFile = QSharedPointer<LargeFile>());
+    void chunkLoaded(const QString& text, bool last);
 
    protected:
     void run() final override;
 
    private:
+    void loadCompressed(const uchar* begin, const uchar* end, Decompressor::Format format);
+    void setLineEnds(const LineScan& scan) noexcept {
+        lineEnd_ = scan.dominantLineEnd();
+        mixedLineEnds_ = scan.hasMixedLineEnds();
+    }
+    bool makeDocument(const QString& text);  // false if interrupted
+
+    static constexpr qint64 kStreamThreshold = 4LL * 1024 * 1024;  // smaller texts are sent at once
+    static constexpr qint64 kFirstPart = 256 * 1024;               // bytes decoded before the first page is shown
+    static constexpr qsizetype kDocumentThreshold = 1024 * 1024;    // characters of a text sent as a document
+    static constexpr int kMaxDiffEdits = 1000;                      // more changed lines are reloaded as a whole
+
     QString fname_;
     QString charset_;
     bool reload_;           // is this a reload
@@ -47,6 +138,25 @@ class Loading : public QThread {
     bool forceUneditable_;  // force document uneditable
     bool multiple_;         // multiple files to load
     bool skipNonText_;      // skip non text files
+    bool progressive_;      // may stream the text after its first part
+    bool streaming_;        // the text is being streamed
+    bool decodingErrors_;   // a streamed UTF-8 text had invalid sequences
+    bool compressed_;       // the file is decompressed while loading
+    bool truncated_;        // a compressed text was cut short
+    bool unchanged_;        // a reloaded large file has its known contents
+    bool mixedLineEnds_;    // the file has more than one kind of line ends
+    LineEnd lineEnd_;
+    qint64 fileSize_;
+    quint64 contentHash_;
+    qint64 knownSize_;
+    quint64 knownHash_;
+    QSharedPointer<LineIndex> lineIndex_;
+    QList<int> softBreaks_;
+    QString baseText_;
+    int baseRevision_;
+    bool hasLineDiff_;
+    QList<LineHunk> lineHunks_;
+    QTextDocument* document_;  // the text as a document, if it is long
 };
 
 }  // namespace Texxy
@@ -10,12 +10,12 @@
 
 #include "filedialog.h"
 #include "messagebox.h"
+#include "saving.h"
 #include "singleton.h"
 #include "ui/tabpage.h"
 #include "textedit/textedit.h"
 
 #include <QApplication>
-#include <QBuffer>
 #include <QDir>
 #include <QFile>
 #include <QFileDialog>
@@ -25,39 +25,55 @@
 #include <QListWidgetItem>
 #include <QMessageBox>
 #include <QPlainTextEdit>
-#include <QSaveFile>
 #include <QTextBlock>
 #include <QTextCursor>
 #include <QTextDocument>
-#include <QTextDocumentWriter>
 #include <QTimer>
 #include <QToolTip>
-#include <QStringEncoder>
 
 #include <algorithm>
+#include <utility>
 
 namespace Texxy {
 
 namespace {
 
-int trailingSpaces(const QString& str) {
-    int i = 0;
-    while (i < str.length()) {
-        if (!str.at(str.length() - 1 - i).isSpace())
-            return i;
-        ++i;
+struct SpaceRange {
+    int from;
+    int to;
+};
+
+/* Finds the trailing spaces to be removed from the lines of a document in one pass
+   over its raw text. Markdown and Fountain keep two spaces (a line break), and
+   LaTeX keeps one. The spaces before a soft break are inside a line of the file. */
+QList<SpaceRange> trailingSpaceRanges(QStringView text,
+                                      const QList<int>& softBreaks,
+                                      bool doubleSpace,
+                                      bool singleSpace) {
+    QList<SpaceRange> ranges;
+    auto softBreak = softBreaks.cbegin();
+    qsizetype start = 0;
+    while (start <= text.size()) {
+        qsizetype end = text.indexOf(QChar::ParagraphSeparator, start);
+        if (end < 0)
+            end = text.size();
+        while (softBreak != softBreaks.cend() && *softBreak < end)
+            ++softBreak;
+        if (softBreak == softBreaks.cend() || *softBreak != end) {
+            qsizetype count = 0;
+            while (end - count > start && text.at(end - count - 1).isSpace())
+                ++count;
+            qsizetype removed = count;
+            if (doubleSpace)
+                removed = count == 2 ? 0 : std::max<qsizetype>(1, count - 2);
+            else if (singleSpace)
+                removed = count > 1 ? count - 1 : 0;
+            if (count > 0 && removed > 0)
+                ranges.append({static_cast<int>(end - removed), static_cast<int>(end)});
+        }
+        start = end + 1;
     }
-    return i;
-}
-
-QStringEncoder getEncoder(const QString& encoding) {
-    if (encoding.compare("UTF-16", Qt::CaseInsensitive) == 0)
-        return QStringEncoder(QStringConverter::Utf16, QStringConverter::Flag::WriteBom);
-    if (encoding.compare("UTF-8", Qt::CaseInsensitive) == 0)
-        return QStringEncoder(QStringConverter::Utf8);
-    if (encoding.compare("UTF-32", Qt::CaseInsensitive) == 0)
-        return QStringEncoder(QStringConverter::Utf32, QStringConverter::Flag::WriteBom);
-    return QStringEncoder(QStringConverter::Latin1);
+    return ranges;
 }
 
 }  // namespace
@@ -68,34 +84,22 @@ void TexxyWindow::removeTrailingSpacesIfNeeded(TextEdit* textEdit) {
     if (lang == QLatin1String("diff") || textEdit->getFileName().endsWith("/locale.gen"))
         return;
 
-    makeBusy();
+    QTextDocument* doc = textEdit->document();
+    const QList<SpaceRange> ranges =
+        trailingSpaceRanges(doc->toRawText(), textEdit->softBreakPositions(),
+                            lang == QLatin1String("markdown") || lang == QLatin1String("fountain"),
+                            lang == QLatin1String("LaTeX"));
+    if (ranges.isEmpty())
+        return;
 
-    QTextBlock block = textEdit->document()->firstBlock();
-    QTextCursor cursor = textEdit->textCursor();
+    makeBusy();
+    // one edit, from the end so that the positions stay valid; the layout is updated once
+    QTextCursor cursor(doc);
     cursor.beginEditBlock();
-
-    const bool doubleSpace = (lang == QLatin1String("markdown") || lang == QLatin1String("fountain"));
-    const bool singleSpace = (lang == QLatin1String("LaTeX"));
-
-    while (block.isValid()) {
-        const int count = trailingSpaces(block.text());
-        if (count > 0) {
-            cursor.setPosition(block.position() + block.text().length());
-            if (doubleSpace) {
-                if (count != 2)
-                    cursor.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor,
-                                        std::max(1, count - 2));
-            }
-            else if (singleSpace) {
-                if (count > 1)
-                    cursor.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor, count - 1);
-            }
-            else {
-                cursor.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor, count);
-            }
-            cursor.removeSelectedText();
-        }
-        block = block.next();
+    for (auto it = ranges.crbegin(); it != ranges.crend(); ++it) {
+        cursor.setPosition(it->from);
+        cursor.setPosition(it->to, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
     }
     cursor.endEditBlock();
     unbusy();
@@ -132,38 +136,17 @@ bool TexxyWindow::showSaveDialogAndSetFileName(QString& fname, const QString& fi
     return true;
 }
 
-bool TexxyWindow::writeFileWithEncoding(const QString& fname, TextEdit* textEdit, bool& MSWinLineEnd) {
-    const QString encoding = checkToEncoding();
+/* The line ends of a file are kept; the user is asked only about those of a new
+   or mixed text. */
+bool TexxyWindow::chooseLineEnds(TextEdit* textEdit, const QString& encoding, LineEnd& lineEnd) {
     if (encoding == QLatin1String("UTF-16")) {
-        MSWinLineEnd = true;
-        return writeUtf16File(fname, textEdit);
+        lineEnd = LineEnd::CrLf;
+        return true;
+    }
+    if (!textEdit->getFileName().isEmpty() && !textEdit->hasMixedLineEnds()) {
+        lineEnd = textEdit->getLineEnd();
+        return true;
     }
-
-    return promptAndWriteWithChosenEOL(fname, textEdit, encoding, MSWinLineEnd);
-}
-
-bool TexxyWindow::writeUtf16File(const QString& fname, TextEdit* textEdit) {
-    QStringEncoder encoder = getEncoder(QStringLiteral("UTF-16"));
-
-    QString contents = textEdit->document()->toPlainText();
-    contents.replace(QLatin1Char('\n'), QLatin1String("\r\n"));
-
-    const QByteArray bytes = encoder.encode(contents);
-
-    QSaveFile file(fname);
-    if (!file.open(QIODevice::WriteOnly))
-        return false;
-    const qint64 written = file.write(bytes);
-    if (written != bytes.size())
-        return false;
-    return file.commit();
-}
-
-bool TexxyWindow::promptAndWriteWithChosenEOL(const QString& fname,
-                                              TextEdit* textEdit,
-                                              const QString& encoding,
-                                              bool& MSWinLineEnd) {
-    QStringEncoder encoder = getEncoder(encoding);
 
     updateShortcuts(true);
 
@@ -178,7 +161,7 @@ bool TexxyWindow::promptAndWriteWithChosenEOL(const QString& fname,
     msgBox.setText(QStringLiteral("<center>%1</center>").arg(tr("Do you want to use <b>MS Windows</b> end-of-lines?")));
     msgBox.setInformativeText(
         QStringLiteral("<center><i>%1</i></center>").arg(tr("This may be good for readability under MS Windows")));
-    msgBox.setDefaultButton(QMessageBox::No);
+    msgBox.setDefaultButton(textEdit->getLineEnd() == LineEnd::CrLf ? QMessageBox::Yes : QMessageBox::No);
     msgBox.setWindowModality(Qt::WindowModal);
 
     const int result = msgBox.exec();
@@ -186,24 +169,8 @@ bool TexxyWindow::promptAndWriteWithChosenEOL(const QString& fname,
     if (result == QMessageBox::Cancel)
         return false;
 
-    QString contents = textEdit->document()->toPlainText();
-    if (result == QMessageBox::Yes) {
-        MSWinLineEnd = true;
-        contents.replace(QLatin1Char('\n'), QLatin1String("\r\n"));
-    }
-    else {
-        MSWinLineEnd = false;
-    }
-
-    const QByteArray bytes = encoder.encode(contents);
-
-    QSaveFile file(fname);
-    if (!file.open(QIODevice::WriteOnly))
-        return false;
-    const qint64 written = file.write(bytes);
-    if (written != bytes.size())
-        return false;
-    return file.commit();
+    lineEnd = result == QMessageBox::Yes ? LineEnd::CrLf : LineEnd::Lf;
+    return true;
 }
 
 void TexxyWindow::handleSaveFailure(const QString& fname) {
@@ -312,75 +279,238 @@ bool TexxyWindow::saveFile(bool keepSyntax,
         cursor.endEditBlock();
     }
 
-    bool success = false;
-    bool MSWinLineEnd = false;
-
+    LineEnd lineEnd = textEdit->getLineEnd();
     if (explicitSaveCodec) {
-        success = writeFileWithEncoding(fname, textEdit, MSWinLineEnd);
+        if (!chooseLineEnds(textEdit, checkToEncoding(), lineEnd)) {
+            handleSaveFailure(fname);
+            return false;
+        }
     }
     else {
         encodingToCheck(QStringLiteral("UTF-8"));
+    }
 
-        QByteArray serialized;
-        QBuffer buffer(&serialized);
-        success = buffer.open(QIODevice::WriteOnly);
-        if (success) {
-            // Write via QBuffer so QTextDocumentWriter never closes the QSaveFile directly
-            QTextDocumentWriter writer(&buffer, "plaintext");
-            success = writer.write(textEdit->document());
-            buffer.close();
-        }
+    // a save from the menu or toolbar is finished in the background; the others
+    // (like saving before closing) need to know whether the file is written
+    startSaving(textEdit, fname, checkToEncoding(), lineEnd, keepSyntax, false);
+    if (snd == ui->actionSave || explicitSaveAs || explicitSaveCodec)
+        return true;
+    return waitForSaving(textEdit);
+}
 
-        if (success) {
-            QSaveFile file(fname);
-            if (file.open(QIODevice::WriteOnly)) {
-                success = (file.write(serialized) == serialized.size());
-                if (success)
-                    success = file.commit();
-            }
-            else {
-                success = false;
-            }
+/* Snapshots the document and writes it in a thread; the text can be edited meanwhile.
+   The raw text is a single copy of the document's characters. A file that is still
+   being written is written again after that, so the older snapshot isn't written last. */
+void TexxyWindow::startSaving(TextEdit* textEdit,
+                              const QString& fname,
+                              const QString& encoding,
+                              LineEnd lineEnd,
+                              bool keepSyntax,
+                              bool saveAll,
+                              bool showWarning) {
+    auto* saving =
+        new Saving(fname, textEdit->document()->toRawText(), textEdit->softBreakPositions(), encoding, lineEnd);
+    connect(saving, &QThread::finished, this, [this, guard = QPointer<Saving>(saving)] {
+        if (guard)
+            finishSaving(guard);
+    });
+    const bool waits = std::any_of(saveJobs_.cbegin(), saveJobs_.cend(),
+                                   [&fname](const SaveJob& job) { return job.saving->fileName() == fname; });
+    saveJobs_.append({saving, textEdit, textEdit->document()->revision(), keepSyntax, saveAll, showWarning, false});
+    if (!waits)
+        queueSaving(saveJobs_.last());  // otherwise, finishSaving() queues it
+}
+
+/* Gives the saving of "job" to the saver pool. The files of Save All are written
+   a few at a time; a single file at once. */
+void TexxyWindow::queueSaving(SaveJob& job) {
+    if (job.queued)
+        return;
+    job.queued = true;
+    LoaderPool* saverPool = static_cast<TexxyApplication*>(qApp)->getSaverPool();
+    saverPool->enqueue(job.saving, this, !job.saveAll);
+    if (!job.saveAll)
+        saverPool->startNow(job.saving);
+}
+
+/* Waits for the savings of a document (or of all documents) and updates their pages,
+   together with the earlier savings of the same files. Returns false if the last file
+   couldn't be written. Only closing needs this; other saves are finished in the background. */
+bool TexxyWindow::waitForSaving(TextEdit* textEdit) {
+    QStringList files;
+    for (const SaveJob& job : std::as_const(saveJobs_)) {
+        if (textEdit == nullptr || job.textEdit == textEdit)
+            files << job.saving->fileName();
+    }
+    LoaderPool* saverPool = static_cast<TexxyApplication*>(qApp)->getSaverPool();
+    bool saved = true;
+    const QList<SaveJob> jobs = saveJobs_;
+    for (const SaveJob& job : jobs) {  // in the order of their snapshots
+        if (!files.contains(job.saving->fileName()))
+            continue;
+        const auto it = std::find_if(saveJobs_.begin(), saveJobs_.end(),
+                                     [&job](const SaveJob& j) { return j.saving == job.saving; });
+        if (it == saveJobs_.end())
+            continue;  // finished meanwhile
+        queueSaving(*it);
+        saverPool->startNow(job.saving);
+        job.saving->wait();
+        saved = finishSaving(job.saving);
+    }
+    return saved;
+}
+
+/* Updates the page of a written document. Returns false if the file couldn't be written.
+   (The Saving object is deleted by the saver pool.) */
+bool TexxyWindow::finishSaving(Saving* saving) {
+    const auto it = std::find_if(saveJobs_.begin(), saveJobs_.end(),
+                                 [saving](const SaveJob& job) { return job.saving == saving; });
+    if (it == saveJobs_.end())
+        return saving->isSaved();  // already finished
+    const SaveJob job = *it;
+    saveJobs_.erase(it);
+    // the next snapshot of the file can be written now
+    const auto next = std::find_if(saveJobs_.begin(), saveJobs_.end(), [saving](const SaveJob& j) {
+        return j.saving->fileName() == saving->fileName();
+    });
+    if (next != saveJobs_.end())
+        queueSaving(*next);
+    const bool lastOfSaveAll =
+        job.saveAll && std::none_of(saveJobs_.cbegin(), saveJobs_.cend(), [](const SaveJob& j) { return j.saveAll; });
+
+    const QString fname = saving->fileName();
+    if (!saving->isSaved()) {
+        if (!job.saveAll) {
+            handleSaveFailure(fname);
+            return false;
         }
+        if (job.showWarning)
+            unsavedAllFiles_ << fname;
     }
 
-    if (!success) {
-        handleSaveFailure(fname);
-        return false;
+    TextEdit* textEdit = job.textEdit;
+    TabPage* tabPage = nullptr;
+    for (int i = 0; textEdit && saving->isSaved() && i < ui->tabWidget->count(); ++i) {
+        auto* page = qobject_cast<TabPage*>(ui->tabWidget->widget(i));
+        if (page && page->textEdit() == textEdit) {
+            tabPage = page;
+            break;
+        }
+    }
+    if (tabPage == nullptr) {  // not saved, or the tab is closed or moved to another window
+        if (lastOfSaveAll)
+            finishSavingAll();
+        return saving->isSaved();
     }
 
-    const QFileInfo fi(fname);
+    // what is typed during the save isn't in the file
+    const bool modified = textEdit->document()->revision() != job.revision;
+    const bool current = tabPage == ui->tabWidget->currentWidget();
+    // the title of the current page isn't changed by another one, and Save All updates its pages together
+    inactiveTabModified_ = job.saveAll || !current;
+    textEdit->document()->setModified(modified);
+    inactiveTabModified_ = false;
 
-    textEdit->document()->setModified(false);
+    textEdit->setLineIndex(QSharedPointer<LineIndex>());  // describes the loaded file
     textEdit->setFileName(fname);
-    textEdit->setSize(fi.size());
-    textEdit->setLastModified(fi.lastModified());
-    ui->actionReload->setDisabled(false);
-    setTitle(fname);
+    textEdit->setSize(saving->fileSize());
+    textEdit->setLastModified(saving->lastModified());
+    textEdit->setContentHash(saving->contentHash());
+    textEdit->setLineEnd(saving->lineEnd());
+    textEdit->setMixedLineEnds(false);
+    FileWatcher* watcher = static_cast<TexxyApplication*>(qApp)->getFileWatcher();
+    watcher->watch(fname, textEdit);
+    watcher->noteContent(fname, saving->lastModified(), saving->fileSize(), saving->contentHash());
+    static_cast<TexxyApplication*>(qApp)->getJournal()->track(textEdit->document(), fname, saving->encoding(),
+                                                               saving->contentHash());
+
+    if (job.saveAll) {
+        savedAllPages_ << tabPage;
+        if (lastOfSaveAll)
+            finishSavingAll();
+        return true;
+    }
+
+    if (current) {
+        ui->actionReload->setDisabled(false);
+        setTitle(fname);
+        if (modified)
+            asterisk(true);
+    }
+    else if (!modified) {
+        setTitle(fname, ui->tabWidget->indexOf(tabPage));
+    }
+    updateSavedPage(tabPage, saving->encoding(), job.keepSyntax);
+    return true;
+}
+
+/* Updates the pages of Save All together when all of their files are written,
+   and tells about the files that couldn't be written in a single bar. */
+void TexxyWindow::finishSavingAll() {
+    const QList<QPointer<TabPage>> pages = std::exchange(savedAllPages_, {});
+    const bool saveUnmodified = static_cast<TexxyApplication*>(qApp)->getConfig().getSaveUnmodified();
+    for (const QPointer<TabPage>& tabPage : pages) {
+        const int index = tabPage ? ui->tabWidget->indexOf(tabPage) : -1;
+        if (index == -1)
+            continue;  // closed or moved to another window
+        const QString fname = tabPage->textEdit()->getFileName();
+        const bool modified = tabPage->textEdit()->document()->isModified();
+        if (index == ui->tabWidget->currentIndex()) {
+            ui->actionReload->setDisabled(false);
+            setTitle(fname);
+            if (modified)
+                asterisk(true);
+            if (!saveUnmodified)
+                enableSaving(modified);
+        }
+        else if (!modified) {
+            setTitle(fname, index);
+        }
+        updateSavedInactivePage(tabPage);
+    }
+
+    if (unsavedAllFiles_.isEmpty())
+        return;
+    constexpr int kShownNames = 3;
+    QStringList names;
+    for (int i = 0; i < std::min<int>(kShownNames, unsavedAllFiles_.size()); ++i)
+        names << unsavedAllFiles_.at(i).section(QLatin1Char('/'), -1).toHtmlEscaped();
+    QString shown = names.join(QStringLiteral(", "));
+    if (unsavedAllFiles_.size() > kShownNames)
+        shown = tr("%1 and %n more", "", unsavedAllFiles_.size() - kShownNames).arg(shown);
+    unsavedAllFiles_.clear();
+    showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>\n<center><i>%2</i></center>")
+                       .arg(tr("Some files cannot be saved!"), shown),
+                   15);
+}
+
+void TexxyWindow::updateSavedPage(TabPage* tabPage, const QString& encoding, bool keepSyntax) {
+    TextEdit* textEdit = tabPage->textEdit();
+    const QString fname = textEdit->getFileName();
+    const int pageIndex = ui->tabWidget->indexOf(tabPage);
 
     if (sidePane_)
         sidePane_->revealFile(fname);
 
-    QString tipDir = fname.contains(QLatin1Char('/')) ? fname.section(QLatin1Char('/'), 0, -2) : fi.absolutePath();
+    QString tipDir = fname.contains(QLatin1Char('/')) ? fname.section(QLatin1Char('/'), 0, -2)
+                                                       : QFileInfo(fname).absolutePath();
     if (!tipDir.endsWith(QLatin1Char('/')))
         tipDir += QLatin1Char('/');
     const QFontMetrics fm(QToolTip::font());
     const QString elided =
         QStringLiteral("<p style='white-space:pre'>%1</p>")
             .arg(fm.elidedText(tipDir, Qt::ElideMiddle, 200 * fm.horizontalAdvance(QLatin1Char(' '))));
-    const int pageIndex = ui->tabWidget->indexOf(curPage);
     ui->tabWidget->setTabToolTip(pageIndex, elided);
     if (!sideItems_.isEmpty()) {
-        if (QListWidgetItem* wi = sideItems_.key(curPage))
+        if (QListWidgetItem* wi = sideItems_.key(tabPage))
             wi->setToolTip(elided);
     }
 
     lastFile_ = fname;
     addRecentFile(lastFile_);
 
-    const QString targetEncoding = checkToEncoding();
-    if (textEdit->getEncoding() != targetEncoding) {
-        textEdit->setEncoding(targetEncoding);
+    if (textEdit->getEncoding() != encoding) {
+        textEdit->setEncoding(encoding);
 
         if (ui->statusBar->isVisible()) {
             if (auto* currentPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget())) {
@@ -394,7 +524,7 @@ bool TexxyWindow::saveFile(bool keepSyntax,
                         const int valueOffset = encodingToken.size() + 9;  // size of ":</b> <i>"
                         if (encodingIndex >= 0 && linesIndex > encodingIndex)
                             labelText.replace(encodingIndex + valueOffset, linesIndex - encodingIndex - valueOffset,
-                                              targetEncoding);
+                                              encoding);
                         statusLabel->setText(labelText);
                     }
                 }
@@ -406,10 +536,8 @@ bool TexxyWindow::saveFile(bool keepSyntax,
         reloadSyntaxHighlighter(textEdit);
     }
 
-    if (textEdit->isReadOnly() && !alreadyOpen(curPage))
+    if (textEdit->isReadOnly() && !alreadyOpen(tabPage))
         QTimer::singleShot(0, this, &TexxyWindow::makeEditable);
-
-    return true;
 }
 
 void TexxyWindow::saveAllFiles(bool showWarning) {
@@ -420,8 +548,9 @@ void TexxyWindow::saveAllFiles(bool showWarning) {
     Config& config = static_cast<TexxyApplication*>(qApp)->getConfig();
     const bool removeTrailing = config.getRemoveTrailingSpaces();
     const bool appendEmpty = config.getAppendEmptyLine();
+    FileWatcher* watcher = static_cast<TexxyApplication*>(qApp)->getFileWatcher();
 
-    bool error = false;
+    // the documents are snapshotted here and written in parallel (see finishSavingAll)
     const int n = ui->tabWidget->count();
 
     for (int i = 0; i < n; ++i) {
@@ -432,43 +561,20 @@ void TexxyWindow::saveAllFiles(bool showWarning) {
         if (te->isUneditable() || !doc->isModified())
             continue;
 
+        // a file that is still being written is saved next time
+        if (std::any_of(saveJobs_.cbegin(), saveJobs_.cend(), [te](const SaveJob& job) { return job.textEdit == te; }))
+            continue;
+
+        // the file system is accessed only if the file watcher doesn't know the file
         const QString fname = te->getFileName();
-        if (fname.isEmpty() || !QFile::exists(fname))
+        if (fname.isEmpty())
+            continue;
+        const FileWatcher::State state = watcher->state(fname);
+        if (state.known ? !state.exists : !QFile::exists(fname))
             continue;
 
-        if (removeTrailing && te->getProg() != QLatin1String("diff") &&
-            QFileInfo(fname).fileName() != QLatin1String("locale.gen")) {
-            makeBusy();
-            const QString prog = te->getProg();
-            const bool doubleSpace = (prog == QLatin1String("markdown") || prog == QLatin1String("fountain"));
-            const bool singleSpace = (prog == QLatin1String("LaTeX"));
-
-            QTextBlock block = doc->firstBlock();
-            QTextCursor cur(doc);
-            cur.beginEditBlock();
-            while (block.isValid()) {
-                const QString bt = block.text();
-                if (const int num = trailingSpaces(bt)) {
-                    cur.setPosition(block.position() + bt.size());
-                    if (doubleSpace) {
-                        if (num != 2)
-                            cur.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor,
-                                             std::max(1, num - 2));
-                    }
-                    else if (singleSpace) {
-                        if (num > 1)
-                            cur.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor, num - 1);
-                    }
-                    else {
-                        cur.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor, num);
-                    }
-                    cur.removeSelectedText();
-                }
-                block = block.next();
-            }
-            cur.endEditBlock();
-            unbusy();
-        }
+        if (removeTrailing)
+            removeTrailingSpacesIfNeeded(te);
 
         if (appendEmpty && !doc->lastBlock().text().isEmpty()) {
             QTextCursor c(doc);
@@ -478,92 +584,78 @@ void TexxyWindow::saveAllFiles(bool showWarning) {
             c.endEditBlock();
         }
 
-        QSaveFile file(fname);
-        bool saved = false;
-        if (file.open(QIODevice::WriteOnly)) {
-            QTextDocumentWriter writer(&file, "plaintext");
-            saved = writer.write(doc);
-            if (saved)
-                saved = file.commit();
+        startSaving(te, fname, QStringLiteral("UTF-8"), te->getLineEnd(), true, true, showWarning);
+    }
+}
+
+/* Updates a page that was saved by saveAllFiles(), which may not be the current one. */
+void TexxyWindow::updateSavedInactivePage(TabPage* tabPage) {
+    TextEdit* textEdit = tabPage->textEdit();
+    QTextDocument* doc = textEdit->document();
+    Config& config = static_cast<TexxyApplication*>(qApp)->getConfig();
+    inactiveTabModified_ = tabPage != ui->tabWidget->currentWidget();
+
+    addRecentFile(textEdit->getFileName());
+
+    const QString prevLang = textEdit->getProg();
+    setProgLang(textEdit);
+    const QString newLang = textEdit->getProg();
+
+    if (prevLang != newLang) {
+        if (config.getShowLangSelector() && config.getSyntaxByDefault()) {
+            if (textEdit->getLang() == newLang)
+                textEdit->setLang(QString());
+            if (!inactiveTabModified_)
+                updateLangBtn(textEdit);
         }
 
-        if (saved) {
-            inactiveTabModified_ = (i != currentIndex);
-            doc->setModified(false);
-
-            const QFileInfo fInfo(fname);
-            te->setSize(fInfo.size());
-            te->setLastModified(fInfo.lastModified());
-            setTitle(fname, inactiveTabModified_ ? i : -1);
-            addRecentFile(fname);
-
-            const QString prevLang = te->getProg();
-            setProgLang(te);
-            const QString newLang = te->getProg();
-
-            if (prevLang != newLang) {
-                if (config.getShowLangSelector() && config.getSyntaxByDefault()) {
-                    if (te->getLang() == newLang)
-                        te->setLang(QString());
-                    if (!inactiveTabModified_)
-                        updateLangBtn(te);
-                }
+        if (!inactiveTabModified_ && ui->statusBar->isVisible() && textEdit->getWordNumber() != -1)
+            disconnect(doc, &QTextDocument::contentsChange, this, &TexxyWindow::updateWordInfo);
 
-                if (!inactiveTabModified_ && ui->statusBar->isVisible() && te->getWordNumber() != -1)
-                    disconnect(doc, &QTextDocument::contentsChange, this, &TexxyWindow::updateWordInfo);
+        if (textEdit->getLang().isEmpty()) {
+            syntaxHighlighting(textEdit, false);
+            if (ui->actionSyntax->isChecked())
+                syntaxHighlighting(textEdit);
+        }
 
-                if (te->getLang().isEmpty()) {
-                    syntaxHighlighting(te, false);
-                    if (ui->actionSyntax->isChecked())
-                        syntaxHighlighting(te);
+        if (!inactiveTabModified_ && ui->statusBar->isVisible()) {
+            QLabel* statusLabel = ui->statusBar->findChild<QLabel*>("statusLabel");
+            QString str = statusLabel->text();
+            const QString syntaxKey = tr("Syntax");
+            int iSyntax = str.indexOf(syntaxKey);
+
+            if (iSyntax == -1) {
+                const QString linesTag = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Lines"));
+                const int j = str.indexOf(linesTag);
+                const QString insert =
+                    QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1:</b> <i>%2</i>").arg(tr("Syntax"), newLang);
+                if (j >= 0)
+                    str.insert(j, insert);
+            }
+            else {
+                if (newLang == QLatin1String("url")) {
+                    const QString syntaxTag = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Syntax"));
+                    const QString linesTag = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Lines"));
+                    const int j = str.indexOf(syntaxTag);
+                    const int k = str.indexOf(linesTag);
+                    if (j >= 0 && k > j)
+                        str.remove(j, k - j);
                 }
-
-                if (!inactiveTabModified_ && ui->statusBar->isVisible()) {
-                    QLabel* statusLabel = ui->statusBar->findChild<QLabel*>("statusLabel");
-                    QString str = statusLabel->text();
-                    const QString syntaxKey = tr("Syntax");
-                    int iSyntax = str.indexOf(syntaxKey);
-
-                    if (iSyntax == -1) {
-                        const QString linesTag = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Lines"));
-                        const int j = str.indexOf(linesTag);
-                        const QString insert =
-                            QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1:</b> <i>%2</i>").arg(tr("Syntax"), newLang);
-                        if (j >= 0)
-                            str.insert(j, insert);
-                    }
-                    else {
-                        if (newLang == QLatin1String("url")) {
-                            const QString syntaxTag = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Syntax"));
-                            const QString linesTag = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Lines"));
-                            const int j = str.indexOf(syntaxTag);
-                            const int k = str.indexOf(linesTag);
-                            if (j >= 0 && k > j)
-                                str.remove(j, k - j);
-                        }
-                        else {
-                            const QString linesEnd = QStringLiteral("</i>&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Lines"));
-                            const int j = str.indexOf(linesEnd);
-                            const int offset = syntaxKey.size() + 9;
-                            if (j > iSyntax + offset)
-                                str.replace(iSyntax + offset, j - iSyntax - offset, newLang);
-                        }
-                    }
-                    statusLabel->setText(str);
-                    if (te->getWordNumber() != -1)
-                        connect(doc, &QTextDocument::contentsChange, this, &TexxyWindow::updateWordInfo);
+                else {
+                    const QString linesEnd = QStringLiteral("</i>&nbsp;&nbsp;&nbsp;<b>%1").arg(tr("Lines"));
+                    const int j = str.indexOf(linesEnd);
+                    const int offset = syntaxKey.size() + 9;
+                    if (j > iSyntax + offset)
+                        str.replace(iSyntax + offset, j - iSyntax - offset, newLang);
                 }
             }
-
-            inactiveTabModified_ = false;
-        }
-        else {
-            error = true;
+            statusLabel->setText(str);
+            if (textEdit->getWordNumber() != -1)
+                connect(doc, &QTextDocument::contentsChange, this, &TexxyWindow::updateWordInfo);
         }
     }
 
-    if (showWarning && error)
-        showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>").arg(tr("Some files cannot be saved!")));
+    inactiveTabModified_ = false;
 }
 
 }  // namespace Texxy
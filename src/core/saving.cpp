@@ -0,0 +1,53 @@
+// src/core/saving.cpp
+
+#include "saving.h"
+#include "textwriter.h"
+
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringEncoder>
+
+namespace Texxy {
+
+Saving::Saving(const QString& fname,
+               const QString& text,
+               const QList<int>& softBreaks,
+               const QString& encoding,
+               LineEnd lineEnd)
+    : fname_(fname),
+      text_(text),
+      softBreaks_(softBreaks),
+      encoding_(encoding),
+      lineEnd_(lineEnd),
+      saved_(false),
+      fileSize_(0),
+      contentHash_(0) {}
+
+QStringEncoder Saving::encoderFor(const QString& encoding) {
+    if (encoding.compare("UTF-16", Qt::CaseInsensitive) == 0)
+        return QStringEncoder(QStringConverter::Utf16, QStringConverter::Flag::WriteBom);
+    if (encoding.compare("UTF-8", Qt::CaseInsensitive) == 0)
+        return QStringEncoder(QStringConverter::Utf8);
+    if (encoding.compare("UTF-32", Qt::CaseInsensitive) == 0)
+        return QStringEncoder(QStringConverter::Utf32, QStringConverter::Flag::WriteBom);
+    return QStringEncoder(QStringConverter::Latin1);
+}
+
+void Saving::run() {
+    QStringEncoder encoder = encoderFor(encoding_);
+    QSaveFile file(fname_);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    TextWriter writer(&file, encoder);
+    if (!writer.writeDocument(text_, softBreaks_, lineEnd_) || !writer.flush() || !file.commit())
+        return;
+    text_.clear();  // not needed anymore
+
+    saved_ = true;
+    contentHash_ = writer.contentHash();
+    const QFileInfo info(fname_);
+    fileSize_ = info.size();
+    lastModified_ = info.lastModified();
+}
+
+}  // namespace Texxy
@@ -0,0 +1,62 @@
+// src/core/saving.h
+
+#ifndef SAVING_H
+#define SAVING_H
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include <QStringEncoder>
+#include <QThread>
+
+#include "textscan.h"
+
+namespace Texxy {
+
+/* Writes a snapshot of a document to a file in a thread of its own, so that a
+   slow file system cannot freeze the GUI. "text" is the raw text of the document
+   (with U+2029 between its blocks), and "softBreaks" are the positions of the
+   separators that aren't line ends of the file (see TextEdit::softBreakPositions()).
+   The results are valid after finished(). */
+class Saving : public QThread {
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(Saving)
+
+   public:
+    Saving(const QString& fname,
+           const QString& text,
+           const QList<int>& softBreaks,
+           const QString& encoding,
+           LineEnd lineEnd);
+
+    /* The encoder of a charset in which files are saved. */
+    static QStringEncoder encoderFor(const QString& encoding);
+
+    QString fileName() const { return fname_; }
+    QString encoding() const { return encoding_; }
+    LineEnd lineEnd() const noexcept { return lineEnd_; }
+
+    bool isSaved() const noexcept { return saved_; }
+    /* The state of the written file, found in this thread. */
+    qint64 fileSize() const noexcept { return fileSize_; }
+    QDateTime lastModified() const { return lastModified_; }
+    quint64 contentHash() const noexcept { return contentHash_; }
+
+   protected:
+    void run() final override;
+
+   private:
+    QString fname_;
+    QString text_;
+    QList<int> softBreaks_;
+    QString encoding_;
+    LineEnd lineEnd_;
+    bool saved_;
+    qint64 fileSize_;
+    QDateTime lastModified_;
+    quint64 contentHash_;
+};
+
+}  // namespace Texxy
+
+#endif  // SAVING_H
@@ -0,0 +1,611 @@
+// src/core/textscan.cpp
+/*
+  texxy/textscan.cpp
+  SSE2/AVX2 kernels with a scalar fallback; the instruction set is chosen once at runtime
+*/
+
+#include "textscan.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TXY_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TXY_ALWAYS_INLINE __attribute__((always_inline)) inline
+#define TXY_TARGET(isa) __attribute__((target(isa)))
+#define TXY_FLATTEN __attribute__((flatten))
+#else
+#define TXY_ALWAYS_INLINE inline
+#define TXY_TARGET(isa)
+#define TXY_FLATTEN
+#endif
+
+// The loops below are templates on a 64-byte classification kernel. Each instruction
+// set gets a flattened entry point with its own target attribute, so that the loop and
+// the kernel are compiled together for that target.
+
+namespace {
+
+constexpr std::int64_t kBlock = 64;
+constexpr std::int64_t kSinkSpan = 256 * 1024;  // scanned bytes that are given to a sink together
+
+inline int popcount64(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    for (; x; x &= x - 1)
+        ++n;
+    return n;
+#endif
+}
+
+inline int ctz64(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline int clz64(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & (1ULL << 63))) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// one bit per byte of a 64-byte block
+struct Masks {
+    std::uint64_t nul;
+    std::uint64_t lf;
+    std::uint64_t cr;
+};
+
+// classifies up to 64 bytes; also used for the tail of every kernel
+inline Masks classifyScalar(const unsigned char* p, std::int64_t len) noexcept {
+    Masks m{0, 0, 0};
+    for (std::int64_t i = 0; i < len; ++i) {
+        const std::uint64_t bit = 1ULL << i;
+        switch (p[i]) {
+            case 0x00:
+                m.nul |= bit;
+                break;
+            case '\n':
+                m.lf |= bit;
+                break;
+            case '\r':
+                m.cr |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+    return m;
+}
+
+struct ScalarKernel {
+    static inline Masks classify(const unsigned char* p) noexcept { return classifyScalar(p, kBlock); }
+};
+
+#ifdef TXY_X86_DISPATCH
+struct Sse2Kernel {
+    static TXY_TARGET("sse2") inline Masks classify(const unsigned char* p) noexcept {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        Masks m{0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            const int shift = 16 * i;
+            m.nul |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))))
+                     << shift;
+            m.lf |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf))))
+                    << shift;
+            m.cr |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, cr))))
+                    << shift;
+        }
+        return m;
+    }
+};
+
+struct Avx2Kernel {
+    static TXY_TARGET("avx2") inline std::uint64_t bits(__m256i lo, __m256i hi) noexcept {
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(lo))) |
+               (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(hi))) << 32);
+    }
+
+    static TXY_TARGET("avx2") inline Masks classify(const unsigned char* p) noexcept {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        return Masks{bits(_mm256_cmpeq_epi8(lo, zero), _mm256_cmpeq_epi8(hi, zero)),
+                     bits(_mm256_cmpeq_epi8(lo, lf), _mm256_cmpeq_epi8(hi, lf)),
+                     bits(_mm256_cmpeq_epi8(lo, cr), _mm256_cmpeq_epi8(hi, cr))};
+    }
+};
+#endif
+
+/*************************
+ ***** Line scanning *****
+ *************************/
+
+// a line starts at a CR/LF byte (or the first byte) and the cutoff is the first byte
+// at which it becomes longer than maxLine, unless a CR/LF comes before it
+//
+// lines are counted as QTextDocument counts its blocks: LF, CRLF and a lone CR end a line
+template <typename Kernel>
+inline Texxy::LineScan scanLinesWith(const unsigned char* begin,
+                                     const unsigned char* end,
+                                     std::int64_t maxLine,
+                                     std::vector<std::int64_t>* lineStarts,
+                                     std::int64_t stride,
+                                     const Texxy::ScanSink* sink) {
+    Texxy::LineScan r;
+    const std::int64_t len = end - begin;
+    std::int64_t cand = maxLine;  // the cutoff if no CR/LF comes first
+    std::int64_t lastSep = -1;    // the last CR/LF byte
+    std::int64_t ends = 0;        // line ends so far
+    std::uint64_t crCarry = 0;    // the last byte of the previous block was a CR
+    std::int64_t nextRecord = stride;
+    std::int64_t fed = 0;  // bytes given to the sink
+    if (lineStarts)
+        lineStarts->push_back(0);
+
+    for (std::int64_t base = 0; base < len; base += kBlock) {
+        const std::int64_t n = len - base < kBlock ? len - base : kBlock;
+        const Masks m = n == kBlock ? Kernel::classify(begin + base) : classifyScalar(begin + base, n);
+        const std::uint64_t sep = m.lf | m.cr;
+
+        std::uint64_t nl = sep;
+        if (maxLine >= kBlock) {
+            // lines between two CR/LFs of the same block cannot be too long
+            if (nl) {
+                if (cand < base + ctz64(nl))
+                    nl = 0;  // the cutoff comes first
+                else
+                    cand = base + 63 - clz64(nl) + maxLine;
+            }
+        }
+        else {
+            for (; nl; nl &= nl - 1) {
+                const std::int64_t q = base + ctz64(nl);
+                if (cand < q)
+                    break;
+                cand = q + maxLine;
+            }
+        }
+        const bool cut = cand < base + n;
+        const std::uint64_t kept = cut ? (1ULL << (cand - base)) - 1 : ~0ULL;  // bytes before the cutoff
+
+        // a CR ends a line unless an LF follows it
+        const std::uint64_t lf = m.lf & kept;
+        std::uint64_t lfNext = lf >> 1;
+        if (!cut && n == kBlock && base + kBlock < len && begin[base + kBlock] == '\n')
+            lfNext |= 1ULL << 63;
+        const std::uint64_t loneCr = m.cr & kept & ~lfNext;
+        const std::uint64_t lineEnds = lf | loneCr;
+        if (lineEnds) {
+            const std::uint64_t loneLf = lf & ~((m.cr << 1) | crCarry);
+            r.lfCount += popcount64(loneLf);
+            r.crlfCount += popcount64(lf) - popcount64(loneLf);
+            r.crCount += popcount64(loneCr);
+            const std::int64_t before = ends;
+            ends += popcount64(lineEnds);
+            if (lineStarts && nextRecord <= ends) {
+                std::int64_t k = before;
+                for (std::uint64_t e = lineEnds; e && nextRecord <= ends; e &= e - 1) {
+                    if (++k == nextRecord) {
+                        lineStarts->push_back(base + ctz64(e) + 1);
+                        nextRecord += stride;
+                    }
+                }
+            }
+        }
+
+        // the longest line; lines inside a block matter only while all lines are short
+        if (const std::uint64_t s = sep & kept) {
+            if (r.longestLine < kBlock) {
+                for (std::uint64_t t = s; t; t &= t - 1) {
+                    const std::int64_t q = base + ctz64(t);
+                    r.longestLine = std::max(r.longestLine, q - lastSep - 1);
+                    lastSep = q;
+                }
+            }
+            else {
+                r.longestLine = std::max(r.longestLine, base + ctz64(s) - lastSep - 1);
+                lastSep = base + 63 - clz64(s);
+            }
+        }
+
+        if (cut) {
+            // NULs after the cutoff don't matter because the rest is dropped
+            const int keep = static_cast<int>(cand - base);
+            if (m.nul & (keep == 63 ? ~0ULL : ((2ULL << keep) - 1)))
+                r.hasNull = true;
+            r.cutoff = cand;
+            break;
+        }
+        if (m.nul)
+            r.hasNull = true;
+        crCarry = m.cr >> 63;
+        if (sink && base + n - fed >= kSinkSpan) {
+            sink->consume(sink->context, begin + fed, begin + base + n);
+            fed = base + n;
+        }
+    }
+    if (sink)
+        sink->consume(sink->context, begin + fed, end);
+
+    r.longestLine = std::max(r.longestLine, (r.cutoff >= 0 ? r.cutoff : len) - lastSep - 1);
+    r.lineCount = ends + 1;
+    return r;
+}
+
+template <typename Kernel>
+inline void countZerosWith(const unsigned char* begin, const unsigned char* end, std::size_t counts[4]) noexcept {
+    // blocks start at multiples of 64, so bit i of a mask is at position i modulo 4
+    constexpr std::uint64_t kMod4 = 0x1111111111111111ULL;
+    const std::int64_t len = end - begin;
+    for (std::int64_t base = 0; base < len; base += kBlock) {
+        const std::int64_t n = len - base < kBlock ? len - base : kBlock;
+        const std::uint64_t z = n == kBlock ? Kernel::classify(begin + base).nul : classifyScalar(begin + base, n).nul;
+        if (z) {
+            for (int k = 0; k < 4; ++k)
+                counts[k] += static_cast<std::size_t>(popcount64(z & (kMod4 << k)));
+        }
+    }
+}
+
+/***************************
+ ***** UTF-8 validation *****
+ ***************************/
+
+// returns pointer advanced past consecutive ASCII bytes using wide chunks
+// uses memcpy to avoid UB on unaligned loads
+inline const unsigned char* skipAsciiScalar(const unsigned char* p, const unsigned char* end) noexcept {
+    // process 8 bytes at a time while possible
+    while (static_cast<std::size_t>(end - p) >= sizeof(std::uint64_t)) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, p, sizeof(chunk));
+        if (chunk & 0x8080808080808080ULL)
+            break;  // some byte has high bit set
+        p += sizeof(std::uint64_t);
+    }
+    // process residual bytes
+    while (p < end && (*p < 0x80))
+        ++p;
+    return p;
+}
+
+#ifdef TXY_X86_DISPATCH
+TXY_TARGET("sse2") inline const unsigned char* skipAsciiSse2(const unsigned char* p, const unsigned char* end) noexcept {
+    while (end - p >= 16) {
+        const int hi = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        if (hi)
+            return p + ctz64(static_cast<std::uint64_t>(hi));
+        p += 16;
+    }
+    return skipAsciiScalar(p, end);
+}
+#endif
+
+// strict UTF-8 validator rejecting overlongs and surrogates
+template <const unsigned char* (*SkipAscii)(const unsigned char*, const unsigned char*) noexcept>
+inline bool validateUtf8With(const unsigned char* p, const unsigned char* const end) noexcept {
+    while (p < end) {
+        p = SkipAscii(p, end);
+        if (p >= end)
+            break;
+
+        const unsigned char c = *p++;
+
+        // two-byte form: [C2..DF] [80..BF]
+        if (c >= 0xC2 && c <= 0xDF) {
+            if (p == end || (p[0] & 0xC0) != 0x80)
+                return false;
+            ++p;
+            continue;
+        }
+
+        // three-byte form: [E0..EF] [80..BF] [80..BF]
+        if (c >= 0xE0 && c <= 0xEF) {
+            if (end - p < 2)
+                return false;  // need 2 more bytes
+            const unsigned char c1 = p[0], c2 = p[1];
+            if ((c1 & 0xC0) != 0x80 || (c2 & 0xC0) != 0x80)
+                return false;  // invalid continuation
+            if (c == 0xE0 && c1 < 0xA0)
+                return false;  // overlong
+            if (c == 0xED && c1 >= 0xA0)
+                return false;  // surrogate half
+            p += 2;
+            continue;
+        }
+
+        // four-byte form: [F0..F4] [80..BF] [80..BF] [80..BF]
+        if (c >= 0xF0 && c <= 0xF4) {
+            if (end - p < 3)
+                return false;  // need 3 more bytes
+            const unsigned char c1 = p[0], c2 = p[1], c3 = p[2];
+            if ((c1 & 0xC0) != 0x80 || (c2 & 0xC0) != 0x80 || (c3 & 0xC0) != 0x80)
+                return false;  // invalid continuation
+            if (c == 0xF0 && c1 < 0x90)
+                return false;  // overlong
+            if (c == 0xF4 && c1 > 0x8F)
+                return false;  // beyond U+10FFFF
+            p += 3;
+            continue;
+        }
+
+        // anything in [80..C1] or [F5..FF] is invalid
+        return false;
+    }
+
+    return true;
+}
+
+#ifdef TXY_X86_DISPATCH
+// The lookup algorithm of Keiser and Lemire ("Validating UTF-8 In Less Than One
+// Instruction Per Byte"): three 16-entry tables, indexed by the nibbles of each byte
+// and of its predecessor, flag every error that can be seen in a pair of bytes;
+// the remaining length errors are found by looking 2 and 3 bytes back.
+namespace utf8avx2 {
+
+constexpr std::uint8_t TOO_SHORT = 1 << 0;
+constexpr std::uint8_t TOO_LONG = 1 << 1;
+constexpr std::uint8_t OVERLONG_3 = 1 << 2;
+constexpr std::uint8_t TOO_LARGE = 1 << 3;
+constexpr std::uint8_t SURROGATE = 1 << 4;
+constexpr std::uint8_t OVERLONG_2 = 1 << 5;
+constexpr std::uint8_t TOO_LARGE_1000 = 1 << 6;
+constexpr std::uint8_t OVERLONG_4 = 1 << 6;
+constexpr std::uint8_t TWO_CONTS = 1 << 7;
+constexpr std::uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE __m256i table(std::uint8_t b0, std::uint8_t b1, std::uint8_t b2, std::uint8_t b3,
+                                                   std::uint8_t b4, std::uint8_t b5, std::uint8_t b6, std::uint8_t b7,
+                                                   std::uint8_t b8, std::uint8_t b9, std::uint8_t b10, std::uint8_t b11,
+                                                   std::uint8_t b12, std::uint8_t b13, std::uint8_t b14,
+                                                   std::uint8_t b15) noexcept {
+    return _mm256_setr_epi8(static_cast<char>(b0), static_cast<char>(b1), static_cast<char>(b2), static_cast<char>(b3),
+                            static_cast<char>(b4), static_cast<char>(b5), static_cast<char>(b6), static_cast<char>(b7),
+                            static_cast<char>(b8), static_cast<char>(b9), static_cast<char>(b10),
+                            static_cast<char>(b11), static_cast<char>(b12), static_cast<char>(b13),
+                            static_cast<char>(b14), static_cast<char>(b15), static_cast<char>(b0),
+                            static_cast<char>(b1), static_cast<char>(b2), static_cast<char>(b3), static_cast<char>(b4),
+                            static_cast<char>(b5), static_cast<char>(b6), static_cast<char>(b7), static_cast<char>(b8),
+                            static_cast<char>(b9), static_cast<char>(b10), static_cast<char>(b11),
+                            static_cast<char>(b12), static_cast<char>(b13), static_cast<char>(b14),
+                            static_cast<char>(b15));
+}
+
+// the bytes of "input" shifted by N, with the last bytes of "prev" coming in
+template <int N>
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE __m256i prevBytes(__m256i input, __m256i prev) noexcept {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE __m256i highNibbles(__m256i v) noexcept {
+    return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+}
+
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE __m256i checkSpecialCases(__m256i input, __m256i prev1) noexcept {
+    const __m256i byte1High = _mm256_shuffle_epi8(
+        table(TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,  // 0___
+              TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,                                      // 10__
+              TOO_SHORT | OVERLONG_2,                                                          // 1100
+              TOO_SHORT,                                                                       // 1101
+              TOO_SHORT | OVERLONG_3 | SURROGATE,                                              // 1110
+              TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4),                            // 1111
+        highNibbles(prev1));
+    const __m256i byte1Low = _mm256_shuffle_epi8(
+        table(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,  // ____0000
+              CARRY | OVERLONG_2,                            // ____0001
+              CARRY, CARRY,                                  // ____001_
+              CARRY | TOO_LARGE,                             // ____0100
+              CARRY | TOO_LARGE | TOO_LARGE_1000,            // ____0101
+              CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+              CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+              CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+              CARRY | TOO_LARGE | TOO_LARGE_1000,
+              CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,  // ____1101
+              CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000),
+        _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    const __m256i byte2High = _mm256_shuffle_epi8(
+        table(TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,  // 0___
+              TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,            // 1000
+              TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,                              // 1001
+              TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,                               // 1010
+              TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,                               // 1011
+              TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT),                                             // 11__
+        highNibbles(input));
+    return _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+}
+
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE __m256i checkMultibyteLengths(__m256i input, __m256i prev, __m256i sc) noexcept {
+    const __m256i prev2 = prevBytes<2>(input, prev);
+    const __m256i prev3 = prevBytes<3>(input, prev);
+    // only 111_____ and 1111____ leave the high bit set
+    const __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must23, sc);
+}
+
+// a lead byte at the end of a block needs continuation bytes from the next one
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE __m256i isIncomplete(__m256i input) noexcept {
+    const __m256i maxValue = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm256_subs_epu8(input, maxValue);
+}
+
+struct State {
+    __m256i error;
+    __m256i prev;
+    __m256i prevIncomplete;
+};
+
+TXY_TARGET("avx2") TXY_ALWAYS_INLINE void step(State& s, __m256i input) noexcept {
+    if (_mm256_movemask_epi8(input) == 0) {
+        // ASCII: only an unfinished sequence from the previous block can be wrong
+        s.error = _mm256_or_si256(s.error, s.prevIncomplete);
+    }
+    else {
+        const __m256i sc = checkSpecialCases(input, prevBytes<1>(input, s.prev));
+        s.error = _mm256_or_si256(s.error, checkMultibyteLengths(input, s.prev, sc));
+        s.prevIncomplete = isIncomplete(input);
+    }
+    s.prev = input;
+}
+
+TXY_TARGET("avx2") bool validate(const unsigned char* p, const unsigned char* end) noexcept {
+    State s{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+
+    for (; end - p >= 32; p += 32) {
+        step(s, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+        if ((reinterpret_cast<std::uintptr_t>(p) & 0xFFF) < 32 && !_mm256_testz_si256(s.error, s.error))
+            return false;  // an early exit now and then
+    }
+    if (p < end) {
+        // the zero padding is ASCII, so an unfinished sequence is caught as an error
+        alignas(32) unsigned char tail[32] = {};
+        std::memcpy(tail, p, static_cast<std::size_t>(end - p));
+        step(s, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    s.error = _mm256_or_si256(s.error, s.prevIncomplete);
+    return _mm256_testz_si256(s.error, s.error);
+}
+
+}  // namespace utf8avx2
+#endif
+
+/********************
+ ***** Dispatch *****
+ ********************/
+
+struct Kernels {
+    const char* name;
+    Texxy::LineScan (*scanLines)(const unsigned char*,
+                                 const unsigned char*,
+                                 std::int64_t,
+                                 std::vector<std::int64_t>*,
+                                 std::int64_t,
+                                 const Texxy::ScanSink*);
+    void (*countZeros)(const unsigned char*, const unsigned char*, std::size_t*) noexcept;
+    bool (*validUtf8)(const unsigned char*, const unsigned char*) noexcept;
+};
+
+Texxy::LineScan scanLinesScalar(const unsigned char* b,
+                                const unsigned char* e,
+                                std::int64_t maxLine,
+                                std::vector<std::int64_t>* lineStarts,
+                                std::int64_t stride,
+                                const Texxy::ScanSink* sink) {
+    return scanLinesWith<ScalarKernel>(b, e, maxLine, lineStarts, stride, sink);
+}
+void countZerosScalar(const unsigned char* b, const unsigned char* e, std::size_t* counts) noexcept {
+    countZerosWith<ScalarKernel>(b, e, counts);
+}
+bool validUtf8Scalar(const unsigned char* b, const unsigned char* e) noexcept {
+    return validateUtf8With<skipAsciiScalar>(b, e);
+}
+
+#ifdef TXY_X86_DISPATCH
+TXY_TARGET("sse2") TXY_FLATTEN
+Texxy::LineScan scanLinesSse2(const unsigned char* b,
+                                const unsigned char* e,
+                                std::int64_t maxLine,
+                                std::vector<std::int64_t>* lineStarts,
+                                std::int64_t stride,
+                                const Texxy::ScanSink* sink) {
+    return scanLinesWith<Sse2Kernel>(b, e, maxLine, lineStarts, stride, sink);
+}
+TXY_TARGET("sse2") TXY_FLATTEN void countZerosSse2(const unsigned char* b, const unsigned char* e, std::size_t* counts) noexcept {
+    countZerosWith<Sse2Kernel>(b, e, counts);
+}
+TXY_TARGET("sse2") TXY_FLATTEN bool validUtf8Sse2(const unsigned char* b, const unsigned char* e) noexcept {
+    return validateUtf8With<skipAsciiSse2>(b, e);
+}
+
+TXY_TARGET("avx2") TXY_FLATTEN
+Texxy::LineScan scanLinesAvx2(const unsigned char* b,
+                                const unsigned char* e,
+                                std::int64_t maxLine,
+                                std::vector<std::int64_t>* lineStarts,
+                                std::int64_t stride,
+                                const Texxy::ScanSink* sink) {
+    return scanLinesWith<Avx2Kernel>(b, e, maxLine, lineStarts, stride, sink);
+}
+TXY_TARGET("avx2") TXY_FLATTEN void countZerosAvx2(const unsigned char* b, const unsigned char* e, std::size_t* counts) noexcept {
+    countZerosWith<Avx2Kernel>(b, e, counts);
+}
+#endif
+
+const Kernels& kernels() noexcept {
+    static const Kernels k = [] {
+#ifdef TXY_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return Kernels{"avx2", scanLinesAvx2, countZerosAvx2, utf8avx2::validate};
+        if (__builtin_cpu_supports("sse2"))
+            return Kernels{"sse2", scanLinesSse2, countZerosSse2, validUtf8Sse2};
+#endif
+        return Kernels{"scalar", scanLinesScalar, countZerosScalar, validUtf8Scalar};
+    }();
+    return k;
+}
+
+}  // namespace
+
+namespace Texxy {
+
+LineScan scanLines(const unsigned char* begin,
+                   const unsigned char* end,
+                   std::int64_t maxLine,
+                   std::vector<std::int64_t>* lineStarts,
+                   std::int64_t stride,
+                   const ScanSink* sink) {
+    if (!begin || begin >= end) {
+        if (lineStarts)
+            lineStarts->push_back(0);
+        return LineScan();
+    }
+    return kernels().scanLines(begin, end, maxLine, lineStarts, stride < 1 ? 1 : stride, sink);
+}
+
+void countZerosMod4(const unsigned char* begin, const unsigned char* end, std::size_t counts[4]) noexcept {
+    counts[0] = counts[1] = counts[2] = counts[3] = 0;
+    if (begin && begin < end)
+        kernels().countZeros(begin, end, counts);
+}
+
+bool isValidUtf8(const unsigned char* begin, const unsigned char* end) noexcept {
+    if (!begin || begin >= end)
+        return true;
+    return kernels().validUtf8(begin, end);
+}
+
+const char* scanKernelName() noexcept {
+    return kernels().name;
+}
+
+}  // namespace Texxy
@@ -0,0 +1,70 @@
+// src/core/textscan.h
+/*
+  texxy/textscan.h
+  byte-level scanning of raw file data, vectorized where the CPU allows it
+*/
+
+#ifndef TEXTSCAN_H
+#define TEXTSCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Texxy {
+
+enum class LineEnd : std::uint8_t { Lf, CrLf, Cr };
+
+struct LineScan {
+    bool hasNull = false;          // a NUL byte was found (up to the cutoff, if any)
+    std::int64_t cutoff = -1;      // index of the first byte past "maxLine" bytes of a line, or -1
+    std::int64_t lineCount = 1;    // lines before the cutoff, ended by LF, CRLF or a lone CR
+    std::int64_t longestLine = 0;  // bytes in the longest line before the cutoff, without CR/LF
+    std::int64_t lfCount = 0;      // line ends of each kind before the cutoff
+    std::int64_t crlfCount = 0;
+    std::int64_t crCount = 0;
+
+    /* The most common line end (LF if there is none or on a tie). */
+    LineEnd dominantLineEnd() const noexcept {
+        if (crlfCount > lfCount && crlfCount >= crCount)
+            return LineEnd::CrLf;
+        if (crCount > lfCount && crCount > crlfCount)
+            return LineEnd::Cr;
+        return LineEnd::Lf;
+    }
+    bool hasMixedLineEnds() const noexcept { return (lfCount != 0) + (crlfCount != 0) + (crCount != 0) > 1; }
+};
+
+/* Receives the bytes that a scan has passed, in consecutive spans that are
+   still in the cache, so that they can be hashed (for example) in the same pass.
+   The bytes after a cutoff are passed too. */
+struct ScanSink {
+    void (*consume)(void* context, const unsigned char* begin, const unsigned char* end);
+    void* context;
+};
+
+/* Finds NUL bytes and the first line (separated by CR or LF) that is longer than
+   "maxLine" bytes, and counts lines and their kinds of ends in the same pass.
+   Scanning stops at the cutoff.
+   If "lineStarts" isn't null, the offsets of lines 0, stride, 2*stride... are appended to it.
+   If "sink" isn't null, it is given all the bytes (see ScanSink). */
+LineScan scanLines(const unsigned char* begin,
+                   const unsigned char* end,
+                   std::int64_t maxLine,
+                   std::vector<std::int64_t>* lineStarts = nullptr,
+                   std::int64_t stride = 1,
+                   const ScanSink* sink = nullptr);
+
+/* Counts NUL bytes at positions 0, 1, 2 and 3 modulo 4 (relative to "begin"). */
+void countZerosMod4(const unsigned char* begin, const unsigned char* end, std::size_t counts[4]) noexcept;
+
+/* Strict UTF-8 validation: overlong forms, surrogates and code points
+   above U+10FFFF are rejected. */
+bool isValidUtf8(const unsigned char* begin, const unsigned char* end) noexcept;
+
+/* The name of the instruction set chosen at runtime ("avx2", "sse2" or "scalar"). */
+const char* scanKernelName() noexcept;
+
+}  // namespace Texxy
+
+#endif  // TEXTSCAN_H
@@ -0,0 +1,80 @@
+// src/core/textwriter.cpp
+/*
+  texxy/textwriter.cpp
+*/
+
+#include "textwriter.h"
+
+#include <QIODevice>
+
+namespace Texxy {
+
+TextWriter::TextWriter(QIODevice* device, QStringEncoder& encoder)
+    : device_(device),
+      encoder_(encoder),
+      buffer_(kBufferSize, Qt::Uninitialized),
+      used_(0),
+      error_(false) {}
+
+bool TextWriter::write(QStringView text) {
+    while (!text.isEmpty() && !error_) {
+        QStringView part = text.first(qMin(text.size(), kSlice));
+        // a surrogate pair isn't split between parts
+        if (part.size() < text.size() && part.back().isHighSurrogate())
+            part.chop(1);
+        if (used_ + encoder_.requiredSpace(part.size()) > buffer_.size() && !flush())
+            break;
+        char* const end = encoder_.appendToBuffer(buffer_.data() + used_, part);
+        used_ = end - buffer_.constData();
+        text = text.sliced(part.size());
+    }
+    return !error_;
+}
+
+bool TextWriter::writeDocument(QStringView rawText, const QList<int>& softBreaks, LineEnd lineEnd) {
+    const QStringView eol = lineEnd == LineEnd::CrLf ? QStringView(u"\r\n")
+                            : lineEnd == LineEnd::Cr ? QStringView(u"\r")
+                                                     : QStringView(u"\n");
+    auto softBreak = softBreaks.cbegin();
+    qsizetype from = 0;
+    const qsizetype size = rawText.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        QStringView replacement;
+        switch (rawText.at(i).unicode()) {
+            case QChar::ParagraphSeparator:
+                while (softBreak != softBreaks.cend() && *softBreak < i)
+                    ++softBreak;
+                if (softBreak == softBreaks.cend() || *softBreak != i)
+                    replacement = eol;
+                break;
+            case QChar::LineSeparator:
+            case 0xfdd0:  // frame markers
+            case 0xfdd1:
+                replacement = eol;
+                break;
+            case QChar::Nbsp:
+                replacement = QStringView(u" ");
+                break;
+            default:
+                continue;
+        }
+        if (!write(rawText.mid(from, i - from)) || !write(replacement))
+            return false;
+        from = i + 1;
+    }
+    return write(rawText.mid(from));
+}
+
+bool TextWriter::flush() {
+    if (error_)
+        return false;
+    if (used_ == 0)
+        return true;
+    const auto* data = reinterpret_cast<const uchar*>(buffer_.constData());
+    hash_.add(data, used_);
+    error_ = device_->write(buffer_.constData(), used_) != used_;
+    used_ = 0;
+    return !error_;
+}
+
+}  // namespace Texxy
@@ -0,0 +1,55 @@
+// src/core/textwriter.h
+/*
+  texxy/textwriter.h
+*/
+
+#ifndef TEXTWRITER_H
+#define TEXTWRITER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QStringEncoder>
+#include <QStringView>
+
+#include "contenthash.h"
+#include "textscan.h"
+
+class QIODevice;
+
+namespace Texxy {
+
+/* Encodes a text that is given in parts into a buffer of a fixed size, which is
+   written to "device" whenever it is full, so that saving takes no memory in
+   proportion to the size of the text. The written bytes are fingerprinted on the
+   way (see ContentHash). The encoder's state is kept between the parts. */
+class TextWriter {
+    Q_DISABLE_COPY_MOVE(TextWriter)
+
+   public:
+    TextWriter(QIODevice* device, QStringEncoder& encoder);
+
+    bool write(QStringView text);  // false after a write error
+    bool flush();                  // writes what is buffered
+
+    /* Writes the raw text of a document as its plain text, with the replacements of
+       QTextDocument::toPlainText(), "lineEnd" for its line ends, and nothing for the
+       block separators at the positions "softBreaks" (in order). */
+    bool writeDocument(QStringView rawText, const QList<int>& softBreaks, LineEnd lineEnd);
+
+    quint64 contentHash() const noexcept { return hash_.result(); }  // of the bytes that are flushed
+
+   private:
+    static constexpr qsizetype kBufferSize = 1 << 16;
+    static constexpr qsizetype kSlice = 1 << 12;  // characters encoded at once
+
+    QIODevice* device_;
+    QStringEncoder& encoder_;
+    QByteArray buffer_;
+    qsizetype used_;
+    ContentHash hash_;
+    bool error_;
+};
+
+}  // namespace Texxy
+
+#endif  // TEXTWRITER_H
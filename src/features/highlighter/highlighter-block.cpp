@@ -4,24 +4,210 @@
  */
 
 #include "highlighter.h"
+#include "highlightworker.h"
 
 #include <algorithm>
+#include <utility>
 #include <QMetaObject>
+#include <QTextDocument>
 
 namespace Texxy {
 
+/*************************/
+// Apply what the worker thread has made of the current block.
+void Highlighter::applyPendingResult(const QString& text) {
+    std::shared_ptr<const HighlightResult> result;
+    if (TextBlockData* data = static_cast<TextBlockData*>(currentBlockUserData()))
+        result = data->takePendingResult();
+    /* The old formats of a changed block would be at wrong positions, so it
+       stays unformatted until the worker thread has highlighted the new text. */
+    if (!result || result->textHash != qHash(text))
+        return;
+
+    for (const QTextLayout::FormatRange& range : result->formats)
+        setFormat(range.start, range.length, range.format);
+    setCurrentBlockState(result->state);
+    if (result->data)
+        setCurrentBlockUserData(result->data->clone());
+}
+
+/*************************/
+// Set the formats that the block had before this pass (they are cleared otherwise).
+void Highlighter::keepFormats() {
+    /* a block without data hasn't been highlighted, so it has no formats to keep,
+       and its layout, which would be made by asking for it, isn't needed yet */
+    if (!currentBlockUserData())
+        return;
+    const QList<QTextLayout::FormatRange> formats = currentBlock().layout()->formats();
+    for (const QTextLayout::FormatRange& range : formats)
+        setFormat(range.start, range.length, range.format);
+}
+
+/*************************/
+// Defer the highlighting of a block after the limit, until highlightDirtyBlocks().
+// A block without data is dirty anyway, because it hasn't been highlighted.
+void Highlighter::markDirty(const QTextBlock& block) {
+    if (TextBlockData* data = static_cast<TextBlockData*>(block.userData()))
+        data->setDirty(true);
+
+    /* remember the start of its run of dirty blocks */
+    const QTextBlock prevBlock = block.previous();
+    if (prevBlock.isValid()) {
+        const TextBlockData* prevData = static_cast<TextBlockData*>(prevBlock.userData());
+        if (!prevData || prevData->isDirty())
+            return;
+    }
+    for (const QTextCursor& run : std::as_const(dirtyRuns_)) {
+        if (run.block() == block)
+            return;
+    }
+    QTextCursor run(block);
+    run.setKeepPositionOnInsert(true);
+    dirtyRuns_.append(run);
+}
+
+/*************************/
+void Highlighter::highlightDirtyBlocks() {
+    if (worker_) {
+        worker_->setLimit(endCursor.blockNumber());
+        return;
+    }
+
+    const int last = endCursor.blockNumber();
+    const QList<QTextCursor> runs = std::exchange(dirtyRuns_, QList<QTextCursor>());
+    for (const QTextCursor& run : runs) {
+        QTextBlock block = run.block();
+        if (block.blockNumber() > last) {
+            dirtyRuns_.append(run);
+            continue;
+        }
+        /* a block after the limit starts the rest of the run (see highlightBlock()) */
+        while (block.isValid() && block.blockNumber() <= last) {
+            const TextBlockData* data = static_cast<TextBlockData*>(block.userData());
+            if (!data || data->isDirty())
+                rehighlightBlock(block);
+            block = block.next();
+        }
+    }
+}
+
+/*************************/
+// Used by HighlightMirror::start().
+void Highlighter::highlightToLimit() {
+    const int last = endCursor.blockNumber();
+    QTextBlock block = document()->firstBlock();
+    for (; block.isValid() && block.blockNumber() <= last; block = block.next()) {
+        if (!block.userData())  // not reached by the pass of a previous block
+            rehighlightBlock(block);
+    }
+    if (block.isValid())
+        markDirty(block);
+}
+
+/*************************/
+void Highlighter::carryChanges() {
+    carryQueued_ = false;
+    const QList<int> blocks = std::exchange(carried_, QList<int>());
+    if (blocks.isEmpty())
+        return;
+    QTextDocument* doc = document();
+    if (carriedRevision_ == doc->revision()) {
+        for (const int n : blocks) {
+            const QTextBlock block = doc->findBlockByNumber(n);
+            if (block.isValid())
+                rehighlightBlock(block);
+        }
+        return;
+    }
+
+    /* The text has changed since the blocks were found, so their numbers may belong
+       to other blocks now. All blocks from the first number to the limit are
+       highlighted again, and the next one is marked as dirty. */
+    const int last = endCursor.blockNumber();
+    QTextBlock block = doc->findBlockByNumber(*std::min_element(blocks.cbegin(), blocks.cend()));
+    for (; block.isValid() && block.blockNumber() <= last; block = block.next())
+        rehighlightBlock(block);
+    if (block.isValid())
+        markDirty(block);
+}
+
 /*************************/
 // Start syntax highlighting!
 void Highlighter::highlightBlock(const QString& text) {
-    if (progLan.isEmpty())
+    if (progLan == Language::None)
+        return;
+
+    if (worker_) {
+        applyPendingResult(text);
+        return;
+    }
+
+    QTextBlock block = currentBlock();
+    if (carriedRevision_ == document()->revision())
+        carried_.removeOne(block.blockNumber());  // it's highlighted now
+
+    /* A change isn't carried past the limit, so that its cost doesn't depend on
+       the size of the document. The blocks after it keep their states and formats
+       and are highlighted when they are needed. Those that haven't been highlighted
+       are left untouched. */
+    if (block.blockNumber() > endCursor.blockNumber()) {
+        keepFormats();
+        markDirty(block);
         return;
+    }
+
+    const int oldState = currentBlockState();
+    size_t oldCheckpoint = 0;
+    if (TextBlockData* oldData = static_cast<TextBlockData*>(currentBlockUserData()))
+        oldCheckpoint = oldData->checkpoint();
 
-    if (progLan == "json") {  // Json's huge lines are also handled separately because of its special syntax
-        highlightJsonBlock(text);
+    formatBlock(text);
+
+    TextBlockData* data = static_cast<TextBlockData*>(currentBlockUserData());
+    if (!data)
+        return;
+    const size_t checkpoint = data->stateHash(currentBlockState());
+    data->setCheckpoint(checkpoint);
+    data->setDirty(false);
+    if (currentBlockState() != oldState)
+        return;  // QSyntaxHighlighter goes on with the next block
+
+    /* The propagation stops here if the next block starts as it did, that is, if
+       the whole state at the end of this block is the same as its checkpoint.
+       Otherwise, the next block is highlighted after this pass (if it isn't so in
+       it), or is marked as dirty if it's after the limit. */
+    QTextBlock nextBlock = block.next();
+    if (!nextBlock.isValid())
+        return;
+    if (checkpoint == oldCheckpoint) {
+        const TextBlockData* nextData = static_cast<TextBlockData*>(nextBlock.userData());
+        if (nextData && !nextData->isDirty())
+            return;
+    }
+    if (nextBlock.blockNumber() > endCursor.blockNumber()) {
+        markDirty(nextBlock);
         return;
     }
-    if (progLan == "xml") {  // Optimized SVG files can have huge lines with more than 10000 characters
-        highlightXmlBlock(text);
+    /* the numbers of the carried blocks are valid only in the text they were found in */
+    const int revision = document()->revision();
+    if (carried_.isEmpty())
+        carriedRevision_ = revision;
+    else if (carriedRevision_ != revision)
+        carriedRevision_ = -1;
+    if (!carried_.contains(nextBlock.blockNumber())) {
+        carried_.append(nextBlock.blockNumber());
+        if (!carryQueued_) {
+            carryQueued_ = true;
+            QMetaObject::invokeMethod(this, &Highlighter::carryChanges, Qt::QueuedConnection);
+        }
+    }
+}
+
+/*************************/
+// Format the current block.
+void Highlighter::formatBlock(const QString& text) {
+    if (ownHugeLines_) {  // Json and XML
+        (this->*blockHighlighter_)(text);
         return;
     }
 
@@ -36,28 +222,9 @@ void Highlighter::highlightBlock(const QString& text) {
         if (mainFormatting)
             setFormat(0, txtL, mainFormat);
 
-        if (progLan == "fountain") {
-            highlightFountainBlock(text);
-            return;
-        }
-        if (progLan == "yaml") {
-            highlightYamlBlock(text);
-            return;
-        }
-        if (progLan == "markdown") {
-            highlightMarkdownBlock(text);
-            return;
-        }
-        if (progLan == "reST") {
-            highlightReSTBlock(text);
-            return;
-        }
-        if (progLan == "tcl") {
-            highlightTclBlock(text);
-            return;
-        }
-        if (progLan == "lua") {
-            highlightLuaBlock(text);
+        // fountain, yaml, markdown, reST, tcl and lua
+        if (blockHighlighter_) {
+            (this->*blockHighlighter_)(text);
             return;
         }
     }
@@ -89,7 +256,7 @@ void Highlighter::highlightBlock(const QString& text) {
 
     /* Java is formatted separately, partially because of "Javadoc"
        but also because its single quotes are for literal characters */
-    if (progLan == "java") {
+    if (progLan == Language::Java) {
         singleLineJavaComment(text);
         JavaQuote(text);
         multiLineJavaComment(text);
@@ -112,9 +279,9 @@ void Highlighter::highlightBlock(const QString& text) {
      * "Here" Documents *
      ********************/
 
-    if (progLan == "sh" || progLan == "perl" || progLan == "ruby") {
+    if (progLan == Language::Sh || progLan == Language::Perl || progLan == Language::Ruby) {
         /* first, handle "__DATA__" in perl */
-        if (progLan == "perl") {
+        if (progLan == Language::Perl) {
             static const QRegularExpression perlData("^\\s*__(DATA|END)__");
             QRegularExpressionMatch match;
             if (previousBlockState() == updateState  // only used below to distinguish "__DATA__"
@@ -168,14 +335,14 @@ void Highlighter::highlightBlock(const QString& text) {
         }
     }
     /* just for debian control file */
-    else if (progLan == "deb")
+    else if (progLan == Language::Deb)
         debControlFormatting(text);
 
     /************************
      * Single-Line Comments *
      ************************/
 
-    if (progLan != "html")
+    if (progLan != Language::Html)
         singleLineComment(text, 0);
 
     /* this is only for setting the format of
@@ -191,7 +358,7 @@ void Highlighter::highlightBlock(const QString& text) {
     /**********************************
      * Pascal Quotations and Comments *
      **********************************/
-    if (progLan == "pascal") {
+    if (progLan == Language::Pascal) {
         singleLinePascalComment(text);
         pascalQuote(text);
         multiLinePascalComment(text);
@@ -201,7 +368,7 @@ void Highlighter::highlightBlock(const QString& text) {
     /******************
      * LaTeX Formulae *
      ******************/
-    else if (progLan == "LaTeX") {
+    else if (progLan == Language::LaTeX) {
         latexFormula(text);
         if (data->labelInfo() != oldLabel)
             rehighlightNextBlock = true;
@@ -209,11 +376,11 @@ void Highlighter::highlightBlock(const QString& text) {
     /*****************************************
      * (Multiline) Quotations as well as CSS *
      *****************************************/
-    else if (progLan == "sh")  // bash has its own method
+    else if (progLan == Language::Sh)  // bash has its own method
         SH_MultiLineQuote(text);
-    else if (progLan == "toml")  // Toml has its own method
+    else if (progLan == Language::Toml)  // Toml has its own method
         tomlQuote(text);
-    else if (progLan == "css") {  // quotes and urls are highlighted by cssHighlighter() inside CSS values
+    else if (progLan == Language::Css) {  // quotes and urls are highlighted by cssHighlighter() inside CSS values
         cssHighlighter(text, mainFormatting);
         rehighlightNextBlock |= (data->openNests() != oldOpenNests);
     }
@@ -224,9 +391,9 @@ void Highlighter::highlightBlock(const QString& text) {
      * Multiline Comments *
      **********************/
 
-    if (progLan == "cmake")
+    if (progLan == Language::CMake)
         rehighlightNextBlock |= cmakeDoubleBrackets(text, oldOpenNests, oldProperty);
-    else if (!commentStartExpression.pattern().isEmpty() && progLan != "python")
+    else if (!commentStartExpression.pattern().isEmpty() && progLan != Language::Python)
         rehighlightNextBlock |=
             multiLineComment(text, 0, commentStartExpression, commentEndExpression, commentState, commentFormat);
 
@@ -236,7 +403,8 @@ void Highlighter::highlightBlock(const QString& text) {
     /* "Property" is used for knowing about Perl's backquotes,
         "label" is used for delimiter strings, and "OpenNests" for
         paired delimiters as well as Rust's raw string literals. */
-    if ((progLan == "perl" || progLan == "ruby" || progLan == "rust") && currentBlockState() == data->lastState()) {
+    if ((progLan == Language::Perl || progLan == Language::Ruby || progLan == Language::Rust) &&
+        currentBlockState() == data->lastState()) {
         rehighlightNextBlock |=
             (data->labelInfo() != oldLabel || data->getProperty() != oldProperty || data->openNests() != oldOpenNests);
     }
@@ -247,7 +415,7 @@ void Highlighter::highlightBlock(const QString& text) {
      * HTML Only *
      *************/
 
-    if (progLan == "html") {
+    if (progLan == Language::Html) {
         htmlBrackets(text);
         htmlCSSHighlighter(text);
         htmlJavascript(text);
@@ -263,7 +431,7 @@ void Highlighter::highlightBlock(const QString& text) {
     // we format html embedded javascript in htmlJavascript()
     else if (mainFormatting) {
         data->setHighlighted();  // completely highlighted
-        QRegularExpressionMatch match;
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
@@ -274,19 +442,19 @@ void Highlighter::highlightBlock(const QString& text) {
             if (rule.format == commentFormat)
                 continue;
 
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             /* skip quotes and all comments */
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 && (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                                       fi == commentFormat || fi == urlFormat || fi == regexFormat)) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
 
             while (index >= 0) {
-                int length = match.capturedLength();
+                int length = matchLength;
                 int l = length;
                 /* In c/c++, the neutral pattern after "#define" may contain
                    a (double-)slash but it's always good to check whether a
@@ -303,13 +471,13 @@ void Highlighter::highlightBlock(const QString& text) {
                     }
                 }
                 setFormat(index, l, rule.format);
-                index = text.indexOf(rule.pattern, index + length, &match);
+                index = rule.indexIn(text, index + length, &matchLength);
 
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 && (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                                           fi == commentFormat || fi == urlFormat || fi == regexFormat)) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
@@ -329,7 +497,7 @@ void Highlighter::highlightBlock(const QString& text) {
             formatAtPos == commentFormat || formatAtPos == urlFormat || formatAtPos == regexFormat) {
             return true;
         }
-        return checkEscaped && progLan == "sh" && isEscapedChar(text, pos);
+        return checkEscaped && progLan == Language::Sh && isEscapedChar(text, pos);
     };
 
     auto collectBracketPositions = [&](auto newInfo, QChar symbol, bool checkEscaped) {
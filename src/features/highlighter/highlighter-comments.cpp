@@ -13,7 +13,7 @@
 namespace Texxy {
 
 bool Highlighter::isMLCommented(const QString& text, const int index, int comState, const int start) {
-    if (progLan == "cmake")
+    if (progLan == Language::CMake)
         return isCmakeDoubleBracketed(text, index, start);
 
     if (index < 0 || start < 0 ||
@@ -24,7 +24,7 @@ bool Highlighter::isMLCommented(const QString& text, const int index, int comSta
     }
 
     /* not for Python */
-    if (progLan == "python")
+    if (progLan == Language::Python)
         return false;
 
     int prevState = previousBlockState();
@@ -84,7 +84,7 @@ bool Highlighter::isMLCommented(const QString& text, const int index, int comSta
 // This handles multiline python comments separately because they aren't normal.
 // It comes after singleLineComment() and before multiLineQuote().
 void Highlighter::pythonMLComment(const QString& text, const int indx) {
-    if (progLan != "python")
+    if (progLan != Language::Python)
         return;
 
     /* we reset the block state because this method is also called
@@ -113,7 +113,7 @@ void Highlighter::pythonMLComment(const QString& text, const int indx) {
         /* if the comment start is found... */
         if (index >= indx) {
             /* ... distinguish between double and single quotes */
-            if (index == text.indexOf(QRegularExpression("\"\"\""), index)) {
+            if (index == text.indexOf(QLatin1String("\"\"\""), index)) {
                 commentStartExpression.setPattern("\"\"\"");
                 quote = pyDoubleQuoteState;
             }
@@ -241,8 +241,9 @@ void Highlighter::singleLineComment(const QString& text, const int start) {
                            || isQuoted(text, startIndex, false, std::max(start, 0)) ||
                            isInsideRegex(text, startIndex)
                            // with troff and LaTeX, the comment sign may be escaped
-                           || ((progLan == "troff" || progLan == "LaTeX") && isEscapedChar(text, startIndex)) ||
-                           (progLan == "tcl" && text.at(startIndex) == ';' &&
+                           || ((progLan == Language::Troff || progLan == Language::LaTeX) &&
+                               isEscapedChar(text, startIndex)) ||
+                           (progLan == Language::Tcl && text.at(startIndex) == ';' &&
                             insideTclBracedVariable(text, startIndex, std::max(start, 0))))) {
                     startIndex = text.indexOf(rule.pattern, startIndex + 1);
                 }
@@ -267,11 +268,11 @@ void Highlighter::singleLineComment(const QString& text, const int start) {
                     pIndex += urlMatch.capturedLength();
                 }
 
-                if (progLan == "javascript" || progLan == "qml") {
+                if (progLan == Language::JavaScript || progLan == Language::Qml) {
                     /* see NOTE of isEscapedRegex() and also the end of multiLineRegex() */
                     setCurrentBlockState(regexExtraState);
                 }
-                else if ((progLan == "c" || progLan == "cpp") && text.endsWith(QLatin1Char('\\'))) {
+                else if ((progLan == Language::C || progLan == Language::Cpp) && text.endsWith(QLatin1Char('\\'))) {
                     /* Take care of next-line comments with languages, for which
                        no highlighting function is called after singleLineComment()
                        and before the main formatting in highlightBlock()
@@ -330,7 +331,7 @@ bool Highlighter::multiLineComment(const QString& text,
 
         /* skip quotations */
         QTextCharFormat fi = format(endIndex);
-        if (progLan != "fountain")  // in Fountain, altQuoteFormat is used for notes
+        if (progLan != Language::Fountain)  // in Fountain, altQuoteFormat is used for notes
         {  // FIXME: Is this really needed? Commented quotes are skipped in formatting multi-line quotes.
             while (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat) {
                 endIndex = text.indexOf(commentEndExp, endIndex + 1, &endMatch);
@@ -338,7 +339,7 @@ bool Highlighter::multiLineComment(const QString& text,
             }
         }
 
-        if (endIndex >= 0 && /*progLan != "xml" && */ progLan != "html")  // xml is formatted separately
+        if (endIndex >= 0 && /*progLan != Language::Xml && */ progLan != Language::Html)  // xml is formatted separately
         {
             /* because multiline commnets weren't taken into account in
                singleLineComment(), that method should be used here again */
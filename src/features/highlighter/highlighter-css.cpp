@@ -229,7 +229,7 @@ bool Highlighter::isInsideCSSValueUrl(const QString& text,
     if (valueStart == 0 && prevUrl)  // prevQuote is 0
     {
         /* format the first URL completely */
-        indx = text.indexOf(QRegularExpression("\\)"));
+        indx = text.indexOf(QLatin1Char(')'));
         int endIndx;
         if (indx == -1)
             endIndx = text.length();
@@ -338,9 +338,9 @@ void Highlighter::cssHighlighter(const QString& text, bool mainFormatting, const
      **************************/
 
     QRegularExpressionMatch cssStartMatch;
-    QRegularExpression cssStartExpression("\\{");
+    static const QRegularExpression cssStartExpression("\\{");
     QRegularExpressionMatch cssEndtMatch;
-    QRegularExpression cssEndExpression("\\}");
+    static const QRegularExpression cssEndExpression("\\}");
 
     /* it's supposed that a property can only contain letters, numbers, underlines and dashes */
     static const QRegularExpression cssValueStartExp("(?<=^|\\{|;|\\s)[A-Za-z0-9_\\-]+\\s*:(?!:)");
@@ -578,7 +578,7 @@ void Highlighter::cssHighlighter(const QString& text, bool mainFormatting, const
             numFormat.setFontItalic(true);
             numFormat.setForeground(Brown);
             QRegularExpressionMatch numMatch;
-            QRegularExpression numExpression("(-|\\+){0,1}\\b\\d*\\.{0,1}\\d+");
+            static const QRegularExpression numExpression("(-|\\+){0,1}\\b\\d*\\.{0,1}\\d+");
             int nIndex = text.indexOf(numExpression, valueStartIndex, &numMatch);
             while (format(nIndex) == quoteFormat || format(nIndex) == altQuoteFormat)
                 nIndex = text.indexOf(numExpression, nIndex + numMatch.capturedLength(), &numMatch);
@@ -19,7 +19,7 @@ void Highlighter::fountainFonts(const QString& text) {
     static const QRegularExpression boldExp("(?<!\\\\)\\*\\*([^*]|(?:(?<=\\\\)\\*))+(?<!\\\\|\\s)\\*\\*");
     static const QRegularExpression boldItalicExp("(?<!\\\\)\\*{3}([^*]|(?:(?<=\\\\)\\*))+(?<!\\\\|\\s)\\*{3}");
 
-    const QRegularExpression exp(boldExp.pattern() + "|" + italicExp.pattern() + "|" + boldItalicExp.pattern());
+    static const QRegularExpression exp(boldExp.pattern() + "|" + italicExp.pattern() + "|" + boldItalicExp.pattern());
 
     int index = 0;
     while ((index = text.indexOf(exp, index, &expMatch)) > -1) {
@@ -158,10 +158,11 @@ void Highlighter::highlightFountainBlock(const QString& text) {
     static const QRegularExpression charRegex("^\\s*@");
     static const QRegularExpression parenRegex("^\\s*\\(.*\\)$");
     static const QRegularExpression lyricRegex("^\\s*~");
+    static const QRegularExpression transitionStart("^\\s*>");
 
     /* notes */
-    multiLineComment(text, 0, leftNoteBracket, QRegularExpression("^ ?$|\\]\\]"), markdownBlockQuoteState,
-                     altQuoteFormat);
+    static const QRegularExpression noteEnd("^ ?$|\\]\\]");
+    multiLineComment(text, 0, leftNoteBracket, noteEnd, markdownBlockQuoteState, altQuoteFormat);
     /* boneyards (like a multi-line comment -- skips altQuoteFormat in notes with commentStartExpression) */
     multiLineComment(text, 0, commentStartExpression, commentEndExpression, commentState, commentFormat);
 
@@ -200,8 +201,7 @@ void Highlighter::highlightFountainBlock(const QString& text) {
         }
         /* transitions (between blank lines) */
         else if (previousBlockState() == updateState && isFountainLineBlank(nxtBlock) &&
-                 ((text.indexOf(QRegularExpression("^\\s*>")) == 0 &&
-                   text.indexOf(QRegularExpression("<$")) == -1)  // not centered
+                 ((text.indexOf(transitionStart) == 0 && !text.endsWith(QLatin1Char('<')))  // not centered
                   || (isUpperCase(text) && text.endsWith("TO:")))) {
             fFormat.setFontWeight(QFont::Bold);
             fFormat.setForeground(DarkMagenta);
@@ -234,7 +234,7 @@ void Highlighter::highlightFountainBlock(const QString& text) {
     int bn = currentBlock().blockNumber();
     if (bn >= startCursor.blockNumber() && bn <= endCursor.blockNumber()) {
         data->setHighlighted();
-        QRegularExpressionMatch match;
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
@@ -243,23 +243,23 @@ void Highlighter::highlightFountainBlock(const QString& text) {
         {
             if (rule.format == commentFormat)
                 continue;
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 && fi != mainFormat) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
             while (index >= 0) {
-                int length = match.capturedLength();
+                int length = matchLength;
                 setFormat(index, length, rule.format);
-                index = text.indexOf(rule.pattern, index + length, &match);
+                index = rule.indexIn(text, index + length, &matchLength);
 
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 && fi != mainFormat) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
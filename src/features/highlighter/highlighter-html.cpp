@@ -6,7 +6,7 @@ namespace Texxy {
 
 // This should be called before "htmlCSSHighlighter()" and "htmlJavascript()".
 void Highlighter::htmlBrackets(const QString& text, const int start) {
-    if (progLan != "html")
+    if (progLan != Language::Html)
         return;
 
     /*****************************
@@ -249,7 +249,8 @@ void Highlighter::htmlBrackets(const QString& text, const int start) {
                 }
 
                 /* also, mark encoded and unencoded ampersands */
-                QRegularExpression ampersand("&");
+                static const QRegularExpression ampersand("&");
+                static const QRegularExpression entity("^&(#[0-9]+|[a-zA-Z]+[a-zA-Z0-9_:\\.\\-]*|#[xX][0-9a-fA-F]+);");
                 QTextCharFormat encodedFormat;
                 encodedFormat.setForeground(DarkMagenta);
                 encodedFormat.setFontItalic(true);
@@ -275,10 +276,8 @@ void Highlighter::htmlBrackets(const QString& text, const int start) {
                     }
                     else {
                         str = text.mid(index);
-                        if (str.indexOf(
-                                QRegularExpression("^&(#[0-9]+|[a-zA-Z]+[a-zA-Z0-9_:\\.\\-]*|#[xX][0-9a-fA-F]+);"), 0,
-                                &match) >
-                            -1) {  // accept "&name;", "&number;" and "&hexadecimal;" but format them differently
+                        // accept "&name;", "&number;" and "&hexadecimal;" but format them differently
+                        if (str.indexOf(entity, 0, &match) > -1) {
                             setFormat(index, match.capturedLength(), encodedFormat);
                             index = text.indexOf(ampersand, index + match.capturedLength());
                         }
@@ -298,7 +297,7 @@ void Highlighter::htmlBrackets(const QString& text, const int start) {
 }
 /*************************/
 void Highlighter::htmlCSSHighlighter(const QString& text, const int start) {
-    if (progLan != "html")
+    if (progLan != Language::Html)
         return;
 
     int cssIndex = start;
@@ -313,7 +312,7 @@ void Highlighter::htmlCSSHighlighter(const QString& text, const int start) {
     /* switch to css temporarily */
     commentStartExpression = htmlSubcommetStart;
     commentEndExpression = htmlSubcommetEnd;
-    progLan = "css";
+    progLan = Language::Css;
 
     bool wasCSS(false);
     int prevState = previousBlockState();
@@ -413,13 +412,13 @@ void Highlighter::htmlCSSHighlighter(const QString& text, const int start) {
                the rest of the line as an html code again */
             setFormat(cssEndIndex, text.length() - cssEndIndex, mainFormat);
             setCurrentBlockState(0);
-            progLan = "html";
+            progLan = Language::Html;
             commentStartExpression = htmlCommetStart;
             commentEndExpression = htmlCommetEnd;
             htmlBrackets(text, cssEndIndex);
             commentStartExpression = htmlSubcommetStart;
             commentEndExpression = htmlSubcommetEnd;
-            progLan = "css";
+            progLan = Language::Css;
         }
 
         cssIndex = text.indexOf(cssStartExp, cssIndex + len, &startMatch);
@@ -433,13 +432,13 @@ void Highlighter::htmlCSSHighlighter(const QString& text, const int start) {
     }
 
     /* revert to html */
-    progLan = "html";
+    progLan = Language::Html;
     commentStartExpression = htmlCommetStart;
     commentEndExpression = htmlCommetEnd;
 }
 /*************************/
 void Highlighter::htmlJavascript(const QString& text) {
-    if (progLan != "html")
+    if (progLan != Language::Html)
         return;
 
     int javaIndex = 0;
@@ -454,7 +453,7 @@ void Highlighter::htmlJavascript(const QString& text) {
     /* switch to javascript temporarily */
     commentStartExpression = htmlSubcommetStart;
     commentEndExpression = htmlSubcommetEnd;
-    progLan = "javascript";
+    progLan = Language::JavaScript;
     multilineQuote_ = true;  // needed alongside progLan
 
     bool wasJavascript(false);
@@ -525,26 +524,26 @@ void Highlighter::htmlJavascript(const QString& text) {
                 if (rule.format == commentFormat)
                     continue;
 
-                QRegularExpressionMatch match;
-                int index = text.indexOf(rule.pattern, javaIndex + matched, &match);
+                int matchLength = 0;
+                int index = rule.indexIn(text, javaIndex + matched, &matchLength);
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 && (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                                           fi == commentFormat || fi == urlFormat || fi == regexFormat)) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
 
                 while (index >= 0) {
-                    setFormat(index, match.capturedLength(), rule.format);
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    setFormat(index, matchLength, rule.format);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
 
                     if (rule.format != whiteSpaceFormat) {
                         fi = format(index);
                         while (index >= 0 && (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                                               fi == commentFormat || fi == urlFormat || fi == regexFormat)) {
-                            index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                            index = rule.indexIn(text, index + matchLength, &matchLength);
                             fi = format(index);
                         }
                     }
@@ -582,7 +581,7 @@ void Highlighter::htmlJavascript(const QString& text) {
                format the rest of the line as an html code again */
             setFormat(javaEndIndex, text.length() - javaEndIndex, mainFormat);
             setCurrentBlockState(0);
-            progLan = "html";
+            progLan = Language::Html;
             multilineQuote_ = false;
             commentStartExpression = htmlCommetStart;
             commentEndExpression = htmlCommetEnd;
@@ -590,7 +589,7 @@ void Highlighter::htmlJavascript(const QString& text) {
             htmlCSSHighlighter(text, javaEndIndex);
             commentStartExpression = htmlSubcommetStart;
             commentEndExpression = htmlSubcommetEnd;
-            progLan = "javascript";
+            progLan = Language::JavaScript;
             multilineQuote_ = true;
         }
 
@@ -604,7 +603,7 @@ void Highlighter::htmlJavascript(const QString& text) {
     }
 
     /* revert to html */
-    progLan = "html";
+    progLan = Language::Html;
     multilineQuote_ = false;
     commentStartExpression = htmlCommetStart;
     commentEndExpression = htmlCommetEnd;
@@ -422,30 +422,30 @@ void Highlighter::javaMainFormatting(const QString& text) {
         if (rule.format == commentFormat)
             continue;
 
-        QRegularExpressionMatch match;
-        index = text.indexOf(rule.pattern, 0, &match);
+        int matchLength = 0;
+        index = rule.indexIn(text, 0, &matchLength);
         /* skip quotes and all comments */
         if (rule.format != whiteSpaceFormat) {
             fi = format(index);
             while (index >= 0 &&
                    (fi == quoteFormat || fi == urlInsideQuoteFormat || fi == commentFormat || fi == urlFormat ||
                     fi == commentBoldFormat || fi == regexFormat || fi == codeBlockFormat)) {
-                index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                index = rule.indexIn(text, index + matchLength, &matchLength);
                 fi = format(index);
             }
         }
 
         while (index >= 0) {
-            int length = match.capturedLength();
+            int length = matchLength;
             setFormat(index, length, rule.format);
 
-            index = text.indexOf(rule.pattern, index + length, &match);
+            index = rule.indexIn(text, index + length, &matchLength);
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 &&
                        (fi == quoteFormat || fi == urlInsideQuoteFormat || fi == commentFormat || fi == urlFormat ||
                         fi == commentBoldFormat || fi == regexFormat || fi == codeBlockFormat)) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
@@ -246,35 +246,36 @@ void Highlighter::highlightLuaBlock(const QString& text) {
         /*****************
          * Other formats *
          *****************/
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
         for (const HighlightingRule& rule : qAsConst(highlightingRules))
 #endif
         {
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             /* skip all quotes and comments */
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 &&
                        (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                         fi == commentFormat || fi == urlFormat || fi == regexFormat || fi == errorFormat)) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
 
             while (index >= 0) {
-                int length = match.capturedLength();
+                int length = matchLength;
                 setFormat(index, length, rule.format);
-                index = text.indexOf(rule.pattern, index + length, &match);
+                index = rule.indexIn(text, index + length, &matchLength);
 
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 &&
                            (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                             fi == commentFormat || fi == urlFormat || fi == regexFormat || fi == errorFormat)) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
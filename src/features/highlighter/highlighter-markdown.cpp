@@ -95,7 +95,8 @@ void Highlighter::markdownComment(const QString& text) {
         while (format(startIndex) == codeBlockFormat)
             startIndex = text.indexOf(commentStartExpression, startIndex + 1, &startMatch);
         if (startIndex > 0) {
-            if (text.indexOf(QRegularExpression("^#+\\s+.*"), 0) == 0)
+            static const QRegularExpression heading("^#+\\s+.*");
+            if (text.indexOf(heading, 0) == 0)
                 return;  // no comment start sign inside headings
             QRegularExpressionMatch match;
             int indx;
@@ -301,7 +302,7 @@ void Highlighter::markdownFonts(const QString& text) {
         "(?<!\\\\|\\*{2})\\*{3}([^*]|(?:(?<!\\*)\\*))+\\*{3}|(?<!\\\\|_{2})_{3}([^_]|(?:(?<!_)_))+_{3}");
 
     QRegularExpressionMatch expMatch;
-    const QRegularExpression exp(boldExp.pattern() + "|" + italicExp.pattern() + "|" + boldItalicExp.pattern());
+    static const QRegularExpression exp(boldExp.pattern() + "|" + italicExp.pattern() + "|" + boldItalicExp.pattern());
 
     int index = 0;
     while ((index = text.indexOf(exp, index, &expMatch)) > -1) {
@@ -433,33 +434,33 @@ void Highlighter::highlightMarkdownBlock(const QString& text) {
     int bn = currentBlock().blockNumber();
     if (bn >= startCursor.blockNumber() && bn <= endCursor.blockNumber()) {
         data->setHighlighted();  // completely highlighted
-        QRegularExpressionMatch match;
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
         for (const HighlightingRule& rule : qAsConst(highlightingRules))
 #endif
         {
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             if (rule.format != whiteSpaceFormat) {
                 if (currentBlockState() == markdownBlockQuoteState || currentBlockState() == codeBlockState)
                     continue;
                 fi = format(index);
                 while (index >= 0 &&
                        (fi == blockQuoteFormat || fi == codeBlockFormat || fi == commentFormat || fi == urlFormat)) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
 
             while (index >= 0) {
-                setFormat(index, match.capturedLength(), rule.format);
-                index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                setFormat(index, matchLength, rule.format);
+                index = rule.indexIn(text, index + matchLength, &matchLength);
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 && (fi == blockQuoteFormat || fi == codeBlockFormat || fi == commentFormat ||
                                           fi == urlFormat)) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
@@ -83,7 +83,7 @@ bool Highlighter::isPascalMLCommented(const QString& text, const int index, cons
 }
 /*************************/
 void Highlighter::singleLinePascalComment(const QString& text, const int start) {
-    QRegularExpression commentExp("//.*");
+    static const QRegularExpression commentExp("//.*");
     int startIndex = std::max(start, 0);
     startIndex = text.indexOf(commentExp, startIndex);
     /* skip quoted comments */
@@ -7,9 +7,9 @@
 
 namespace Texxy {
 
-QStringList Highlighter::keywords(const QString& lang) {
+QStringList Highlighter::keywords(Language lang) {
     QStringList keywordPatterns;
-    if (lang == "c" || lang == "cpp") {
+    if (lang == Language::C || lang == Language::Cpp) {
         keywordPatterns << "\\b(and|asm|auto)(?!(\\.|-|@|#|\\$))\\b"
                         << "\\b(const|case|catch|cdecl|continue)(?!(\\.|-|@|#|\\$))\\b"
                         << "\\b(break|default|do)(?!(\\.|-|@|#|\\$))\\b"
@@ -18,7 +18,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                         << "\\b(signals|sizeof|static|struct|switch)(?!(\\.|-|@|#|\\$))\\b"
                         << "\\b(typedef|typename|union|volatile|while)(?!(\\.|-|@|#|\\$))\\b";
 
-        if (lang == "c")
+        if (lang == Language::C)
             keywordPatterns << "\\b(FALSE|TRUE)(?!(\\.|-|@|#|\\$))\\b";
         else
             keywordPatterns
@@ -29,8 +29,8 @@ QStringList Highlighter::keywords(const QString& lang) {
                 << "\\b(template|true|this|throw|try|typeid|using|virtual)(?!(\\.|-|@|#|\\$))\\b"
                 << "\\bthis(?=->)\\b";  // "this" can be followed by "->"
     }
-    else if (lang == "sh" || lang == "makefile" ||
-             lang == "cmake")  // the characters "(", ";" and "&" will be reformatted after this
+    else if (lang == Language::Sh || lang == Language::Makefile ||
+             lang == Language::CMake)  // the characters "(", ";" and "&" will be reformatted after this
     {
         keywordPatterns
             << "((^\\s*|[\\(\\);&`\\|{}!=^]+\\s*|(?<=~|\\.)+\\s+)((if|then|elif|elseif|else|fi|while|do|done|esac)\\s+)"
@@ -59,7 +59,7 @@ QStringList Highlighter::keywords(const QString& lang) {
             << "((^\\s*|[\\(\\);&`\\|{}!=^]+\\s*|(?<=~|\\.)+\\s+)((if|then|elif|elseif|else|fi|while|do|done|esac)\\s+)"
                "*)("
                "umask|unalias|unset|until|wait|while)(?!(\\.|-|@|#|\\$))\\b";
-        if (lang == "cmake")  // (?i) is supported by QRegularExpression for ignoring case-sensitivity
+        if (lang == Language::CMake)  // (?i) is supported by QRegularExpression for ignoring case-sensitivity
             keywordPatterns
                 << "(?i)(^\\s*|[\\(\\);&`\\|{}!=^]+\\s*|(?<=~|\\.)+\\s+)(endif|endmacro|endwhile|file|include|option|"
                    "project|"
@@ -89,7 +89,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                    "basic_"
                    "package_version_file)\\s*(?=(\\(|$))";
     }
-    else if (lang == "qmake") {
+    else if (lang == Language::QMake) {
         keywordPatterns
             << "\\b(CONFIG|DEFINES|DEF_FILE|DEPENDPATH|DEPLOYMENT_PLUGIN|DESTDIR|DISTFILES|DLLDESTDIR|FORMS|GUID|"
                "HEADERS|"
@@ -131,7 +131,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                "FILE_"
                "PWD_)(?!(@|#|\\$))\\b";
     }
-    else if (lang == "troff") {
+    else if (lang == Language::Troff) {
         keywordPatterns
             << "^\\.(AT|B|BI|BR|BX|CW|DT|EQ|EN|I|IB|IR|IP|LG|LP|NL|P|PE|PD|PP|PS|R|RI|RB|RS|RE|SH|SM|SB|SS|TH|TS|TE|HP|"
                "TP|"
@@ -141,13 +141,13 @@ QStringList Highlighter::keywords(const QString& lang) {
                "pn|"
                "po|ps|rd|rj|rm|rn|rr|rs|rt|so|sp|ss|sv|sy|ta|tc|ti|tl|tm|tr|uf|ul|vs|wh)(?!(\\.|-|@|#|\\$))\\b";
     }
-    else if (lang == "LaTeX") {
+    else if (lang == Language::LaTeX) {
         keywordPatterns << "(?<!\\\\)\\\\(documentclass|begin|end|usepackage|maketitle|include|includeonly|input|label|"
                            "caption|ref|pageref)(?!(@|#))(_|\\b)"
                         << "(?<!\\\\)\\\\(section|subsection|subsubsection|title|author|part|chapter|paragraph|"
                            "subparagraph)\\*?\\s*\\{[^{}]*\\}";
     }
-    else if (lang == "perl") {
+    else if (lang == Language::Perl) {
         keywordPatterns
             << "\\b(?<!(@|#|%|\\$))(abs|accept|alarm|and|atan2|BEGIN|bind|binmode|bless|break|bytes)(?!(@|#|\\$))\\b"
             << "\\b(?<!(@|#|%|\\$))(caller|chdir|chmod|chown|chroot|chomp|chop|chr|close|closedir|cmp|connect|constant|"
@@ -183,7 +183,7 @@ QStringList Highlighter::keywords(const QString& lang) {
             << "\\b(?<!(@|#|%|\\$))(wait|waitpid|warn|warnings|wantarray|when|while|write|xor)(?!(@|#|\\$))\\b"
             << "\\b(?<!(@|#|%|\\$))__(FILE|LINE|PACKAGE)__";
     }
-    else if (lang == "ruby") {
+    else if (lang == Language::Ruby) {
         keywordPatterns
             << "\\b(__FILE__|__LINE__)(?!(@|#|\\$))\\b"
             << "\\b(alias|and|begin|BEGIN|break)(?!(@|#|\\$))\\b"
@@ -195,13 +195,13 @@ QStringList Highlighter::keywords(const QString& lang) {
             << "\\b(super|self|then|true)(?!(@|#|\\$))\\b"
             << "\\b(undef|unless|until|when|while|yield)(?!(@|#|\\$))\\b";
     }
-    else if (lang == "lua")
+    else if (lang == Language::Lua)
         keywordPatterns << "\\b(and|break|do)(?!(\\.|@|#|\\$))\\b"
                         << "\\b(else|elseif|end)(?!(\\.|@|#|\\$))\\b"
                         << "\\b(false|for|function|goto)(?!(\\.|@|#|\\$))\\b"
                         << "\\b(if|in|local|nil|not|or|repeat|return)(?!(\\.|@|#|\\$))\\b"
                         << "\\b(then|true|until|while)(?!(\\.|@|#|\\$))\\b";
-    else if (lang == "python")
+    else if (lang == Language::Python)
         keywordPatterns
             << "\\b(__debug__|__file__|__name__|and|as|assert|async|await|break|class|continue)(?!(@|\\$))\\b"
             << "\\b(def|del|elif|Ellipsis|else|except|False|finally|for|from|global)(?!(@|\\$))\\b"
@@ -223,7 +223,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                "@|"
                "\\$))\\b"
             << "\\b(exec|print)(?!(@|\\$|\\s*\\())\\b";
-    else if (lang == "javascript" || lang == "qml") {
+    else if (lang == Language::JavaScript || lang == Language::Qml) {
         keywordPatterns << "\\b(?<!(@|#|\\$))(abstract|arguments|await|async|break)(?!(@|#|\\$))\\b"
                         << "\\b(?<!(@|#|\\$))(case|catch|class|const|continue)(?!(@|#|\\$))\\b"
                         << "\\b(?<!(@|#|\\$))(debugger|default|delete|do)(?!(@|#|\\$))\\b"
@@ -235,12 +235,12 @@ QStringList Highlighter::keywords(const QString& lang) {
                         << "\\b(?<!(@|#|\\$))(static|super|switch|synchronized)(?!(@|#|\\$))\\b"
                         << "\\b(?<!(@|#|\\$))(throw|throws|this|transient|true|try|typeof)(?!(@|#|\\$))\\b"
                         << "\\b(?<!(@|#|\\$))(undefined|void|volatile|while|with|yield)(?!(@|#|\\$))\\b";
-        if (lang == "javascript")
+        if (lang == Language::JavaScript)
             keywordPatterns << "\\b(?<!(@|#|\\$))(var)(?!(@|#|\\$))\\b";
-        else if (lang == "qml")
+        else if (lang == Language::Qml)
             keywordPatterns << "\\b(?<!(@|#|\\$))(alias|id|property|readonly|signal)(?!(@|#|\\$))\\b";
     }
-    else if (lang == "php")
+    else if (lang == Language::Php)
         keywordPatterns
             << "\\b(?<!(#|\\$))(__FILE__|__LINE__|__FUNCTION__|__CLASS__|__COMPILER_HALT_OFFSET__|__METHOD__|__"
                "DIR__|__NAMESPACE__|__TRAIT__)(?!(#|\\$))\\b"
@@ -257,7 +257,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                "return)(?!(#|\\$))\\b"
             << "\\b(?<!(#|\\$))(static|string|switch|throw|trait|true|try)(?!(#|\\$))\\b"
             << "\\b(?<!(#|\\$))(unset|use|var|void|while|xor|yield)(?!(#|\\$))\\b";
-    else if (lang == "scss")  // taken from http://sass-lang.com/documentation/Sass/Script/Functions.html
+    else if (lang == Language::Scss)  // taken from http://sass-lang.com/documentation/Sass/Script/Functions.html
         keywordPatterns
             << "\\b(none|null)(?!(\\.|-|@|#|\\$))\\b"
             << "\\b(abs|adjust-color|adjust-hue|alpha|append|blue|call|ceil|change-color|comparable|complement|content-"
@@ -270,7 +270,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                "unify|set-nth|simple-selectors|str-index|str-insert|str-length|str-slice|to-lower-case|to-upper-case|"
                "transparentize|type-of|unit|unitless|unquote|variable-exists|zip)(?=\\()"
             << "\\bunique-id\\(\\s*\\)";
-    else if (lang == "dart")
+    else if (lang == Language::Dart)
         keywordPatterns
             << "\\b(?<!(@|#|\\$))(abstract|as|assert|async|await|break|case|catch|class|const|continue|"
                "covariant|default|deferred|do|dynamic)(?!(@|#|\\$))\\b"
@@ -280,7 +280,7 @@ QStringList Highlighter::keywords(const QString& lang) {
                "super|switch|sync)(?!(@|#|\\$))\\b"
             << "\\b(?<!(@|#|\\$))(this|throw|true|try|typedef|var|void|while|with|yield)(?!(@|#|\\$))\\b"
             << "(?<!(@|#|\\$|\\w))(@pragma|@override|@deprecated)(?!(@|#|\\$))\\b";
-    else if (lang == "pascal")  // case-insensitive
+    else if (lang == Language::Pascal)  // case-insensitive
         keywordPatterns
             << "(?i)\\b(?<!(@|#|\\$))(absolute|abstract|alias|and|array|as|asm|assembler|at|attribute|automated|begin|"
                "bindable|bitpacked|break|case|cdecl|class|const|constructor|continue|cppdecl|cvar|default|deprecated|"
@@ -298,24 +298,24 @@ QStringList Highlighter::keywords(const QString& lang) {
                "resourcestring|reset|restricted|result|rewrite|safecall|saveregisters|self|set|shl|shr|softfloat|"
                "specialize|static|stdcall|stored|strict|then|to|threadvar|true|try|type|unaligned|unimplemented|unit|"
                "unpack|until|uses|var|varargs|virtual|while|winapi|with|write|writeln|xor)(?!(@|#|\\$))\\b";
-    else if (lang == "java")
+    else if (lang == Language::Java)
         keywordPatterns
             << "\\b(abstract|assert|break|case|catch|class|const|while|continue|default|do|else|enum|extends|"
                "final|finally|for|goto|if|implements|import|instanceof|interface|module|native|new|package|"
                "private|protected|public|return|static|strictfp|super|switch|synchronized|this|throw|throws|"
                "transient|try|var|volatile|while)(?!(@|#|\\$))\\b"
             << "\\b(true|false|null)(?!(\\.|-|@|#|\\$))\\b";
-    else if (lang == "go")
+    else if (lang == Language::Go)
         keywordPatterns
             << "\\b(break|case|chan|const|continue|default|defer|else|fallthrough|false|for|func|go|goto|if|import|"
                "interface|iota|map|nil|package|range|return|select|struct|switch|true|type|var)(?!(\\.|-|@|#|\\$))\\b";
-    else if (lang == "rust")
+    else if (lang == Language::Rust)
         keywordPatterns
             << "\\b(?<!(\\\"|@|#|\\$))(abstract|alignof|as|async|await|become|box|break|const|continue|crate|"
                "default|do|dyn|else|enum|extern|final|fn|for|if|impl|in|let|loop|match|macro|mod|move|mut|"
                "offsetof|override|priv|proc|pub|pure|ref|return|sizeof|static|struct|super|trait|try|type|"
                "typeof|union|unsafe|unsized|use|virtual|where|while|yield)(?!(\\\"|'|@|#|\\$))\\b";
-    else if (lang == "tcl")  // backslash should also be taken into account (in a complex way)
+    else if (lang == Language::Tcl)  // backslash should also be taken into account (in a complex way)
         keywordPatterns
             << "(?<!\\\\)(\\\\{2})*(?<!((#|\\$|@|\"|\'|`)(?!\\\\)))(\\\\(#|\\$|@|\"|\'|`)){0,1}\\K\\b("
                "after|append|AppleScript|apply|argc|argv|array|auto_execk|auto_execok|auto_import|auto_load|auto_load_"
@@ -350,51 +350,81 @@ QStringList Highlighter::keywords(const QString& lang) {
                "notebook|panedwindow|progressbar|radiobutton|registry|scale|scrollbar|separator|sizegrip|spinbox|style|"
                "traverseTo|treeview"
                ")(?!(@|#|\\$|\"|\'|`))\\b";
-    else if (lang == "toml")
+    else if (lang == Language::Toml)
         keywordPatterns << "\\b(false|inf|nan|true)(?!(\\.|-|@|#|\\$))\\b";
 
     return keywordPatterns;
 }
 /*************************/
+/* Turns the rules that are plain lists of words (most keywords, types and
+   built-in names) into keyword sets. Adjacent lists with the same format are
+   merged, so that each block is split into identifiers once for all of them;
+   the other rules stay regexes, in their order. */
+void Highlighter::useKeywordSets() {
+    QList<HighlightingRule> rules;
+    QList<KeywordSet::Spec> specs;  // for each rule, with no word if it stays a regex
+    for (int i = 0; i < highlightingRules.size(); ++i) {
+        const HighlightingRule& rule = highlightingRules.at(i);
+        KeywordSet::Spec spec;
+        if (rule.format != commentFormat && rule.format != whiteSpaceFormat &&
+            KeywordSet::parse(rule.pattern.pattern(), spec)) {
+            if (!specs.isEmpty() && !specs.last().words.isEmpty() && rules.last().format == rule.format &&
+                specs.last().notBefore == spec.notBefore && specs.last().notAfter == spec.notAfter) {
+                specs.last().words += spec.words;
+                continue;
+            }
+        }
+        rules.append(rule);
+        specs.append(spec);
+    }
+    for (int i = 0; i < rules.size(); ++i) {
+        if (!specs.at(i).words.isEmpty()) {
+            rules[i].pattern = QRegularExpression();
+            rules[i].keywords = std::make_shared<const KeywordSet>(specs.at(i));
+        }
+    }
+    highlightingRules = rules;
+}
+
 QStringList Highlighter::types() {
     QStringList typePatterns;
-    if (progLan == "c" || progLan == "cpp") {
+    if (progLan == Language::C || progLan == Language::Cpp) {
         typePatterns << "\\b(bool|char|clock_t|double|float|FILE)(?!(\\.|-|@|#|\\$))\\b"
                      << "\\b(gchar|gint|guint(8|16|32|64)?|gboolean)(?!(\\.|-|@|#|\\$))\\b"
                      << "\\b(int(8_t|16_t|32_t|64_t)?|ptrdiff_t|long|short|size_t|ssize_t|time_t)(?!(\\.|-|@|#|\\$))\\b"
                      << "\\b(unsigned|uint(8|16|32|64|8_t|16_t|32_t|64_t)?)(?!(\\.|-|@|#|\\$))\\b"
                      << "\\b(uid_t|gid_t|mode_t)(?!(\\.|-|@|#|\\$))\\b"
                      << "\\b(void|wchar_t|wint_t)(?!(\\.|-|@|#|\\$))\\b";
-        if (progLan == "cpp")
+        if (progLan == Language::Cpp)
             typePatterns << "\\b(qreal|qint8|quint8|qint16|quint16|qint32|quint32|qint64|quint64|qlonglong|qulonglong|"
                             "qptrdiff|quintptr)(?!(\\.|-|@|#|\\$))\\b"
                          << "\\b(uchar|ulong|ushort)(?!(\\.|-|@|#|\\$))\\b"
                          << "\\b(std::[a-z_]+)(?=\\s*\\S+)(?!(\\s*\\(|\\.|-|@|#|\\$))\\b";
     }
-    else if (progLan == "qml") {
+    else if (progLan == Language::Qml) {
         typePatterns
             << "\\b(?<!(@|#|\\$))(bool|double|enumeration|int|list|real|string|url|var|variant)(?!(@|#|\\$))\\b"
             << "\\b(?<!(@|#|\\$))(color|date|font|matrix4x4|point|quaternion|rect|size|vector2d|vector3d|vector4d)"
                "(?!(@|#|\\$))\\b";
     }
-    else if (progLan == "dart") {
+    else if (progLan == Language::Dart) {
         typePatterns << "\\b(?<!(@|#|\\$))(bool|double|int|num)(?!(@|#|\\$))\\b";
     }
-    else if (progLan == "pascal") {
+    else if (progLan == Language::Pascal) {
         typePatterns
             << "(?i)\\b(?<!(@|#|\\$))(ansichar|ansistring|byte|cardinal|char|comp|currency|double|dword|extended|int64|"
                "integer|pointer|qword|qwordbool|real|real48|boolean|bytebool|enumerated|longbool|longint|longword|"
                "shortint|"
                "shortstring|single|smallint|string|text|variant|widechar|widestring|word|wordbool)(?!(@|#|\\$))\\b";
     }
-    else if (progLan == "java") {
+    else if (progLan == Language::Java) {
         typePatterns << "\\b(boolean|byte|char|double|float|int|long|short|void)(?!(\\.|-|@|#|\\$))\\b";
     }
-    else if (progLan == "go") {
+    else if (progLan == Language::Go) {
         typePatterns << "\\b(bool|byte|complex64|complex128|error|float32|float64|int8|int16|int32|int64|uint8|uint16|"
                         "uint32|uint64|int|uint|rune|string|uintptr)(?!(\\.|-|@|#|\\$))\\b";
     }
-    else if (progLan == "rust") {
+    else if (progLan == Language::Rust) {
         typePatterns << "\\b(?<!(\\\"|@|#|\\$))(bool|isize|usize|i8|i16|i32|i64|i128|u8|u16|u32|u64|u128|f32|f64|char|"
                         "str|Option|"
                         "Result|Self|Box|Vec|String|Path|PathBuf|c_float|c_double|c_void|FILE|fpos_t|DIR|dirent|c_char|"
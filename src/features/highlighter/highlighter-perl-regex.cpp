@@ -20,6 +20,7 @@ static const QRegularExpression rExp(
 static const QRegularExpression delimiterExp("[^\\w\\}\\)\\]>\\s]");
 /* "e", "o" and "r" are substitution-specific modifiers. */
 static const QString flags("acdegilmnoprsux");  // previously "sgimx"
+static const QRegularExpression flagsExp("^[" + flags + "]+");
 
 // This is only for the start.
 bool Highlighter::isEscapedPerlRegex(const QString& text, const int pos) {
@@ -497,7 +498,7 @@ void Highlighter::multiLinePerlRegex(const QString& text) {
                     if (getEndDelimiter(startDelimStr) != startDelimStr)  // regex replacement with braces
                     {
                         /* find the start of the replacement part */
-                        startIndex = text.indexOf(QRegularExpression(delimiterExp), endIndex + 1, &startMatch);
+                        startIndex = text.indexOf(delimiterExp, endIndex + 1, &startMatch);
                         if (startIndex == -1) {  // the line ends between search and replacement
                             setFormat(endIndex + 1, text.length() - endIndex - 1, regexFormat);
                             setCurrentBlockState(regexState);
@@ -523,7 +524,7 @@ void Highlighter::multiLinePerlRegex(const QString& text) {
                     if (getEndDelimiter(startDelimStr) != startDelimStr)  // regex replacement with braces
                     {
                         /* find the start of the replacement part */
-                        startIndex = text.indexOf(QRegularExpression(delimiterExp), endIndex + 1, &startMatch);
+                        startIndex = text.indexOf(delimiterExp, endIndex + 1, &startMatch);
                         if (startIndex == -1) {  // the line ends between search and replacement
                             setFormat(endIndex + 1, text.length() - endIndex - 1, regexFormat);
                             setCurrentBlockState(regexState);
@@ -547,7 +548,7 @@ void Highlighter::multiLinePerlRegex(const QString& text) {
         setFormat(startIndex + keywordLength, len - keywordLength, regexFormat);
 
         /* format flags too */
-        if (text.mid(startIndex + len).indexOf(QRegularExpression("^[" + flags + "]+"), 0, &startMatch) == 0)
+        if (text.mid(startIndex + len).indexOf(flagsExp, 0, &startMatch) == 0)
             setFormat(startIndex + len, startMatch.capturedLength(), flagFormat);
 
         /* start searching for a new regex (operator) */
@@ -51,15 +51,20 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
     if (pos < 0)
         return false;
 
-    if (progLan == "html" /* || progLan == "xml"*/)  // xml is formatted separately
+    if (progLan == Language::Html /* || progLan == Language::Xml*/)  // xml is formatted separately
         return false;
 
-    if (progLan == "yaml") {
+    if (progLan == Language::Yaml) {
         if (isStartQuote) {
             if (format(pos) == codeBlockFormat)  // inside a literal block
                 return true;
+            static const QRegularExpression listStart("^(\\s*-\\s)+\\s*");
+            static const QRegularExpression keyInBraces("(^|{|,|\\[)\\s*\\K(?:(?!(\\{|\\[|,|:\\s|\\s#)).)*(:\\s+)?");
+            static const QRegularExpression valueInBraces("(^|{|,|\\[)[^:#]*:\\s+\\K[^{\\[,#\\s][^,#]*");
+            static const QRegularExpression key("^\\s*\\K(?:(?!(\\{|\\[|,|:\\s|\\s#)).)*(:\\s+)?");
+            static const QRegularExpression value("^[^:#]*:\\s+\\K[^\\[\\s#].*");
             QRegularExpressionMatch match;
-            if (text.indexOf(QRegularExpression("^(\\s*-\\s)+\\s*"), 0, &match) == 0) {
+            if (text.indexOf(listStart, 0, &match) == 0) {
                 if (match.capturedLength() == pos)
                     return false;  // a start quote isn't escaped at the beginning of a list
             }
@@ -68,37 +73,32 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
                      because ":" should be followed by a space to make a key-value. */
             if (format(pos) == neutralFormat) {  // inside preformatted braces, when multiLineQuote() is called (not
                                                  // needed; repeated below)
-                int index = text.lastIndexOf(
-                    QRegularExpression("(^|{|,|\\[)\\s*\\K(?:(?!(\\{|\\[|,|:\\s|\\s#)).)*(:\\s+)?"), pos, &match);
+                int index = text.lastIndexOf(keyInBraces, pos, &match);
                 if (index > -1 && index <= pos && index + match.capturedLength() > pos &&
                     isYamlKeyQuote(match.captured(), pos - index)) {
                     return true;
                 }
-                index =
-                    text.lastIndexOf(QRegularExpression("(^|{|,|\\[)[^:#]*:\\s+\\K[^{\\[,#\\s][^,#]*"), pos, &match);
+                index = text.lastIndexOf(valueInBraces, pos, &match);
                 if (index > -1 && index < pos && index + match.capturedLength() > pos)
                     return true;
             }
             else {
                 /* inside braces before preformatting (indirectly used by yamlOpenBraces()) */
-                int index = text.lastIndexOf(
-                    QRegularExpression("(^|{|,|\\[)\\s*\\K(?:(?!(\\{|\\[|,|:\\s|\\s#)).)*(:\\s+)?"), pos, &match);
+                int index = text.lastIndexOf(keyInBraces, pos, &match);
                 if (index > -1 && index <= pos && index + match.capturedLength() > pos &&
                     isYamlKeyQuote(match.captured(), pos - index)) {
                     return true;
                 }
-                index =
-                    text.lastIndexOf(QRegularExpression("(^|{|,|\\[)[^:#]*:\\s+\\K[^{\\[,#\\s][^,#]*"), pos, &match);
+                index = text.lastIndexOf(valueInBraces, pos, &match);
                 if (index > -1 && index < pos && index + match.capturedLength() > pos)
                     return true;
                 /* outside braces */
-                index = text.lastIndexOf(QRegularExpression("^\\s*\\K(?:(?!(\\{|\\[|,|:\\s|\\s#)).)*(:\\s+)?"), pos,
-                                         &match);
+                index = text.lastIndexOf(key, pos, &match);
                 if (index > -1 && index < pos && index + match.capturedLength() > pos &&
                     isYamlKeyQuote(match.captured(), pos - index)) {
                     return true;
                 }
-                index = text.lastIndexOf(QRegularExpression("^[^:#]*:\\s+\\K[^\\[\\s#].*"), pos, &match);
+                index = text.lastIndexOf(value, pos, &match);
                 if (index > -1 && index < pos && index + match.capturedLength() > pos)
                     return true;
             }
@@ -115,7 +115,7 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
             lastEscapedQuote = -1;
         }
     }
-    else if (progLan == "go") {
+    else if (progLan == Language::Go) {
         if (text.at(pos) == '`')
             return false;
         if (isStartQuote) {
@@ -128,7 +128,7 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
         }
         return isEscapedChar(text, pos);
     }
-    else if (progLan == "rust") {
+    else if (progLan == Language::Rust) {
         if (isStartQuote) {
             if (pos < text.length() - 1 && text.at(pos + 1) == '\'' &&
                 (pos > 0 &&
@@ -139,7 +139,7 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
     }
 
     /* there's no need to check for quote marks because this function is used only with them */
-    /*if (progLan == "perl"
+    /*if (progLan == Language::Perl
         && pos != text.indexOf (quoteMark, pos)
         && pos != text.indexOf ("\'", pos)
         && pos != text.indexOf ("`", pos))
@@ -154,25 +154,31 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
 
     /* check if the quote surrounds a here-doc delimiter */
     if ((currentBlockState() >= endState || currentBlockState() < -1) && currentBlockState() % 2 == 0) {
+        static const QRegularExpression rubyDelimStart("<<(-|~){0,1}");
+        static const QRegularExpression perlDelimStart("<<~?\\s*");
+        static const QRegularExpression delimStart("<<\\s*");
+        // in Perl, space is allowed
+        static const QRegularExpression perlDelimEnd(
+            "<<~?(?:\\s*)(\'[A-Za-z0-9_\\s]+)|<<~?(?:\\s*)(\"[A-Za-z0-9_\\s]+)|<<~?(?:\\s*)(`[A-Za-z0-9_\\s]+)");
+        static const QRegularExpression rubyDelimEnd("<<(?:-|~){0,1}(\'[A-Za-z0-9]+)|<<(?:-|~){0,1}(\"[A-Za-z0-9]+)");
+        static const QRegularExpression delimEnd("<<(?:\\s*)(\'[A-Za-z0-9_]+)|<<(?:\\s*)(\"[A-Za-z0-9_]+)");
         QRegularExpressionMatch match;
-        QRegularExpression delimPart(progLan == "ruby" ? "<<(-|~){0,1}" : progLan == "perl" ? "<<~?\\s*" : "<<\\s*");
-        if (text.lastIndexOf(delimPart, pos, &match) == pos - match.capturedLength())
-            return true;        // escaped start quote
-        if (progLan == "perl")  // space is allowed
-            delimPart.setPattern(
-                "<<~?(?:\\s*)(\'[A-Za-z0-9_\\s]+)|<<~?(?:\\s*)(\"[A-Za-z0-9_\\s]+)|<<~?(?:\\s*)(`[A-Za-z0-9_\\s]+)");
-        else if (progLan == "ruby")
-            delimPart.setPattern("<<(?:-|~){0,1}(\'[A-Za-z0-9]+)|<<(?:-|~){0,1}(\"[A-Za-z0-9]+)");
-        else
-            delimPart.setPattern("<<(?:\\s*)(\'[A-Za-z0-9_]+)|<<(?:\\s*)(\"[A-Za-z0-9_]+)");
+        const QRegularExpression& delimPart = progLan == Language::Ruby   ? rubyDelimStart
+                                              : progLan == Language::Perl ? perlDelimStart
+                                                                          : delimStart;
         if (text.lastIndexOf(delimPart, pos, &match) == pos - match.capturedLength())
+            return true;  // escaped start quote
+        const QRegularExpression& delimPartEnd = progLan == Language::Perl   ? perlDelimEnd
+                                                 : progLan == Language::Ruby ? rubyDelimEnd
+                                                                             : delimEnd;
+        if (text.lastIndexOf(delimPartEnd, pos, &match) == pos - match.capturedLength())
             return true;  // escaped end quote
     }
 
     /* escaped start quotes are just for Bash, Perl, markdown and yaml
        (and tcl, for which this function is never called) */
     if (isStartQuote) {
-        if (progLan == "perl") {
+        if (progLan == Language::Perl) {
             if (pos >= 1) {
                 if (text.at(pos - 1) == '$')  // in Perl, $' has a (deprecated?) meaning
                     return true;
@@ -191,7 +197,7 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
             }
             return false;  // no other case of escaping at the start
         }
-        else if (progLan == "c" || progLan == "cpp") {
+        else if (progLan == Language::C || progLan == Language::Cpp) {
             /*if (text.at (pos) == '\''
                 && pos > 0 && text.at (pos - 1).isLetterOrNumber())
             {
@@ -199,12 +205,13 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
             }*/
             return false;
         }
-        else if (progLan != "sh" && progLan != "makefile" && progLan != "cmake" && progLan != "yaml") {
+        else if (progLan != Language::Sh && progLan != Language::Makefile && progLan != Language::CMake &&
+                 progLan != Language::Yaml) {
             return false;
         }
 
-        if (skipCommandSign && text.at(pos) == quoteMark.pattern().at(0) &&
-            text.indexOf(QRegularExpression("[^\"]*\\$\\("), pos) == pos + 1) {
+        static const QRegularExpression commandSign("[^\"]*\\$\\(");
+        if (skipCommandSign && text.at(pos) == quoteMark.pattern().at(0) && text.indexOf(commandSign, pos) == pos + 1) {
             return true;
         }
     }
@@ -213,23 +220,25 @@ bool Highlighter::isEscapedQuote(const QString& text, const int pos, bool isStar
     while (pos - i > 0 && text.at(pos - i - 1) == '\\')
         ++i;
     /* only an odd number of backslashes means that the quote is escaped */
-    if (i % 2 != 0 && (((progLan == "yaml" || progLan == "toml") && text.at(pos) == quoteMark.pattern().at(0))
-                       /* for these languages, both single and double quotes can be escaped (also for perl?) */
-                       || progLan == "c" || progLan == "cpp" || progLan == "javascript" || progLan == "qml" ||
-                       progLan == "python" || progLan == "perl" || progLan == "dart" || progLan == "php" ||
-                       progLan == "ruby"
-                       /* rust only has double quotes */
-                       || progLan == "rust"
-                       /* however, in Bash, single quote can be escaped only at start */
-                       || ((progLan == "sh" || progLan == "makefile" || progLan == "cmake") &&
-                           (isStartQuote || text.at(pos) == quoteMark.pattern().at(0))))) {
+    if (i % 2 != 0 &&
+        (((progLan == Language::Yaml || progLan == Language::Toml) && text.at(pos) == quoteMark.pattern().at(0))
+         /* for these languages, both single and double quotes can be escaped (also for perl?) */
+         || progLan == Language::C || progLan == Language::Cpp || progLan == Language::JavaScript ||
+         progLan == Language::Qml || progLan == Language::Python || progLan == Language::Perl ||
+         progLan == Language::Dart || progLan == Language::Php || progLan == Language::Ruby
+         /* rust only has double quotes */
+         || progLan == Language::Rust
+         /* however, in Bash, single quote can be escaped only at start */
+         || ((progLan == Language::Sh || progLan == Language::Makefile || progLan == Language::CMake) &&
+             (isStartQuote || text.at(pos) == quoteMark.pattern().at(0))))) {
         return true;
     }
 
-    if (progLan == "ruby" &&
+    if (progLan == Language::Ruby &&
         text.at(pos) == quoteMark.pattern().at(0)) {  // a minimal support for command substitution "#{...}"
+        static const QRegularExpression commandSubstitution("#\\{[^\\}]*");
         QRegularExpressionMatch match;
-        int index = text.lastIndexOf(QRegularExpression("#\\{[^\\}]*"), pos, &match);
+        int index = text.lastIndexOf(commandSubstitution, pos, &match);
         if (index > -1 && index < pos && index + match.capturedLength() > pos)
             return true;
     }
@@ -244,13 +253,13 @@ bool Highlighter::isQuoted(const QString& text, const int index, bool skipComman
     if (!hasQuotes_)
         return false;
 
-    if (progLan == "perl" || progLan == "ruby")
+    if (progLan == Language::Perl || progLan == Language::Ruby)
         return isPerlQuoted(text, index);
-    if (progLan == "javascript" || progLan == "qml")
+    if (progLan == Language::JavaScript || progLan == Language::Qml)
         return isJSQuoted(text, index);
-    if (progLan == "tcl")
+    if (progLan == Language::Tcl)
         return isTclQuoted(text, index, start);
-    if (progLan == "rust")
+    if (progLan == Language::Rust)
         return isRustQuoted(text, index, start);
 
     if (index < 0 || start < 0 || index < start)
@@ -279,7 +288,8 @@ bool Highlighter::isQuoted(const QString& text, const int index, bool skipComman
                     prevState == SH_MixedDoubleQuoteState || prevState == htmlStyleDoubleQuoteState) {
                     quoteExpression = quoteMark;
                     if (skipCommandSign) {
-                        if (text.indexOf(QRegularExpression("[^\"]*\\$\\("), 0) == 0) {
+                        static const QRegularExpression commandSign("[^\"]*\\$\\(");
+                        if (text.indexOf(commandSign, 0) == 0) {
                             N = 0;
                             res = false;
                         }
@@ -668,7 +678,7 @@ void Highlighter::multiLineJSQuote(const QString& text, const int start, int com
         int quoteLength;
         if (endIndex == -1) {
             /* In JS, multiline double and single quotes need backslash. */
-            if ((quoteExpression == singleQuoteMark || (quoteExpression == quoteMark && progLan != "qml")) &&
+            if ((quoteExpression == singleQuoteMark || (quoteExpression == quoteMark && progLan != Language::Qml)) &&
                 !textEndsWithBackSlash(text)) {  // see NOTE of isEscapedRegex() and also the end of multiLineRegex()
                 setCurrentBlockState(regexExtraState);
             }
@@ -719,15 +729,15 @@ bool Highlighter::textEndsWithBackSlash(const QString& text) const {
 // whose default is "commentState" but may be different for some languages.
 // Sometimes (with multi-language docs), formatting should be started from "start".
 bool Highlighter::multiLineQuote(const QString& text, const int start, int comState) {
-    if (progLan == "perl" || progLan == "ruby") {
+    if (progLan == Language::Perl || progLan == Language::Ruby) {
         multiLinePerlQuote(text);
         return false;
     }
-    if (progLan == "javascript" || progLan == "qml") {
+    if (progLan == Language::JavaScript || progLan == Language::Qml) {
         multiLineJSQuote(text, start, comState);
         return false;
     }
-    if (progLan == "rust") {
+    if (progLan == Language::Rust) {
         multiLineRustQuote(text);
         return false;
     }
@@ -738,7 +748,7 @@ bool Highlighter::multiLineQuote(const QString& text, const int start, int comSt
     bool rehighlightNextBlock = false;
     QString delimStr;
     TextBlockData* cppData = nullptr;
-    if (progLan == "cpp") {
+    if (progLan == Language::Cpp) {
         cppData = static_cast<TextBlockData*>(currentBlock().userData());
         QTextBlock prevBlock = currentBlock().previous();
         if (prevBlock.isValid()) {
@@ -774,7 +784,7 @@ bool Highlighter::multiLineQuote(const QString& text, const int start, int comSt
             if (mixedQuotes_) {
                 /* ... distinguish between double and single quotes */
                 if (text.at(index) == quoteMark.pattern().at(0)) {
-                    if (progLan == "cpp" && index > start) {
+                    if (progLan == Language::Cpp && index > start) {
                         QRegularExpressionMatch cppMatch;
                         if (text.at(index - 1) == 'R' &&
                             index - 1 == text.indexOf(cppLiteralStart, index - 1, &cppMatch)) {
@@ -811,7 +821,7 @@ bool Highlighter::multiLineQuote(const QString& text, const int start, int comSt
             /* ... distinguish between double and single quotes
                again because the quote mark may have changed */
             if (text.at(index) == quoteMark.pattern().at(0)) {
-                if (progLan == "cpp" && index > start) {
+                if (progLan == Language::Cpp && index > start) {
                     QRegularExpressionMatch cppMatch;
                     if (text.at(index - 1) == 'R' && index - 1 == text.indexOf(cppLiteralStart, index - 1, &cppMatch)) {
                         delimStr = ")" + cppMatch.captured(1);
@@ -848,7 +858,7 @@ bool Highlighter::multiLineQuote(const QString& text, const int start, int comSt
         }
 
         if (endIndex == -1) {
-            if (progLan == "c" || progLan == "cpp") {
+            if (progLan == Language::C || progLan == Language::Cpp) {
                 /* In c and cpp, multiline double quotes need backslash and
                    there's no multiline single quote. Moreover, In C++11,
                    there can be multiline raw string literals. */
@@ -857,7 +867,7 @@ bool Highlighter::multiLineQuote(const QString& text, const int start, int comSt
                     endIndex = text.length();
                 }
             }
-            else if (progLan == "go") {
+            else if (progLan == Language::Go) {
                 if (quoteExpression == quoteMark)  // no multiline double quote
                     endIndex = text.length();
             }
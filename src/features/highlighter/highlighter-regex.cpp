@@ -13,7 +13,7 @@ static const QRegularExpression regexEndExp("/[A-Za-z0-9_]*");
 bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
     if (pos < 0)
         return false;
-    if (progLan != "javascript" && progLan != "qml")
+    if (progLan != Language::JavaScript && progLan != Language::Qml)
         return false;
 
     if (format(pos) == quoteFormat || format(pos) == altQuoteFormat || format(pos) == commentFormat ||
@@ -28,14 +28,16 @@ bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
     /* escape "<.../>", "</...>", the single-line comment sign
        and the start multiline comment sign
        FIXME: In this way and with what follows, "/>/g" isn't highlighted. */
-    if ((text.length() > pos + 1 && ((progLan == "javascript" && text.at(pos + 1) == '>') || text.at(pos + 1) == '/' ||
-                                     text.at(pos + 1) == '*')) ||
-        (pos > 0 && progLan == "javascript" && text.at(pos - 1) == '<')) {
+    if ((text.length() > pos + 1 &&
+         ((progLan == Language::JavaScript && text.at(pos + 1) == '>') || text.at(pos + 1) == '/' ||
+          text.at(pos + 1) == '*')) ||
+        (pos > 0 && progLan == Language::JavaScript && text.at(pos - 1) == '<')) {
         return true;
     }
 
     QRegularExpressionMatch keyMatch;
     static QRegularExpression jsKeys, qmlKeys;
+    static const QRegularExpression slashedWord("/\\w+");
 
     int i = pos - 1;
     while (i >= 0 && (text.at(i) == ' ' || text.at(i) == '\t'))
@@ -51,7 +53,7 @@ bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
         if (!prev.isValid())
             return false;
         QString txt = prev.text();
-        QRegularExpression nonSpace("[^\\s]+");
+        static const QRegularExpression nonSpace("[^\\s]+");
         while (txt.indexOf(nonSpace, 0) == -1) {
             if (prev.userState() ==
                 regexExtraState) {  // a quoted line with only witespaces (backslashed mutil-line quote)
@@ -82,11 +84,11 @@ bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
                 || ch == ')' || ch == ']' || ch == '$' || ch == '\"' || ch == '\'' ||
                 ch == '`'
                 /* also skip "/>" */
-                || (last > 0 && ch == '>' && txt.at(last - 1) == '/' && progLan == "javascript")) {
+                || (last > 0 && ch == '>' && txt.at(last - 1) == '/' && progLan == Language::JavaScript)) {
                 return true;
             }
             if (ch.isLetter()) {  // a regex isn't escaped if it follows a JavaScript keyword
-                if (progLan == "javascript") {
+                if (progLan == Language::JavaScript) {
                     if (jsKeys.pattern().isEmpty())
                         jsKeys.setPattern(keywords(progLan).join('|'));
                 }
@@ -97,7 +99,7 @@ bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
                 int len = std::min(12, last + 1);
                 QString str = txt.mid(last - len + 1, len);
                 int j;
-                if ((j = str.lastIndexOf(progLan == "javascript" ? jsKeys : qmlKeys, -1, &keyMatch)) > -1 &&
+                if ((j = str.lastIndexOf(progLan == Language::JavaScript ? jsKeys : qmlKeys, -1, &keyMatch)) > -1 &&
                     j + keyMatch.capturedLength() == len) {
                     return false;
                 }
@@ -113,17 +115,17 @@ bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
             ch == ')' || ch == ']' || ch == '$' || ch == '\"' || ch == '\'' ||
             ch == '`'
             /* also skip "/>" */
-            || (i > 0 && ch == '>' && text.at(i - 1) == '/' && progLan == "javascript")) {
+            || (i > 0 && ch == '>' && text.at(i - 1) == '/' && progLan == Language::JavaScript)) {
             return true;
         }
         if (ch.isLetterOrNumber() || ch == '_') {
             int j;
-            if ((j = text.lastIndexOf(QRegularExpression("/\\w+"), i + 1, &keyMatch)) > -1 &&
+            if ((j = text.lastIndexOf(slashedWord, i + 1, &keyMatch)) > -1 &&
                 j + keyMatch.capturedLength() == i + 1 && format(j) == regexFormat) {
                 return false;
             }
             if (ch.isLetter()) {
-                if (progLan == "javascript") {
+                if (progLan == Language::JavaScript) {
                     if (jsKeys.pattern().isEmpty())
                         jsKeys.setPattern(keywords(progLan).join('|'));
                 }
@@ -133,7 +135,7 @@ bool Highlighter::isEscapedRegex(const QString& text, const int pos) {
                 }
                 int len = std::min(12, i + 1);
                 QString str = text.mid(i - len + 1, len);
-                if ((j = str.lastIndexOf(progLan == "javascript" ? jsKeys : qmlKeys, -1, &keyMatch)) > -1 &&
+                if ((j = str.lastIndexOf(progLan == Language::JavaScript ? jsKeys : qmlKeys, -1, &keyMatch)) > -1 &&
                     j + keyMatch.capturedLength() == len) {
                     return false;
                 }
@@ -168,14 +170,14 @@ bool Highlighter::isEscapedRegexEndSign(const QString& text, const int start, co
 // For faster processing with very long lines, this function also highlights regex patterns.
 // (It should be used with care because it gives correct results only in special places.)
 bool Highlighter::isInsideRegex(const QString& text, const int index) {
-    if (progLan == "perl")
+    if (progLan == Language::Perl)
         return isInsidePerlRegex(text, index);
-    if (progLan == "ruby")
+    if (progLan == Language::Ruby)
         return isInsideRubyRegex(text, index);
 
     if (index < 0)
         return false;
-    if (progLan != "javascript" && progLan != "qml")
+    if (progLan != Language::JavaScript && progLan != Language::Qml)
         return false;
 
     int pos = -1;
@@ -265,18 +267,18 @@ bool Highlighter::isInsideRegex(const QString& text, const int index) {
 }
 /*************************/
 void Highlighter::multiLineRegex(const QString& text, const int index) {
-    if (progLan == "perl") {
+    if (progLan == Language::Perl) {
         multiLinePerlRegex(text);
         return;
     }
-    if (progLan == "ruby") {
+    if (progLan == Language::Ruby) {
         multiLineRubyRegex(text);
         return;
     }
 
     if (index < 0)
         return;
-    if (progLan != "javascript" && progLan != "qml")
+    if (progLan != Language::JavaScript && progLan != Language::Qml)
         return;
 
     int prevState = previousBlockState();
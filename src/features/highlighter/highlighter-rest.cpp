@@ -4,6 +4,8 @@
 
 namespace Texxy {
 
+static const QRegularExpression nonSpace("\\S");
+
 void Highlighter::reSTMainFormatting(int start, const QString& text) {
     if (start < 0)
         return;
@@ -13,32 +15,32 @@ void Highlighter::reSTMainFormatting(int start, const QString& text) {
 
     data->setHighlighted();  // completely highlighted
     QTextCharFormat fi;
-    QRegularExpressionMatch match;
+    int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
     for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
     for (const HighlightingRule& rule : qAsConst(highlightingRules))
 #endif
     {
-        int index = text.indexOf(rule.pattern, start, &match);
+        int index = rule.indexIn(text, start, &matchLength);
         if (rule.format != whiteSpaceFormat) {
             fi = format(index);
             while (index >= 0 && fi != mainFormat) {
-                index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                index = rule.indexIn(text, index + matchLength, &matchLength);
                 fi = format(index);
             }
         }
         while (index >= 0) {
             /* get the overwritten format if existent */
-            QTextCharFormat prevFormat = format(index + match.capturedLength() - 1);
+            QTextCharFormat prevFormat = format(index + matchLength - 1);
 
-            setFormat(index, match.capturedLength(), rule.format);
-            if (rule.pattern == QRegularExpression(":[\\w\\-+]+:`[^`]*`")) {  // format the reference start too
+            setFormat(index, matchLength, rule.format);
+            if (rule.pattern.pattern() == QLatin1String(":[\\w\\-+]+:`[^`]*`")) {  // format the reference start too
                 QTextCharFormat boldFormat = neutralFormat;
                 boldFormat.setFontWeight(QFont::Bold);
                 setFormat(index, text.indexOf(":`", index) - index + 1, boldFormat);
             }
-            index += match.capturedLength();
+            index += matchLength;
 
             if (rule.format != whiteSpaceFormat &&
                 prevFormat != mainFormat) {  // if a format is overwriiten by this rule, reformat from here
@@ -47,11 +49,11 @@ void Highlighter::reSTMainFormatting(int start, const QString& text) {
                 break;
             }
 
-            index = text.indexOf(rule.pattern, index, &match);
+            index = rule.indexIn(text, index, &matchLength);
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 && fi != mainFormat) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
@@ -97,7 +99,7 @@ void Highlighter::highlightReSTBlock(const QString& text) {
     else if (text.indexOf(codeBlockStart2) == 0) {
         bool isCommented(false);
         if (previousBlockState() >= endState || previousBlockState() < -1) {
-            int spaces = text.indexOf(QRegularExpression("\\S"));
+            int spaces = text.indexOf(nonSpace);
             if (spaces > 0) {
                 if (TextBlockData* prevData = static_cast<TextBlockData*>(prevBlock.userData())) {
                     QString prevLabel = prevData->labelInfo();
@@ -131,7 +133,7 @@ void Highlighter::highlightReSTBlock(const QString& text) {
                     (!prevLabel.startsWith("c") && text.startsWith(prevLabel))) {  // not a commnt but a code line
                     isCodeLine = true;
                     if (prevLabel.isEmpty()) {  // the code block was started or kept in the previous line
-                        int spaces = text.indexOf(QRegularExpression("\\S"));
+                        int spaces = text.indexOf(nonSpace);
                         if (spaces == -1)  // spaces only keep the code block
                             setCurrentBlockState(codeBlockState);
                         else {  // a code line
@@ -169,7 +171,7 @@ void Highlighter::highlightReSTBlock(const QString& text) {
                 /* remember the starting spaces (which consists of 3 spaces at least)
                     but add a "c" to its beginning to distinguish it from a code block */
                 QString spaceStr;
-                int spaces = text.indexOf(QRegularExpression("\\S"));
+                int spaces = text.indexOf(nonSpace);
                 if (spaces == -1)
                     spaceStr = "c   ";
                 else
@@ -185,7 +187,7 @@ void Highlighter::highlightReSTBlock(const QString& text) {
     /* now, everything depends on the previous block */
     else if (prevBlock.isValid()) {
         if (previousBlockState() == codeBlockState) {  // the code block was started or kept in the previous line
-            int spaces = text.indexOf(QRegularExpression("\\S"));
+            int spaces = text.indexOf(nonSpace);
             if (text.isEmpty() || spaces == -1)  // spaces only keep the code block
                 setCurrentBlockState(codeBlockState);
             else {  // a code line
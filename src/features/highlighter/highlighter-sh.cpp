@@ -420,7 +420,7 @@ bool Highlighter::SH_CmndSubstVar(const QString& text,
                                   TextBlockData* currentBlockData,
                                   int oldOpenNests,
                                   const QSet<int>& oldOpenQuotes) {
-    if (progLan != QLatin1String("sh") || !currentBlockData)
+    if (progLan != Language::Sh || !currentBlockData)
         return false;
 
     const int prevState = previousBlockState();
@@ -153,7 +153,7 @@ void Highlighter::highlightTclBlock(const QString& text) {
     int bn = currentBlock().blockNumber();
     if (bn >= startCursor.blockNumber() && bn <= endCursor.blockNumber()) {
         data->setHighlighted();
-        QRegularExpressionMatch match;
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
@@ -163,28 +163,28 @@ void Highlighter::highlightTclBlock(const QString& text) {
             if (rule.format == commentFormat)
                 continue;
 
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 &&
                        (fi == quoteFormat || fi == urlInsideQuoteFormat || fi == commentFormat || fi == urlFormat ||
                         fi == altQuoteFormat))  // backslash should be ignored inside ${...}
                 {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
 
             while (index >= 0) {
-                int length = match.capturedLength();
+                int length = matchLength;
                 setFormat(index, length, rule.format);
-                index = text.indexOf(rule.pattern, index + length, &match);
+                index = rule.indexIn(text, index + length, &matchLength);
 
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 && (fi == quoteFormat || fi == urlInsideQuoteFormat || fi == commentFormat ||
                                           fi == urlFormat || fi == altQuoteFormat)) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
@@ -4,6 +4,8 @@
  */
 
 #include "highlighter.h"
+#include "highlightworker.h"
+#include "regexcache.h"
 
 #include <QTextDocument>
 
@@ -14,6 +16,7 @@ namespace Texxy {
 
 /*************************/
 Highlighter::~Highlighter() {
+    delete worker_;  // before the document stops being highlighted
     if (QTextDocument* doc = document()) {
         QTextOption opt = doc->defaultTextOption();
         opt.setFlags(opt.flags() & ~QTextOption::ShowTabsAndSpaces & ~QTextOption::ShowLineAndParagraphSeparators &
@@ -55,8 +58,8 @@ void Highlighter::setFormatWithoutOverwrite(int start,
 // Check if the current block is inside a "here document" and format it accordingly.
 // (Open quotes aren't taken into account when they happen after the start delimiter.)
 bool Highlighter::isHereDocument(const QString& text) {
-    /*if (progLan != "sh" && progLan != "makefile" && progLan != "cmake"
-        && progLan != "perl" && progLan != "ruby")
+    /*if (progLan != Language::Sh && progLan != Language::Makefile && progLan != Language::CMake
+        && progLan != Language::Perl && progLan != Language::Ruby)
     {
         return false;
         // "<<([A-Za-z0-9_]+)|<<(\'[A-Za-z0-9_]+\')|<<(\"[A-Za-z0-9_]+\")"
@@ -76,15 +79,15 @@ bool Highlighter::isHereDocument(const QString& text) {
         int pos = 0;
         QRegularExpressionMatch match;
         while ((pos = text.indexOf(hereDocDelimiter, pos, &match)) >= 0 &&
-               (isQuoted(text, pos, progLan == "sh")  // escaping start double quote before "$("
-                || (progLan == "perl" && isInsideRegex(text, pos))))
+               (isQuoted(text, pos, progLan == Language::Sh)  // escaping start double quote before "$("
+                || (progLan == Language::Perl && isInsideRegex(text, pos))))
 
         {
             pos += match.capturedLength();
         }
         if (pos >= 0) {
             int insideCommentPos;
-            if (progLan == "sh") {
+            if (progLan == Language::Sh) {
                 static const QRegularExpression commentSH("^#.*|\\s+#.*");
                 insideCommentPos = text.indexOf(commentSH);
             }
@@ -92,8 +95,9 @@ bool Highlighter::isHereDocument(const QString& text) {
                 static const QRegularExpression commentOthers("#.*");
                 insideCommentPos = text.indexOf(commentOthers);
             }
-            if (insideCommentPos == -1 || pos < insideCommentPos || isQuoted(text, insideCommentPos, progLan == "sh") ||
-                (progLan == "perl" &&
+            if (insideCommentPos == -1 || pos < insideCommentPos ||
+                isQuoted(text, insideCommentPos, progLan == Language::Sh) ||
+                (progLan == Language::Perl &&
                  isInsideRegex(text, insideCommentPos))) {  // the delimiter isn't (single-)commented out
                 int i = 1;
                 while ((delimStr = match.captured(i)).isEmpty() && i <= 3) {
@@ -101,7 +105,7 @@ bool Highlighter::isHereDocument(const QString& text) {
                     delimStr = match.captured(i);
                 }
 
-                if (progLan == "perl") {
+                if (progLan == Language::Perl) {
                     if (delimStr.contains('`'))  // Perl's delimiter can have backquotes
                         delimStr = delimStr.split('`').at(1);
                 }
@@ -120,7 +124,7 @@ bool Highlighter::isHereDocument(const QString& text) {
                 if (!delimStr.isEmpty()) {
                     setFormat(text.indexOf(delimStr, pos), delimStr.length(), delimFormat);
 
-                    if (progLan == "sh") {
+                    if (progLan == Language::Sh) {
                         /* skip double-parenthesis constructs */
                         static const QRegularExpression dpc("(^\\s*|\\$|[\\);&`\\|]\\s*)\\(\\(.+\\)\\)");
                         int index = text.lastIndexOf(dpc, pos, &match);
@@ -142,7 +146,7 @@ bool Highlighter::isHereDocument(const QString& text) {
                     }
                     int n = static_cast<int>(qHash(delimStr));
                     int state = 2 * (n + (n >= 0 ? endState / 2 + 1 : 0));  // always an even number but maybe negative
-                    if (progLan == "sh") {
+                    if (progLan == Language::Sh) {
                         if (isQuoted(text, pos,
                                      false)) {  // to know whether a double quote is added/removed before "$(" in the
                                                 // current line
@@ -177,14 +181,14 @@ bool Highlighter::isHereDocument(const QString& text) {
 
         delimStr = prevData->labelInfo();
         int l = 0;
-        if (progLan == "perl" || progLan == "ruby") {
+        if (progLan == Language::Perl || progLan == Language::Ruby) {
             QRegularExpressionMatch rMatch;
             /* the terminating string must appear on a line by itself */
-            QRegularExpression r("^\\s*" + delimStr + "(?=\\s*$)");
+            const QRegularExpression r = RegexCache::get("^\\s*" + delimStr + "(?=\\s*$)");
             if (text.indexOf(r, 0, &rMatch) == 0)
                 l = rMatch.capturedLength();
         }
-        else  // if (progLan == "sh")
+        else  // if (progLan == Language::Sh)
         {
             if (!delimStr.startsWith("-")) {
                 if (text == delimStr)
@@ -192,7 +196,7 @@ bool Highlighter::isHereDocument(const QString& text) {
             }
             else if (delimStr.length() > 1) {  // the here-doc started with "<<-"
                 QString tmp = delimStr.sliced(1);
-                QRegularExpression r("^\\t*" + tmp + "$");
+                const QRegularExpression r = RegexCache::get("^\\t*" + tmp + "$");
                 QRegularExpressionMatch rMatch;
                 if (text.indexOf(r, 0, &rMatch) == 0)
                     l = rMatch.capturedLength();
@@ -258,13 +262,16 @@ void Highlighter::debControlFormatting(const QString& text) {
         return;
     bool formatFurther(false);
     QRegularExpressionMatch expMatch;
-    QRegularExpression exp;
+    static const QRegularExpression fieldStart("^[^\\s:]+:(?=\\s*)");
+    static const QRegularExpression fieldName("^[^\\s:]+(?=:)");
+    static const QRegularExpression leadingSpaces("^\\s+");
+    static const QRegularExpression parentheses("\\([^\\(\\)\\[\\]]+\\)|\\[[^\\(\\)\\[\\]]+\\]");
+    static const QRegularExpression rel("<|>|\\=|~");
     int indx = 0;
     QTextCharFormat debFormat;
-    if (text.indexOf(QRegularExpression("^[^\\s:]+:(?=\\s*)")) == 0) {
+    if (text.indexOf(fieldStart) == 0) {
         formatFurther = true;
-        exp.setPattern("^[^\\s:]+(?=:)");
-        if (text.indexOf(exp, 0, &expMatch) == 0) {
+        if (text.indexOf(fieldName, 0, &expMatch) == 0) {
             /* before ":" */
             debFormat.setFontWeight(QFont::Bold);
             debFormat.setForeground(DarkBlue);
@@ -284,7 +291,7 @@ void Highlighter::debControlFormatting(const QString& text) {
             }
         }
     }
-    else if (text.indexOf(QRegularExpression("^\\s+")) == 0) {
+    else if (text.indexOf(leadingSpaces) == 0) {
         formatFurther = true;
         debFormat.setForeground(DarkGreenAlt);
         setFormat(0, text.size(), debFormat);
@@ -292,17 +299,15 @@ void Highlighter::debControlFormatting(const QString& text) {
 
     if (formatFurther) {
         /* parentheses and brackets */
-        exp.setPattern("\\([^\\(\\)\\[\\]]+\\)|\\[[^\\(\\)\\[\\]]+\\]");
         int index = indx;
         debFormat = neutralFormat;
         debFormat.setFontItalic(true);
-        while ((index = text.indexOf(exp, index, &expMatch)) > -1) {
+        while ((index = text.indexOf(parentheses, index, &expMatch)) > -1) {
             int ml = expMatch.capturedLength();
             setFormat(index, ml, neutralFormat);
             if (ml > 2) {
                 setFormat(index + 1, ml - 2, debFormat);
 
-                QRegularExpression rel("<|>|\\=|~");
                 int i = index;
                 while ((i = text.indexOf(rel, i)) > -1 && i < index + ml - 1) {
                     QTextCharFormat relFormat;
@@ -615,14 +615,14 @@ void Highlighter::highlightXmlBlock(const QString& text) {
 
     if (mainFormatting) {
         data->setHighlighted();  // completely highlighted
-        QRegularExpressionMatch match;
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
         for (const HighlightingRule& rule : qAsConst(highlightingRules))
 #endif
         {
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             fi = format(index);
             /* skip quotes and comments (and errors and correct ampersands inside quotes) */
             if (rule.format != whiteSpaceFormat && rule.format != urlFormat) {
@@ -631,26 +631,26 @@ void Highlighter::highlightXmlBlock(const QString& text) {
                         fi == errorFormat
                         // don't format attributes inside values
                         || (rule.format.foreground().color() == Blue && fi == neutralFormat))) {
-                    index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                    index = rule.indexIn(text, index + matchLength, &matchLength);
                     fi = format(index);
                 }
             }
 
             while (index >= 0) {
-                int length = match.capturedLength();
+                int length = matchLength;
                 if (rule.format == urlFormat && (fi == quoteFormat || fi == altQuoteFormat)) {  // urls inside quotes
                     setFormat(index, length, urlInsideQuoteFormat);
                 }
                 else
                     setFormat(index, length, rule.format);
-                index = text.indexOf(rule.pattern, index + length, &match);
+                index = rule.indexIn(text, index + length, &matchLength);
 
                 fi = format(index);
                 if (rule.format != whiteSpaceFormat && rule.format != urlFormat) {
                     while (index >= 0 &&
                            (fi == quoteFormat || fi == altQuoteFormat || fi == commentFormat || fi == regexFormat ||
                             fi == errorFormat || (rule.format.foreground().color() == Blue && fi == neutralFormat))) {
-                        index = text.indexOf(rule.pattern, index + match.capturedLength(), &match);
+                        index = rule.indexIn(text, index + matchLength, &matchLength);
                         fi = format(index);
                     }
                 }
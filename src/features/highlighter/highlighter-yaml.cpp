@@ -1,6 +1,7 @@
 // src/features/highlighter/highlighter-yaml.cpp
 
 #include "highlighter.h"
+#include "regexcache.h"
 
 #include <algorithm>
 
@@ -10,14 +11,16 @@ namespace Texxy {
 static inline bool isYamlBraceEscaped(const QString& text, const QRegularExpression& start, int pos) {
     if (pos < 0 || text.indexOf(start, pos) != pos)
         return false;
-    int indx = text.lastIndexOf(QRegularExpression("(^|{|,|\\[)?[^:#]*:\\s+\\K"), pos);  // the last key
+    static const QRegularExpression lastKey("(^|{|,|\\[)?[^:#]*:\\s+\\K");
+    static const QRegularExpression valueStart("^[^{\\[#\\s]");
+    int indx = text.lastIndexOf(lastKey, pos);  // the last key
     if (indx > -1) {
         QString txt = text.right(text.size() - indx);
-        if (txt.indexOf(QRegularExpression("^[^{\\[#\\s]")) > -1)  // inside value
+        if (txt.indexOf(valueStart) > -1)  // inside value
             return true;
     }
     QRegularExpressionMatch match;
-    indx = text.lastIndexOf(QRegularExpression("[^:#\\s{\\[]+\\s*" + start.pattern() + "[^:#]*:\\s+"), pos, &match);
+    indx = text.lastIndexOf(RegexCache::get("[^:#\\s{\\[]+\\s*" + start.pattern() + "[^:#]*:\\s+"), pos, &match);
     if (indx > -1 && indx < pos && indx + match.capturedLength() > pos)  // inside key
         return true;
     return false;
@@ -50,7 +53,7 @@ bool Highlighter::yamlOpenBraces(const QString& text,
         }
     }
 
-    QRegularExpression mixed(startExp.pattern() + "|" + endExp.pattern());
+    const QRegularExpression mixed = RegexCache::get(startExp.pattern() + "|" + endExp.pattern());
     int indx = -1, startIndx = 0;
     int txtL = text.length();
     QRegularExpressionMatch match;
@@ -116,10 +119,11 @@ void Highlighter::yamlLiteralBlock(const QString& text) {
         }
     }
 
+    static const QRegularExpression leadingSpaces("^\\s*");
     QRegularExpressionMatch match;
     if (previousBlockState() == codeBlockState)  // the literal block may continue
     {
-        (void)text.indexOf(QRegularExpression("^\\s*"), 0, &match);
+        (void)text.indexOf(leadingSpaces, 0, &match);
         QString startingSpaces = "i" + match.captured();
         if (text == match.captured()  // only whitespaces...
             /* ... or the indentation is wider than that of the literal block */
@@ -138,12 +142,14 @@ void Highlighter::yamlLiteralBlock(const QString& text) {
     int index = text.indexOf(yamlBlockStartExp, 0);
     if (index >= 0) {
         if (text.contains(yamlKey)) {  // consider the list sign as a space if the block is a value
-            (void)text.indexOf(QRegularExpression("^\\s*(-\\s)?\\s*"), 0, &match);
+            static const QRegularExpression listSpaces("^\\s*(-\\s)?\\s*");
+            (void)text.indexOf(listSpaces, 0, &match);
         }
         else {
-            if (text.indexOf(QRegularExpression("^\\s*-\\s")) == -1)
+            static const QRegularExpression listStart("^\\s*-\\s");
+            if (text.indexOf(listStart) == -1)
                 return;  // if the block isn't a value, it should be a list
-            (void)text.indexOf(QRegularExpression("^\\s*"), 0, &match);
+            (void)text.indexOf(leadingSpaces, 0, &match);
         }
         setCurrentBlockState(codeBlockState);
         data->insertInfo("i" + match.captured().replace("-", " "));
@@ -189,7 +195,11 @@ void Highlighter::highlightYamlBlock(const QString& text) {
             }
         }
     }
-    if (text.indexOf(QRegularExpression("^---")) == 0)  // pass the data
+    static const QRegularExpression braceStart("{");
+    static const QRegularExpression braceEnd("}");
+    static const QRegularExpression bracketStart("\\[");
+    static const QRegularExpression bracketEnd("\\]");
+    if (text.startsWith(QLatin1String("---")))  // pass the data
     {
         data->insertNestInfo(openNests);
         data->setProperty(braces);
@@ -199,17 +209,15 @@ void Highlighter::highlightYamlBlock(const QString& text) {
     {
         if (!isCodeBlock) {
             if (braces) {
-                rehighlightNextBlock |= yamlOpenBraces(text, QRegularExpression("{"), QRegularExpression("}"),
-                                                       oldOpenNests, oldProperty, true);
-                rehighlightNextBlock |= yamlOpenBraces(
-                    text, QRegularExpression("\\["), QRegularExpression("\\]"), oldOpenNests, oldProperty,
-                    data->openNests() == 0);  // set data only if braces are completely closed
+                rehighlightNextBlock |= yamlOpenBraces(text, braceStart, braceEnd, oldOpenNests, oldProperty, true);
+                rehighlightNextBlock |=
+                    yamlOpenBraces(text, bracketStart, bracketEnd, oldOpenNests, oldProperty,
+                                   data->openNests() == 0);  // set data only if braces are completely closed
             }
             else {
-                rehighlightNextBlock |= yamlOpenBraces(text, QRegularExpression("\\["), QRegularExpression("\\]"),
-                                                       oldOpenNests, oldProperty, true);
+                rehighlightNextBlock |= yamlOpenBraces(text, bracketStart, bracketEnd, oldOpenNests, oldProperty, true);
                 rehighlightNextBlock |=
-                    yamlOpenBraces(text, QRegularExpression("{"), QRegularExpression("}"), oldOpenNests, oldProperty,
+                    yamlOpenBraces(text, braceStart, braceEnd, oldOpenNests, oldProperty,
                                    data->openNests() == 0);  // set data only if brackets are completely closed
             }
         }
@@ -235,6 +243,7 @@ void Highlighter::highlightYamlBlock(const QString& text) {
     if (bn >= startCursor.blockNumber() && bn <= endCursor.blockNumber()) {
         data->setHighlighted();
         QRegularExpressionMatch match;
+        int matchLength = 0;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 6, 0))
         for (const HighlightingRule& rule : std::as_const(highlightingRules))
 #else
@@ -248,34 +257,34 @@ void Highlighter::highlightYamlBlock(const QString& text) {
             if (rule.format == commentFormat)
                 continue;
 
-            index = text.indexOf(rule.pattern, 0, &match);
+            index = rule.indexIn(text, 0, &matchLength);
             if (rule.format != whiteSpaceFormat) {
                 fi = format(index);
                 while (index >= 0 && (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                                       fi == commentFormat || fi == urlFormat ||
                                       fi == noteFormat))  // because of Yaml keys (as in "# TODO:...")
                 {
-                    index = text.indexOf(rule.pattern, index + 1, &match);
+                    index = rule.indexIn(text, index + 1, &matchLength);
                     fi = format(index);
                 }
             }
             while (index >= 0) {
-                int length = match.capturedLength();
+                int length = matchLength;
 
                 /* check if there is a valid brace inside the regex
                    and if there is, limit the found match to it */
                 QString txt = text.mid(index, length);
                 int braceIndx = 0;
-                while ((braceIndx = txt.indexOf(QRegularExpression("{"), braceIndx)) >= 0) {
+                while ((braceIndx = txt.indexOf(QLatin1Char('{'), braceIndx)) >= 0) {
                     if (format(index + braceIndx) == neutralFormat &&
-                        !isYamlBraceEscaped(text, QRegularExpression("{"), index + braceIndx)) {
+                        !isYamlBraceEscaped(text, braceStart, index + braceIndx)) {
                         txt = text.mid(index, braceIndx);
                         break;
                     }
                     ++braceIndx;
                 }
                 braceIndx = 0;
-                while ((braceIndx = txt.indexOf(QRegularExpression("}"), braceIndx)) >= 0) {
+                while ((braceIndx = txt.indexOf(QLatin1Char('}'), braceIndx)) >= 0) {
                     if (format(index + braceIndx) == neutralFormat) {
                         txt = text.mid(index, braceIndx);
                         break;
@@ -283,16 +292,16 @@ void Highlighter::highlightYamlBlock(const QString& text) {
                     ++braceIndx;
                 }
                 braceIndx = 0;
-                while ((braceIndx = txt.indexOf(QRegularExpression("\\["), braceIndx)) >= 0) {
+                while ((braceIndx = txt.indexOf(QLatin1Char('['), braceIndx)) >= 0) {
                     if (format(index + braceIndx) == neutralFormat &&
-                        !isYamlBraceEscaped(text, QRegularExpression("\\["), index + braceIndx)) {
+                        !isYamlBraceEscaped(text, bracketStart, index + braceIndx)) {
                         txt = text.mid(index, braceIndx);
                         break;
                     }
                     ++braceIndx;
                 }
                 braceIndx = 0;
-                while ((braceIndx = txt.indexOf(QRegularExpression("\\]"), braceIndx)) >= 0) {
+                while ((braceIndx = txt.indexOf(QLatin1Char(']'), braceIndx)) >= 0) {
                     if (format(index + braceIndx) == neutralFormat) {
                         txt = text.mid(index, braceIndx);
                         break;
@@ -300,7 +309,7 @@ void Highlighter::highlightYamlBlock(const QString& text) {
                     ++braceIndx;
                 }
                 braceIndx = 0;
-                while ((braceIndx = txt.indexOf(QRegularExpression(","), braceIndx)) >= 0) {
+                while ((braceIndx = txt.indexOf(QLatin1Char(','), braceIndx)) >= 0) {
                     if (format(index + braceIndx) == neutralFormat) {
                         txt = text.mid(index, braceIndx);
                         break;
@@ -312,18 +321,15 @@ void Highlighter::highlightYamlBlock(const QString& text) {
                 if (length > 0) {
                     fi = rule.format;
                     if (fi.foreground() == Violet) {
-                        if (txt.indexOf(
-                                QRegularExpression(
-                                    "([-+]?(\\d*\\.?\\d+|\\d+\\.)((e|E)(\\+|-)?\\d+)?|0[xX][0-9a-fA-F]+)\\s*(?=(#|$))"),
-                                0, &match) == 0) {  // format numerical values differently
+                        static const QRegularExpression numericValue(
+                            "([-+]?(\\d*\\.?\\d+|\\d+\\.)((e|E)(\\+|-)?\\d+)?|0[xX][0-9a-fA-F]+)\\s*(?=(#|$))");
+                        static const QRegularExpression booleanValue(
+                            "(true|false|yes|no|TRUE|FALSE|YES|NO|True|False|Yes|No)\\s*(?=(#|$))");
+                        if (txt.indexOf(numericValue, 0, &match) == 0) {  // format numerical values differently
                             if (match.capturedLength() == length)
                                 fi.setForeground(Brown);
                         }
-                        else if (txt.indexOf(
-                                     QRegularExpression(
-                                         "(true|false|yes|no|TRUE|FALSE|YES|NO|True|False|Yes|No)\\s*(?=(#|$))"),
-                                     0,
-                                     &match) == 0) {  // format booleans differently
+                        else if (txt.indexOf(booleanValue, 0, &match) == 0) {  // format booleans differently
                             if (match.capturedLength() == length) {
                                 fi.setForeground(DarkBlue);
                                 fi.setFontWeight(QFont::Bold);
@@ -332,13 +338,13 @@ void Highlighter::highlightYamlBlock(const QString& text) {
                     }
                     setFormat(index, length, fi);
                 }
-                index = text.indexOf(rule.pattern, index + std::max(length, 1), &match);
+                index = rule.indexIn(text, index + std::max(length, 1), &matchLength);
 
                 if (rule.format != whiteSpaceFormat) {
                     fi = format(index);
                     while (index >= 0 && (fi == quoteFormat || fi == altQuoteFormat || fi == urlInsideQuoteFormat ||
                                           fi == commentFormat || fi == urlFormat || fi == noteFormat)) {
-                        index = text.indexOf(rule.pattern, index + 1, &match);
+                        index = rule.indexIn(text, index + 1, &matchLength);
                         fi = format(index);
                     }
                 }
@@ -1,6 +1,7 @@
 // src/features/highlighter/highlighter.cpp
 
 #include "highlighter.h"
+#include "highlightworker.h"
 #include <QTextDocument>
 
 #include <algorithm>
@@ -17,6 +18,57 @@ const QRegularExpression Highlighter::urlPattern(
     "\\.[A-Za-z0-9.]+(?<!\\.)");
 const QRegularExpression Highlighter::notePattern("\\b(NOTE|TODO|FIXME|WARNING)\\b");
 
+Highlighter::Language Highlighter::languageOf(const QString& name) {
+    static const QHash<QString, Language> languages = {
+        {QStringLiteral("c"), Language::C},
+        {QStringLiteral("cpp"), Language::Cpp},
+        {QStringLiteral("sh"), Language::Sh},
+        {QStringLiteral("perl"), Language::Perl},
+        {QStringLiteral("ruby"), Language::Ruby},
+        {QStringLiteral("javascript"), Language::JavaScript},
+        {QStringLiteral("qml"), Language::Qml},
+        {QStringLiteral("cmake"), Language::CMake},
+        {QStringLiteral("html"), Language::Html},
+        {QStringLiteral("rust"), Language::Rust},
+        {QStringLiteral("python"), Language::Python},
+        {QStringLiteral("makefile"), Language::Makefile},
+        {QStringLiteral("toml"), Language::Toml},
+        {QStringLiteral("go"), Language::Go},
+        {QStringLiteral("yaml"), Language::Yaml},
+        {QStringLiteral("java"), Language::Java},
+        {QStringLiteral("dart"), Language::Dart},
+        {QStringLiteral("xml"), Language::Xml},
+        {QStringLiteral("tcl"), Language::Tcl},
+        {QStringLiteral("php"), Language::Php},
+        {QStringLiteral("pascal"), Language::Pascal},
+        {QStringLiteral("LaTeX"), Language::LaTeX},
+        {QStringLiteral("troff"), Language::Troff},
+        {QStringLiteral("scss"), Language::Scss},
+        {QStringLiteral("fountain"), Language::Fountain},
+        {QStringLiteral("config"), Language::Config},
+        {QStringLiteral("theme"), Language::Theme},
+        {QStringLiteral("reST"), Language::ReST},
+        {QStringLiteral("openbox"), Language::OpenBox},
+        {QStringLiteral("markdown"), Language::Markdown},
+        {QStringLiteral("m3u"), Language::M3u},
+        {QStringLiteral("lua"), Language::Lua},
+        {QStringLiteral("desktop"), Language::Desktop},
+        {QStringLiteral("deb"), Language::Deb},
+        {QStringLiteral("css"), Language::Css},
+        {QStringLiteral("url"), Language::Url},
+        {QStringLiteral("srt"), Language::Srt},
+        {QStringLiteral("qmake"), Language::QMake},
+        {QStringLiteral("log"), Language::Log},
+        {QStringLiteral("json"), Language::Json},
+        {QStringLiteral("gtkrc"), Language::GtkRc},
+        {QStringLiteral("diff"), Language::Diff},
+        {QStringLiteral("changelog"), Language::ChangeLog},
+    };
+    if (name.isEmpty())
+        return Language::None;
+    return languages.value(name, Language::Other);
+}
+
 /*************************/
 // Here, the order of formatting is important because of overrides.
 Highlighter::Highlighter(QTextDocument* parent,
@@ -27,8 +79,15 @@ Highlighter::Highlighter(QTextDocument* parent,
                          bool showWhiteSpace,
                          bool showEndings,
                          int whitespaceValue,
-                         const QHash<QString, QColor>& syntaxColors)
-    : QSyntaxHighlighter(parent) {
+                         const QHash<QString, QColor>& syntaxColors,
+                         bool worker)
+    : QSyntaxHighlighter(parent),
+      langName_(lang),
+      darkColorScheme_(darkColorScheme),
+      showWhiteSpace_(showWhiteSpace),
+      showEndings_(showEndings),
+      whitespaceValue_(whitespaceValue),
+      syntaxColors_(syntaxColors) {
     if (lang.isEmpty())
         return;
 
@@ -51,29 +110,67 @@ Highlighter::Highlighter(QTextDocument* parent,
 
     startCursor = start;
     endCursor = end;
-    progLan = lang;
-    maxBlockSize_ = progLan == "html" ? 5000 : 10000;
+    progLan = languageOf(lang);
+    if (progLan != Language::None && worker) {
+        worker_ = new HighlightWorker(this);  // the rules are made by its highlighter
+        return;
+    }
+    switch (progLan) {
+        // Json's and XML's huge lines are also handled separately because of their special syntax
+        // (optimized SVG files can have lines with more than 10000 characters)
+        case Language::Json:
+            blockHighlighter_ = &Highlighter::highlightJsonBlock;
+            ownHugeLines_ = true;
+            break;
+        case Language::Xml:
+            blockHighlighter_ = &Highlighter::highlightXmlBlock;
+            ownHugeLines_ = true;
+            break;
+        case Language::Fountain:
+            blockHighlighter_ = &Highlighter::highlightFountainBlock;
+            break;
+        case Language::Yaml:
+            blockHighlighter_ = &Highlighter::highlightYamlBlock;
+            break;
+        case Language::Markdown:
+            blockHighlighter_ = &Highlighter::highlightMarkdownBlock;
+            break;
+        case Language::ReST:
+            blockHighlighter_ = &Highlighter::highlightReSTBlock;
+            break;
+        case Language::Tcl:
+            blockHighlighter_ = &Highlighter::highlightTclBlock;
+            break;
+        case Language::Lua:
+            blockHighlighter_ = &Highlighter::highlightLuaBlock;
+            break;
+        default:
+            break;
+    }
+    maxBlockSize_ = progLan == Language::Html ? 5000 : 10000;
 
-    hasQuotes_ = (progLan != "diff" && progLan != "log" && progLan != "desktop" && progLan != "config" &&
-                  progLan != "theme" && progLan != "openbox" && progLan != "changelog" && progLan != "url" &&
-                  progLan != "deb" && progLan != "m3u" && progLan != "LaTeX" && progLan != "troff");
+    hasQuotes_ = (progLan != Language::Diff && progLan != Language::Log && progLan != Language::Desktop &&
+                  progLan != Language::Config && progLan != Language::Theme && progLan != Language::OpenBox &&
+                  progLan != Language::ChangeLog && progLan != Language::Url && progLan != Language::Deb &&
+                  progLan != Language::M3u && progLan != Language::LaTeX && progLan != Language::Troff);
 
     /* whether multiLineQuote() should be used in a normal way */
-    multilineQuote_ = (hasQuotes_ && progLan != "xml"  // xmlQuotes() is used
-                       && progLan != "sh"              // SH_MultiLineQuote() is used
-                       && progLan != "css"             // cssHighlighter() is used
-                       && progLan != "pascal" && progLan != "srt" && progLan != "html" && progLan != "reST" &&
-                       progLan != "toml"       // Toml will be formated separately
-                       && progLan != "yaml");  // yaml will be formated separately
+    multilineQuote_ = (hasQuotes_ && progLan != Language::Xml  // xmlQuotes() is used
+                       && progLan != Language::Sh              // SH_MultiLineQuote() is used
+                       && progLan != Language::Css             // cssHighlighter() is used
+                       && progLan != Language::Pascal && progLan != Language::Srt && progLan != Language::Html &&
+                       progLan != Language::ReST && progLan != Language::Toml  // Toml will be formated separately
+                       && progLan != Language::Yaml);                          // yaml will be formated separately
 
     /* only for isQuoted() and multiLineQuote() (not used with JS, qml and perl) */
     mixedQuotes_ =
-        (progLan == "c" || progLan == "cpp"         // single quotes can also show syntax errors
-         || progLan == "python" || progLan == "sh"  // not used in multiLineQuote()
-         || progLan == "makefile" || progLan == "cmake" || progLan == "xml"  // never used; xml is formatted separately
-         || progLan == "ruby" || progLan == "html"                           // not used in multiLineQuote()
-         || progLan == "scss" || progLan == "yaml" || progLan == "dart" || progLan == "go" || progLan == "php" ||
-         progLan == "toml");
+        (progLan == Language::C || progLan == Language::Cpp         // single quotes can also show syntax errors
+         || progLan == Language::Python || progLan == Language::Sh  // not used in multiLineQuote()
+         || progLan == Language::Makefile || progLan == Language::CMake
+         || progLan == Language::Xml                                // never used; xml is formatted separately
+         || progLan == Language::Ruby || progLan == Language::Html  // not used in multiLineQuote()
+         || progLan == Language::Scss || progLan == Language::Yaml || progLan == Language::Dart ||
+         progLan == Language::Go || progLan == Language::Php || progLan == Language::Toml);
 
     quoteMark.setPattern("\"");  // the standard quote mark (always a single character but will be changed for Pascal)
     singleQuoteMark.setPattern("\'");    // will be changed only for Go
@@ -203,16 +300,17 @@ Highlighter::Highlighter(QTextDocument* parent,
      *************************/
 
     /* there may be javascript inside html */
-    QString Lang = progLan == "html" ? "javascript" : progLan;
+    const Language Lang = progLan == Language::Html ? Language::JavaScript : progLan;
 
     /* might be overridden by the keywords format */
-    if (progLan == "c" || progLan == "cpp" || progLan == "lua" || progLan == "python" || progLan == "php" ||
-        progLan == "dart" || progLan == "go" || progLan == "rust" || progLan == "java") {
+    if (progLan == Language::C || progLan == Language::Cpp || progLan == Language::Lua || progLan == Language::Python ||
+        progLan == Language::Php || progLan == Language::Dart || progLan == Language::Go || progLan == Language::Rust ||
+        progLan == Language::Java) {
         QTextCharFormat ft;
 
         /* numbers (including the exponential notation, binary, octal and hexadecimal literals) */
         ft.setForeground(Brown);
-        if (progLan == "python")
+        if (progLan == Language::Python)
             rule.pattern.setPattern(
                 "(?<=^|[^\\w\\d\\.])("
                 "\\d*\\.\\d+|\\d+\\.|(\\d*\\.?\\d+|\\d+\\.)(e|E)(\\+|-)?\\d+"
@@ -221,7 +319,7 @@ Highlighter::Highlighter(QTextDocument* parent,
                 "|"
                 "(0|[1-9]\\d*)(L|l)?"  // digits
                 ")(?=[^\\w\\d\\.]|$)");
-        else if (progLan == "java")
+        else if (progLan == Language::Java)
             rule.pattern.setPattern(
                 "(?<=^|[^\\w\\d\\.])("
                 "(\\d*\\.\\d+|\\d+\\.)(L|l|F|f)?"
@@ -232,7 +330,7 @@ Highlighter::Highlighter(QTextDocument* parent,
                 "|"
                 "([1-9]\\d*|0[0-7]*)(L|l|F|f)?|(0[xX][0-9a-fA-F]+|0[bB][01]+)(L|l)?"  // integer
                 ")(?=[^\\w\\d\\.]|$)");
-        else if (progLan == "rust")
+        else if (progLan == Language::Rust)
             rule.pattern.setPattern(
                 "\\b0(?:x[0-9a-fA-F_]+|o[0-7_]+|b[01_]+)(?:[iu](?:8|16|32|64|128|size)?)?\\b"  // hexadecimal, octal,
                                                                                                // binary
@@ -240,7 +338,7 @@ Highlighter::Highlighter(QTextDocument* parent,
                 "\\b[0-9][0-9_]*(?:(?:\\.[0-9][0-9_]*)?(?:[eE][\\+\\-]?[0-9_]+)?(?:f32|f64)?|(?:[iu](?:8|16|32|64|128|"
                 "size)?)"
                 "?)\\b");           // float, decimal
-        else if (progLan == "cpp")  // handled separately because of ' as separator
+        else if (progLan == Language::Cpp)  // handled separately because of ' as separator
             rule.pattern.setPattern(
                 "(?<=^|[^\\w\\d\\.])("
                 "((\\d*|\\d+(\'\\d+)*)\\.\\d+(\'\\d+)*|\\d+(\'\\d+)*\\.|(\\d*\\.?\\d+(\'\\d+)*|\\d+(\'\\d+)*\\.)(e|E)("
@@ -284,14 +382,14 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = ft;
         highlightingRules.append(rule);
         /* ... but make exception for what comes after "#define" */
-        if (progLan == "c" || progLan == "cpp") {
+        if (progLan == Language::C || progLan == Language::Cpp) {
             rule.pattern.setPattern(
                 "^\\s*#\\s*define\\s+[^\"\']+"  // may contain slash but no quote
                 "(?=\\s*\\()");
             rule.format = neutralFormat;
             highlightingRules.append(rule);
         }
-        else if (progLan == "python") {  // built-in functions
+        else if (progLan == Language::Python) {  // built-in functions
             ft.setFontWeight(QFont::Bold);
             ft.setForeground(Magenta);
             rule.pattern.setPattern(
@@ -332,7 +430,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             highlightingRules.append(rule);
         }
     }
-    else if (Lang == "javascript" || progLan == "qml") {
+    else if (Lang == Language::JavaScript || progLan == Language::Qml) {
         QTextCharFormat ft;
 
         /* before dot but not after it (might be overridden by keywords) */
@@ -359,7 +457,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = ft;
         highlightingRules.append(rule);
     }
-    else if (progLan == "troff") {
+    else if (progLan == Language::Troff) {
         QTextCharFormat troffFormat;
 
         troffFormat.setForeground(Blue);
@@ -397,7 +495,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = troffFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "LaTeX") {
+    else if (progLan == Language::LaTeX) {
         codeBlockFormat.setForeground(DarkMagenta);
 
         /* commands */
@@ -407,7 +505,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = laTexFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "pascal") {
+    else if (progLan == Language::Pascal) {
         /* before parentheses */
         QTextCharFormat pascalFormat;
         pascalFormat.setFontItalic(true);
@@ -424,8 +522,8 @@ Highlighter::Highlighter(QTextDocument* parent,
     /* keywords */
     QTextCharFormat keywordFormat;
     /* bash extra keywords */
-    if (progLan == "sh" || progLan == "makefile" || progLan == "cmake") {
-        if (progLan == "cmake") {
+    if (progLan == Language::Sh || progLan == Language::Makefile || progLan == Language::CMake) {
+        if (progLan == Language::CMake) {
             keywordFormat.setForeground(Brown);
             rule.pattern.setPattern("\\$\\{\\s*[A-Za-z0-9_.+/\\?#\\-:]*\\s*\\}");
             rule.format = keywordFormat;
@@ -705,7 +803,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         highlightingRules.append(rule);
     }
 
-    if (progLan == "qmake") {
+    if (progLan == Language::QMake) {
         QTextCharFormat qmakeFormat;
         /* qmake test functions */
         qmakeFormat.setForeground(DarkMagenta);
@@ -747,13 +845,13 @@ Highlighter::Highlighter(QTextDocument* parent,
     urlFormat.setForeground(Blue);
     urlFormat.setFontItalic(true);
 
-    if (progLan == "c" || progLan == "cpp") {
+    if (progLan == Language::C || progLan == Language::Cpp) {
         QTextCharFormat cFormat;
 
         /* Qt and Gtk+ specific classes */
         cFormat.setFontWeight(QFont::Bold);
         cFormat.setForeground(DarkMagenta);
-        if (progLan == "cpp")
+        if (progLan == Language::Cpp)
             rule.pattern.setPattern("\\bQ[A-Z][A-Za-z0-9]+(?!(\\.|-|@|#|\\$))\\b");
         else
             rule.pattern.setPattern("\\bG[A-Za-z]+(?!(\\.|-|@|#|\\$))\\b");
@@ -761,7 +859,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         highlightingRules.append(rule);
 
         /* C++ std methods and Qt's global functions, enums and global colors */
-        if (progLan == "cpp") {
+        if (progLan == Language::Cpp) {
             /*
                The whole pattern of C++11 raw string literals is
                R"(\bR"([^(]*)\(.*(?=\)\1"))"
@@ -806,7 +904,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = cFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "python") {
+    else if (progLan == Language::Python) {
         QTextCharFormat pFormat;
         pFormat.setFontWeight(QFont::Bold);
         pFormat.setForeground(DarkMagenta);
@@ -814,7 +912,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = pFormat;
         highlightingRules.append(rule);
     }
-    else if (Lang == "javascript" || progLan == "qml") {
+    else if (Lang == Language::JavaScript || progLan == Language::Qml) {
         QTextCharFormat ft;
 
         /* after dot (may override keywords) */
@@ -844,7 +942,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = ft;
         highlightingRules.append(rule);
 
-        if (progLan == "qml") {
+        if (progLan == Language::Qml) {
             ft.setFontWeight(QFont::Bold);
             ft.setForeground(DarkMagenta);
             rule.pattern.setPattern(
@@ -891,7 +989,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             highlightingRules.append(rule);
         }
     }
-    else if (progLan == "xml") {
+    else if (progLan == Language::Xml) {
         /* NOTE: Here, "<!DOCTYPE " is intentionally not included while "<?xml" is included. */
         xmlLt.setPattern(
             "<(?=(/?(?!\\.|\\-)[A-Za-z0-9_\\.\\-:]+|\\?(xml|XML)|!(ENTITY|ELEMENT|ATTLIST|NOTATION))(\\s|$|/?>))");
@@ -938,7 +1036,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = keywordFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "changelog") {
+    else if (progLan == Language::ChangeLog) {
         /* before colon */
         rule.pattern.setPattern("^\\s+\\*\\s+[^:]+:(?!(:|//))");
         rule.format = keywordFormat;
@@ -955,15 +1053,16 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = urlFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "sh" || progLan == "makefile" || progLan == "cmake" || progLan == "perl" || progLan == "ruby") {
+    else if (progLan == Language::Sh || progLan == Language::Makefile || progLan == Language::CMake ||
+             progLan == Language::Perl || progLan == Language::Ruby) {
         /* # is the sh comment sign when it doesn't follow a character */
-        if (progLan == "sh" || progLan == "makefile" || progLan == "cmake") {
-            if (progLan == "cmake")  // not the start of a bracket comment in cmake
+        if (progLan == Language::Sh || progLan == Language::Makefile || progLan == Language::CMake) {
+            if (progLan == Language::CMake)  // not the start of a bracket comment in cmake
                 rule.pattern.setPattern("(?<=^|\\s|;|\\(|\\))#(?!\\[\\=*\\[).*");
             else
                 rule.pattern.setPattern("(?<=^|\\s|;|\\(|\\))#.*");
 
-            if (progLan == "sh") {
+            if (progLan == Language::Sh) {
                 /* Kate uses something like: "<<(?:\\s*)([\\\\]{0,1}[^\\s]+)"
                 "<<-" can be used instead of "<<" */
                 hereDocDelimiter.setPattern(
@@ -971,7 +1070,7 @@ Highlighter::Highlighter(QTextDocument* parent,
                     "\")");
             }
         }
-        else if (progLan == "perl") {
+        else if (progLan == Language::Perl) {
             rule.pattern.setPattern("(?<!\\$)#.*");  // $# isn't a comment
 
             /* without space after "<<" and with ";" at the end */
@@ -986,7 +1085,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         else {
             rule.pattern.setPattern("#.*");
 
-            if (progLan == "ruby")
+            if (progLan == Language::Ruby)
                 hereDocDelimiter.setPattern(
                     "<<(?:-|~){0,1}([A-Za-z0-9_]+)|<<(?:-|~){0,1}(\'[A-Za-z0-9_]+\')|<<(?:-|~){0,1}(\"[A-Za-z0-9_]+"
                     "\")");
@@ -996,7 +1095,7 @@ Highlighter::Highlighter(QTextDocument* parent,
 
         QTextCharFormat shFormat;
 
-        if (progLan == "sh" || progLan == "makefile" || progLan == "cmake") {
+        if (progLan == Language::Sh || progLan == Language::Makefile || progLan == Language::CMake) {
             /* make parentheses, braces and ; neutral as they were in keyword patterns */
             rule.pattern.setPattern("[\\(\\){};]");
             rule.format = neutralFormat;
@@ -1004,7 +1103,7 @@ Highlighter::Highlighter(QTextDocument* parent,
 
             shFormat.setForeground(Blue);
             /* words before = */
-            if (progLan == "sh")
+            if (progLan == Language::Sh)
                 rule.pattern.setPattern("\\b[A-Za-z0-9_]+(?=\\=)");
             else
                 rule.pattern.setPattern("\\b[A-Za-z0-9_]+\\s*(?=(\\+|\\?){0,1}\\=)");
@@ -1018,7 +1117,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             highlightingRules.append(rule);
         }
 
-        if (progLan == "makefile" || progLan == "cmake") {
+        if (progLan == Language::Makefile || progLan == Language::CMake) {
             shFormat.setForeground(DarkYellow);
             /* automake/autoconf variables */
             rule.pattern.setPattern("@[A-Za-z0-9_-]+@|^[a-zA-Z0-9_-]+\\s*(?=:)");
@@ -1026,7 +1125,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             highlightingRules.append(rule);
         }
 
-        if (progLan == "perl") {
+        if (progLan == Language::Perl) {
             shFormat.setForeground(DarkYellow);
             rule.pattern.setPattern("[%@\\$]");
             rule.format = shFormat;
@@ -1051,7 +1150,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             rule.format = shFormat;
             highlightingRules.append(rule);
         }
-        else if (progLan == "sh" || progLan == "makefile" || progLan == "cmake") {
+        else if (progLan == Language::Sh || progLan == Language::Makefile || progLan == Language::CMake) {
             shFormat.setForeground(DarkMagenta);
             /* operators */
             rule.pattern.setPattern(
@@ -1066,7 +1165,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             rule.format = shFormat;
             highlightingRules.append(rule);
         }
-        else if (progLan == "ruby") {
+        else if (progLan == Language::Ruby) {
             /* numbers */
             shFormat.setForeground(Brown);
             rule.pattern.setPattern("(?<![a-zA-Z0-9_@$%])\\d+(\\.\\d+)?(?=[^\\d]|$)");
@@ -1146,7 +1245,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             highlightingRules.append(rule);
         }
     }
-    else if (progLan == "diff") {
+    else if (progLan == Language::Diff) {
         QTextCharFormat diffMinusFormat;
         diffMinusFormat.setForeground(Red);
         rule.pattern.setPattern("^\\-.*");
@@ -1181,7 +1280,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = diffLinesFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "log") {
+    else if (progLan == Language::Log) {
         /* example:
          * May 19 02:01:44 debian sudo:
          *   blue  green  magenta bold */
@@ -1228,7 +1327,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = logFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "srt") {
+    else if (progLan == Language::Srt) {
         QTextCharFormat srtFormat;
         srtFormat.setFontWeight(QFont::Bold);
 
@@ -1276,9 +1375,10 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.pattern.setPattern("^\\s*\\d{2}:\\d{2}:\\d{2},\\d{3}\\s+-->\\s+\\d{2}:\\d{2}:\\K\\d{2}(?=,\\d{3}\\s*$)");
         highlightingRules.append(rule);
     }
-    else if (progLan == "desktop" || progLan == "config" || progLan == "theme" || progLan == "toml") {
+    else if (progLan == Language::Desktop || progLan == Language::Config || progLan == Language::Theme ||
+             progLan == Language::Toml) {
         QTextCharFormat desktopFormat = neutralFormat;
-        if (progLan == "config") {
+        if (progLan == Language::Config) {
             desktopFormat.setFontWeight(QFont::Bold);
             desktopFormat.setFontItalic(true);
             /* color values */
@@ -1294,7 +1394,7 @@ Highlighter::Highlighter(QTextDocument* parent,
             rule.format = urlFormat;
             highlightingRules.append(rule);
         }
-        else if (progLan == "toml") {
+        else if (progLan == Language::Toml) {
             desktopFormat.setForeground(Brown);
             rule.pattern.setPattern(
                 "(?<=^|[^\\w\\d\\.])("
@@ -1316,14 +1416,14 @@ Highlighter::Highlighter(QTextDocument* parent,
         desktopFormat = neutralFormat;
         desktopFormat.setFontWeight(QFont::Bold);
         /* [...] */
-        if (progLan == "toml")
+        if (progLan == Language::Toml)
             rule.pattern.setPattern("^\\s*(\\[[A-Za-z0-9_\\-\\.\"']*\\]|\\[\\[[A-Za-z0-9_\\-\\.\"']*\\]\\])");
         else
             rule.pattern.setPattern("^\\[.*\\]$");
         rule.format = desktopFormat;
         highlightingRules.append(rule);
 
-        if (progLan == "toml") {
+        if (progLan == Language::Toml) {
             desktopFormat.setForeground(Violet);
             /* before = */
             rule.pattern.setPattern("[A-Za-z0-9_\\-\\.\"']+(?=\\s*\\=)");
@@ -1342,7 +1442,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = desktopFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "openbox") {
+    else if (progLan == Language::OpenBox) {
         QTextCharFormat obpFormat = neutralFormat;
         obpFormat.setFontWeight(QFont::Bold);
         obpFormat.setFontItalic(true);
@@ -1364,7 +1464,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = obpFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "yaml") {
+    else if (progLan == Language::Yaml) {
         rule.pattern.setPattern("(?<=^|\\s)#.*");
         rule.format = commentFormat;
         highlightingRules.append(rule);
@@ -1416,7 +1516,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = yamlFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "fountain") {
+    else if (progLan == Language::Fountain) {
         QTextCharFormat fFormat;
 
         /* sections */
@@ -1437,12 +1537,12 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = fFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "url") {
+    else if (progLan == Language::Url) {
         rule.pattern.setPattern(urlPattern.pattern());
         rule.format = urlFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "gtkrc") {
+    else if (progLan == Language::GtkRc) {
         QTextCharFormat gtkrcFormat;
         gtkrcFormat.setFontWeight(QFont::Bold);
         /* color value format (#xyz) */
@@ -1457,7 +1557,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = gtkrcFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "markdown") {
+    else if (progLan == Language::Markdown) {
         blockQuoteFormat.setForeground(DarkGreen);
         codeBlockFormat.setForeground(DarkRed);
         QTextCharFormat markdownFormat;
@@ -1524,7 +1624,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = markdownFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "reST") {
+    else if (progLan == Language::ReST) {
         /* For bold, italic, verbatim and link
 
            possible characters before the start:  ([{<:'"/
@@ -1634,7 +1734,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = reSTFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "lua") {
+    else if (progLan == Language::Lua) {
         errorFormat.setForeground(Red);
         errorFormat.setFontUnderline(true);
 
@@ -1654,7 +1754,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = luaFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "m3u") {
+    else if (progLan == Language::M3u) {
         QTextCharFormat plFormat = neutralFormat;
         plFormat.setFontWeight(QFont::Bold);
         rule.pattern.setPattern("^#EXTM3U\\b");
@@ -1685,7 +1785,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = plFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "scss") {
+    else if (progLan == Language::Scss) {
         /* scss supports nested css blocks but, instead of making its highlighting complex,
            we format it without considering that and so, without syntax error, but with keywords() */
 
@@ -1726,7 +1826,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = scssFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "dart") {
+    else if (progLan == Language::Dart) {
         QTextCharFormat dartFormat;
 
         /* dart:core classes */
@@ -1747,7 +1847,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = dartFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "go") {
+    else if (progLan == Language::Go) {
         singleQuoteMark.setPattern("`");
         mixedQuoteMark.setPattern("\"|`");
 
@@ -1759,7 +1859,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = goFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "rust") {
+    else if (progLan == Language::Rust) {
         rawLiteralFormat = quoteFormat;
         rawLiteralFormat.setFontWeight(QFont::Bold);
 
@@ -1838,7 +1938,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = rustFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "tcl") {
+    else if (progLan == Language::Tcl) {
         QTextCharFormat tclFormat;
 
         /* backslash should also be taken into account (as in "Highlighter::keywords") */
@@ -1932,7 +2032,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = tclFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "pascal") {
+    else if (progLan == Language::Pascal) {
         quoteMark.setPattern("'");
 
         QTextCharFormat pascalFormat;
@@ -1967,7 +2067,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = pascalFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "java") {
+    else if (progLan == Language::Java) {
         commentBoldFormat.setForeground(Red);
         commentBoldFormat.setFontItalic(true);
         commentBoldFormat.setFontWeight(QFont::Bold);
@@ -2926,7 +3026,7 @@ Highlighter::Highlighter(QTextDocument* parent,
         rule.format = javaFormat;
         highlightingRules.append(rule);
     }
-    else if (progLan == "json") {
+    else if (progLan == Language::Json) {
         quoteFormat.setFontWeight(QFont::Bold);
         errorFormat.setForeground(Red);
         errorFormat.setFontUnderline(true);
@@ -2944,34 +3044,36 @@ Highlighter::Highlighter(QTextDocument* parent,
 
     /* single line comments */
     rule.pattern.setPattern(QString());
-    if (progLan == "c" || progLan == "cpp" || Lang == "javascript" || progLan == "qml" || progLan == "scss" ||
-        progLan == "dart" || progLan == "go" || progLan == "rust" || progLan == "java") {
+    if (progLan == Language::C || progLan == Language::Cpp || Lang == Language::JavaScript ||
+        progLan == Language::Qml || progLan == Language::Scss || progLan == Language::Dart || progLan == Language::Go ||
+        progLan == Language::Rust || progLan == Language::Java) {
         rule.pattern.setPattern("//.*");  // why had I set it to ("//(?!\\*).*")?
     }
-    else if (progLan == "php") {
+    else if (progLan == Language::Php) {
         rule.pattern.setPattern("(//|#).*");
     }
-    else if (progLan == "python" || progLan == "qmake" || progLan == "gtkrc" || progLan == "toml") {
+    else if (progLan == Language::Python || progLan == Language::QMake || progLan == Language::GtkRc ||
+             progLan == Language::Toml) {
         rule.pattern.setPattern("#.*");  // or "#[^\n]*"
     }
-    else if (progLan == "desktop" || progLan == "config" || progLan == "theme") {
+    else if (progLan == Language::Desktop || progLan == Language::Config || progLan == Language::Theme) {
         rule.pattern.setPattern("^\\s*#.*");  // only at start
     }
-    else if (progLan == "openbox") {
+    else if (progLan == Language::OpenBox) {
         rule.pattern.setPattern("^\\s*(#|\\!).*");  // only at start
     }
-    /*else if (progLan == "deb")
+    /*else if (progLan == Language::Deb)
     {
         rule.pattern.setPattern ("^#[^\\s:]+:(?=\\s*)");
     }*/
-    else if (progLan == "m3u") {
+    else if (progLan == Language::M3u) {
         rule.pattern.setPattern("^\\s+#|^#(?!(EXTM3U|EXTINF))");
     }
-    else if (progLan == "troff")
+    else if (progLan == Language::Troff)
         rule.pattern.setPattern("\\\\\"|\\\\#|\\.\\s*\\\\\"");
-    else if (progLan == "LaTeX")
+    else if (progLan == Language::LaTeX)
         rule.pattern.setPattern("%.*");
-    else if (progLan == "tcl")
+    else if (progLan == Language::Tcl)
         rule.pattern.setPattern("^\\s*#|(?<!\\\\)(\\\\{2})*\\K;\\s*#");
 
     if (!rule.pattern.pattern().isEmpty()) {
@@ -2980,21 +3082,22 @@ Highlighter::Highlighter(QTextDocument* parent,
     }
 
     /* multiline comments */
-    if (progLan == "c" || progLan == "cpp" || progLan == "javascript" || progLan == "qml" || progLan == "php" ||
-        progLan == "css" || progLan == "scss" || progLan == "fountain" || progLan == "dart" || progLan == "go" ||
-        progLan == "rust" || progLan == "java") {
+    if (progLan == Language::C || progLan == Language::Cpp || progLan == Language::JavaScript ||
+        progLan == Language::Qml || progLan == Language::Php || progLan == Language::Css || progLan == Language::Scss ||
+        progLan == Language::Fountain || progLan == Language::Dart || progLan == Language::Go ||
+        progLan == Language::Rust || progLan == Language::Java) {
         commentStartExpression.setPattern("/\\*");
         commentEndExpression.setPattern("\\*/");
     }
-    else if (progLan == "python") {
+    else if (progLan == Language::Python) {
         commentStartExpression.setPattern("\"\"\"|\'\'\'");
         commentEndExpression = commentStartExpression;
     }
-    else if (progLan == "xml" || progLan == "markdown") {
+    else if (progLan == Language::Xml || progLan == Language::Markdown) {
         commentStartExpression.setPattern("<!--");
         commentEndExpression.setPattern("-->");
     }
-    else if (progLan == "html") {
+    else if (progLan == Language::Html) {
         errorFormat.setForeground(Red);
         errorFormat.setFontUnderline(true);
 
@@ -3008,14 +3111,16 @@ Highlighter::Highlighter(QTextDocument* parent,
         commentStartExpression = htmlCommetStart;
         commentEndExpression = htmlCommetEnd;
     }
-    else if (progLan == "perl") {
+    else if (progLan == Language::Perl) {
         commentStartExpression.setPattern("^=[A-Za-z0-9_]+($|\\s+)");
         commentEndExpression.setPattern("^=cut.*");
     }
-    else if (progLan == "ruby") {
+    else if (progLan == Language::Ruby) {
         commentStartExpression.setPattern("=begin\\s*$");
         commentEndExpression.setPattern("^=end\\s*$");
     }
+
+    useKeywordSets();
 }
 
 }  // namespace Texxy
@@ -10,6 +10,11 @@
 #include <QColor>
 #include <QTextBlockUserData>
 #include <QTextCursor>
+#include <QTextLayout>
+
+#include <memory>
+
+#include "keywordset.h"
 
 namespace Texxy {
 
@@ -28,17 +33,33 @@ struct BracketInfo {
     int position;
 };
 
+class TextBlockData;
+
+/* What the highlighter of a worker thread made of a block (see HighlightWorker). */
+struct HighlightResult {
+    int blockNumber = -1;
+    size_t textHash = 0;  // of the block's text, to know whether it's still the same
+    int state = -1;
+    QList<QTextLayout::FormatRange> formats;  // runs of the formats that were set
+    std::shared_ptr<const TextBlockData> data;
+};
+
 class TextBlockData : public QTextBlockUserData {
    public:
     TextBlockData()
         : Highlighted(false),
           Property(false),
+          Dirty(false),
           LastState(0),
           OpenNests(0),
           LastFormattedQuote(0),
-          LastFormattedRegex(0) {}
+          LastFormattedRegex(0),
+          Checkpoint(0) {}
     ~TextBlockData();
 
+    /* A deep copy, without the pending result. */
+    TextBlockData* clone() const;
+
     QList<ParenthesisInfo*> parentheses() const;
     QList<BraceInfo*> braces() const;
     QList<BracketInfo*> brackets() const;
@@ -50,6 +71,12 @@ class TextBlockData : public QTextBlockUserData {
     int lastFormattedQuote() const;
     int lastFormattedRegex() const;
     QSet<int> openQuotes() const;
+    bool isDirty() const;
+    size_t checkpoint() const;
+
+    /* A hash of the state at the end of the block, that is, of "blockState" and
+       everything that the next block may read from this one. */
+    size_t stateHash(int blockState) const;
 
     void insertInfo(ParenthesisInfo* info);
     void insertInfo(BraceInfo* info);
@@ -62,6 +89,13 @@ class TextBlockData : public QTextBlockUserData {
     void insertLastFormattedQuote(int last);
     void insertLastFormattedRegex(int last);
     void insertOpenQuotes(const QSet<int>& openQuotes);
+    void setDirty(bool dirty);
+    void setCheckpoint(size_t checkpoint);
+
+    /* The result of the worker thread that isn't applied yet. */
+    bool hasPendingResult() const { return pendingResult_ != nullptr; }
+    void setPendingResult(std::shared_ptr<const HighlightResult> result) { pendingResult_ = std::move(result); }
+    std::shared_ptr<const HighlightResult> takePendingResult() { return std::move(pendingResult_); }
 
    private:
     QList<ParenthesisInfo*> allParentheses;
@@ -70,13 +104,18 @@ class TextBlockData : public QTextBlockUserData {
     QString label;
     bool Highlighted;
     bool Property;
+    bool Dirty;  // its highlighting is deferred (see Highlighter::highlightBlock())
     int LastState;
     int OpenNests;
     int LastFormattedQuote;
     int LastFormattedRegex;
     QSet<int> OpenQuotes;
+    size_t Checkpoint;  // the state hash when it was last highlighted
+    std::shared_ptr<const HighlightResult> pendingResult_;
 };
 
+class HighlightWorker;
+
 class Highlighter : public QSyntaxHighlighter {
     Q_OBJECT
 
@@ -89,7 +128,8 @@ class Highlighter : public QSyntaxHighlighter {
                 bool showWhiteSpace,
                 bool showEndings,
                 int whitespaceValue,
-                const QHash<QString, QColor>& syntaxColors = QHash<QString, QColor>());
+                const QHash<QString, QColor>& syntaxColors = QHash<QString, QColor>(),
+                bool worker = false);
     ~Highlighter();
 
     void setLimit(const QTextCursor& start, const QTextCursor& end) {
@@ -97,12 +137,87 @@ class Highlighter : public QSyntaxHighlighter {
         endCursor = end;
     }
 
+    /* With "worker" on construction, a worker thread highlights the document (see
+       HighlightWorker), and only its highlighter has the rules of the language. A
+       changed block is unformatted until its new formats are received, and only the
+       visible blocks are formatted then; the others when they become visible. */
+    bool usesWorker() const { return worker_ != nullptr; }
+
+    /* Highlights the dirty blocks up to the end of the limit. They are the blocks
+       after the limit that a change has reached; their highlighting is deferred
+       until they are needed. With a worker thread, it's done there. */
+    void highlightDirtyBlocks();
+
+    /* Highlights a document that was filled without being highlighted up to the
+       end of the limit, and leaves the rest for highlightDirtyBlocks(). */
+    void highlightToLimit();
+
    protected:
     void highlightBlock(const QString& text) override;
 
    private:
-    QStringList keywords(const QString& lang);
+    friend class HighlightWorker;
+
+    void applyPendingResult(const QString& text);
+    void keepFormats();
+    void formatBlock(const QString& text);
+    void markDirty(const QTextBlock& block);
+    void carryChanges();
+
+    /* The languages are interned from their names (see TextEdit::getProg()) on
+       construction, so that the checks made for each block compare integers. */
+    enum class Language : quint8 {
+        None,  // nothing is highlighted
+        Other,
+        C,
+        Cpp,
+        Sh,
+        Perl,
+        Ruby,
+        JavaScript,
+        Qml,
+        CMake,
+        Html,
+        Rust,
+        Python,
+        Makefile,
+        Toml,
+        Go,
+        Yaml,
+        Java,
+        Dart,
+        Xml,
+        Tcl,
+        Php,
+        Pascal,
+        LaTeX,
+        Troff,
+        Scss,
+        Fountain,
+        Config,
+        Theme,
+        ReST,
+        OpenBox,
+        Markdown,
+        M3u,
+        Lua,
+        Desktop,
+        Deb,
+        Css,
+        Url,
+        Srt,
+        QMake,
+        Log,
+        Json,
+        GtkRc,
+        Diff,
+        ChangeLog
+    };
+    static Language languageOf(const QString& name);
+
+    QStringList keywords(Language lang);
     QStringList types();
+    void useKeywordSets();
     bool isEscapedChar(const QString& text, int pos) const;
     bool isEscapedQuote(const QString& text, int pos, bool isStartQuote, bool skipCommandSign = false);
     bool isQuoted(const QString& text, int index, bool skipCommandSign = false, int start = 0);
@@ -286,7 +401,19 @@ class Highlighter : public QSyntaxHighlighter {
 
     struct HighlightingRule {
         QRegularExpression pattern;
+        std::shared_ptr<const KeywordSet> keywords;  // used instead of "pattern" if it isn't null
         QTextCharFormat format;
+
+        /* Like "text.indexOf(pattern, from)", also setting "length" to that of the match. */
+        int indexIn(const QString& text, int from, int* length = nullptr) const {
+            if (keywords)
+                return keywords->indexIn(text, from, length);
+            QRegularExpressionMatch match;
+            const int index = text.indexOf(pattern, from, &match);
+            if (length)
+                *length = match.capturedLength();
+            return index;
+        }
     };
     QList<HighlightingRule> highlightingRules;
 
@@ -314,7 +441,13 @@ class Highlighter : public QSyntaxHighlighter {
     QTextCharFormat errorFormat;
     QTextCharFormat rawLiteralFormat;
 
-    QString progLan;
+    Language progLan = Language::None;  // changed temporarily inside HTML (to CSS or JavaScript)
+
+    /* The function that highlights the blocks of a language on its own, if any.
+       With "ownHugeLines_", it also handles the lines longer than maxBlockSize_. */
+    using BlockHighlighter = void (Highlighter::*)(const QString&);
+    BlockHighlighter blockHighlighter_ = nullptr;
+    bool ownHugeLines_ = false;
 
     QRegularExpression quoteMark, singleQuoteMark, backQuote, mixedQuoteMark, mixedQuoteBackquote;
     QRegularExpression xmlLt, xmlGt;
@@ -325,6 +458,24 @@ class Highlighter : public QSyntaxHighlighter {
 
     QTextCursor startCursor, endCursor;
 
+    QList<QTextCursor> dirtyRuns_;  // at the first blocks of the runs of dirty blocks
+    /* The numbers of the blocks after those whose end states have changed, to be
+       highlighted later unless they are highlighted in the same pass (see
+       carryChanges()), and the revision of the text they were found in (-1 if
+       they were found in more than one). */
+    QList<int> carried_;
+    int carriedRevision_ = -1;
+    bool carryQueued_ = false;
+
+    /* the arguments of the constructor, for the highlighter of the worker thread */
+    QString langName_;
+    bool darkColorScheme_ = false;
+    bool showWhiteSpace_ = false;
+    bool showEndings_ = false;
+    int whitespaceValue_ = 0;
+    QHash<QString, QColor> syntaxColors_;
+    HighlightWorker* worker_ = nullptr;
+
     int maxBlockSize_;
     bool hasQuotes_;
     bool multilineQuote_;
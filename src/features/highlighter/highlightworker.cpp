@@ -0,0 +1,276 @@
+// src/features/highlighter/highlightworker.cpp
+/*
+ * texxy/highlighter/highlightworker.cpp
+ */
+
+#include "highlightworker.h"
+
+#include <QMetaObject>
+#include <QSignalBlocker>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
+
+namespace Texxy {
+
+namespace {
+
+/* The worker thread runs while a document is highlighted in it. */
+QThread* workerThread = nullptr;  // used only in the GUI thread
+int workerUsers = 0;
+
+QThread* acquireWorkerThread() {
+    if (!workerThread) {
+        workerThread = new QThread;
+        workerThread->setObjectName(QStringLiteral("Highlighter"));
+        workerThread->start();
+    }
+    ++workerUsers;
+    return workerThread;
+}
+
+void releaseWorkerThread() {
+    if (--workerUsers > 0)
+        return;
+    workerThread->quit();
+    workerThread->wait();
+    delete workerThread;
+    workerThread = nullptr;
+}
+
+/* Sets the limit of a mirror highlighter from the start of the document to "lastBlock". */
+void setMirrorLimit(Highlighter* highlighter, QTextDocument* doc, int lastBlock) {
+    QTextCursor start(doc);
+    start.setKeepPositionOnInsert(true);
+    QTextCursor end(doc->findBlockByNumber(std::clamp(lastBlock, 0, doc->blockCount() - 1)));
+    highlighter->setLimit(start, end);
+}
+
+/* Highlights the mirror document and records the results of its blocks. */
+class MirrorHighlighter : public Highlighter {
+   public:
+    MirrorHighlighter(HighlightMirror* mirror,
+                      QTextDocument* doc,
+                      const QString& lang,
+                      bool darkColorScheme,
+                      bool showWhiteSpace,
+                      bool showEndings,
+                      int whitespaceValue,
+                      const QHash<QString, QColor>& syntaxColors)
+        : Highlighter(doc,
+                      lang,
+                      QTextCursor(doc),
+                      QTextCursor(doc),
+                      darkColorScheme,
+                      showWhiteSpace,
+                      showEndings,
+                      whitespaceValue,
+                      syntaxColors),
+          mirror_(mirror) {}
+
+   protected:
+    void highlightBlock(const QString& text) override {
+        if (mirror_->isCancelled())
+            return;
+        Highlighter::highlightBlock(text);
+        const auto* data = static_cast<TextBlockData*>(currentBlockUserData());
+        if (!data || data->isDirty())
+            return;  // deferred (a highlighted block has data)
+
+        HighlightResult result;
+        result.blockNumber = currentBlock().blockNumber();
+        result.textHash = qHash(text);
+        result.state = currentBlockState();
+        const int size = text.size();
+        int start = 0;
+        while (start < size) {
+            const QTextCharFormat fmt = format(start);
+            int end = start + 1;
+            while (end < size && format(end) == fmt)
+                ++end;
+            if (!fmt.isEmpty())
+                result.formats.append(QTextLayout::FormatRange{start, end - start, fmt});
+            start = end;
+        }
+        if (data)
+            result.data.reset(data->clone());
+        mirror_->record(std::move(result));
+    }
+
+   private:
+    HighlightMirror* mirror_;
+};
+
+}  // namespace
+
+void HighlightMirror::start(const QString& text,
+                            int lastBlock,
+                            const QString& lang,
+                            bool darkColorScheme,
+                            bool showWhiteSpace,
+                            bool showEndings,
+                            int whitespaceValue,
+                            const QHash<QString, QColor>& syntaxColors) {
+    doc_ = new QTextDocument(this);
+    doc_->setUndoRedoEnabled(false);
+    /* The highlighter is made while the document is empty, and it isn't told about
+       the text, because QSyntaxHighlighter would highlight the whole of it then. */
+    highlighter_ = new MirrorHighlighter(this, doc_, lang, darkColorScheme, showWhiteSpace, showEndings,
+                                         whitespaceValue, syntaxColors);
+    if (!text.isEmpty() && !isCancelled()) {
+        const QSignalBlocker blocker(doc_);
+        QTextCursor(doc_).insertText(text);
+    }
+    setMirrorLimit(highlighter_, doc_, lastBlock);
+    highlighter_->highlightToLimit();
+}
+
+void HighlightMirror::setLimit(int lastBlock) {
+    if (!highlighter_ || isCancelled())
+        return;
+    setMirrorLimit(highlighter_, doc_, lastBlock);
+    highlighter_->highlightDirtyBlocks();
+}
+
+void HighlightMirror::applyEdit(int position, int removed, const QString& text) {
+    flush();  // the results so far belong to the previous text
+    ++edits_;
+    if (!doc_ || isCancelled())
+        return;
+    // as in Journal::Recovery::replay()
+    const int last = doc_->characterCount() - 1;
+    QTextCursor cursor(doc_);
+    cursor.setPosition(std::min(position, last));
+    cursor.setPosition(std::min(position + removed, last), QTextCursor::KeepAnchor);
+    if (text.isEmpty())
+        cursor.removeSelectedText();
+    else
+        cursor.insertText(text);
+}
+
+void HighlightMirror::record(HighlightResult&& result) {
+    if (results_.isEmpty())
+        QMetaObject::invokeMethod(this, &HighlightMirror::flush, Qt::QueuedConnection);
+    results_.append(std::move(result));
+    if (results_.size() >= kMaxBatch)
+        flush();
+}
+
+void HighlightMirror::flush() {
+    if (results_.isEmpty())
+        return;
+    emit highlighted(edits_, results_);
+    results_.clear();
+}
+
+HighlightWorker::HighlightWorker(Highlighter* highlighter)
+    : QObject(highlighter),
+      highlighter_(highlighter),
+      doc_(highlighter->document()),
+      mirror_(new HighlightMirror),
+      revision_(doc_->revision()),
+      blockCount_(doc_->blockCount()),
+      edits_(0),
+      lastBlock_(highlighter->endCursor.blockNumber() + kLookahead) {
+    QThread* thread = acquireWorkerThread();
+    mirror_->moveToThread(thread);
+    connect(thread, &QThread::finished, mirror_, &QObject::deleteLater);
+    connect(mirror_, &HighlightMirror::highlighted, this, &HighlightWorker::onHighlighted);
+    connect(doc_, &QTextDocument::contentsChange, this, &HighlightWorker::onContentsChange);
+
+    HighlightMirror* mirror = mirror_;
+    QMetaObject::invokeMethod(mirror_, [mirror, text = doc_->toRawText(), last = lastBlock_,
+                                        lang = highlighter->langName_, dark = highlighter->darkColorScheme_,
+                                        spaces = highlighter->showWhiteSpace_, endings = highlighter->showEndings_,
+                                        value = highlighter->whitespaceValue_, colors = highlighter->syntaxColors_] {
+        mirror->start(text, last, lang, dark, spaces, endings, value, colors);
+    });
+}
+
+HighlightWorker::~HighlightWorker() {
+    mirror_->cancel();  // what it is highlighting isn't needed anymore
+    mirror_->deleteLater();
+    releaseWorkerThread();
+}
+
+void HighlightWorker::setLimit(int lastBlock) {
+    lastBlock += kLookahead;
+    if (lastBlock == lastBlock_)
+        return;
+    lastBlock_ = lastBlock;
+    HighlightMirror* mirror = mirror_;
+    QMetaObject::invokeMethod(mirror_, [mirror, lastBlock] { mirror->setLimit(lastBlock); });
+}
+
+void HighlightWorker::onContentsChange(int position, int removed, int added) {
+    const int revision = doc_->revision();
+    if (removed == added && revision == revision_)
+        return;  // only the formats are changed (e.g., by the highlighter)
+    revision_ = revision;
+
+    const int last = doc_->characterCount() - 1;
+    QTextCursor cursor(doc_);
+    cursor.setPosition(std::min(position, last));
+    cursor.setPosition(std::min(position + added, last), QTextCursor::KeepAnchor);
+    const QString text = cursor.selectedText();
+
+    const int blockCount = doc_->blockCount();
+    const int blockDelta = blockCount - blockCount_;
+    blockCount_ = blockCount;
+    const int firstBlock = doc_->findBlock(position).blockNumber();
+    const int lastBlock = cursor.block().blockNumber() - blockDelta;
+    inFlight_.append({++edits_, firstBlock, lastBlock, blockDelta});
+
+    HighlightMirror* mirror = mirror_;
+    QMetaObject::invokeMethod(mirror_,
+                              [mirror, position, removed, text] { mirror->applyEdit(position, removed, text); });
+}
+
+void HighlightWorker::onHighlighted(int edits, const QList<HighlightResult>& results) {
+    while (!inFlight_.isEmpty() && inFlight_.constFirst().seq <= edits)
+        inFlight_.removeFirst();
+
+    const int firstVisible = highlighter_->startCursor.blockNumber();
+    const int lastVisible = highlighter_->endCursor.blockNumber();
+    QList<QTextBlock> visible;
+    for (const HighlightResult& result : results) {
+        /* find the block after the edits that the mirror hasn't seen */
+        int n = result.blockNumber;
+        for (const Edit& edit : std::as_const(inFlight_)) {
+            if (n < edit.firstBlock)
+                continue;
+            if (n <= edit.lastBlock) {
+                n = -1;  // it will be highlighted again
+                break;
+            }
+            n += edit.blockDelta;
+        }
+        if (n < 0)
+            continue;
+        QTextBlock block = doc_->findBlockByNumber(n);
+        if (!block.isValid() || qHash(block.text()) != result.textHash)
+            continue;
+
+        auto* data = static_cast<TextBlockData*>(block.userData());
+        if (!data) {
+            data = new TextBlockData;
+            block.setUserData(data);
+        }
+        data->setPendingResult(std::make_shared<const HighlightResult>(result));
+        if (n >= firstVisible && n <= lastVisible)
+            visible.append(block);
+    }
+
+    for (const QTextBlock& block : std::as_const(visible)) {
+        // it may have been formatted with the previous one
+        if (auto* data = static_cast<TextBlockData*>(block.userData())) {
+            if (data->hasPendingResult())
+                highlighter_->rehighlightBlock(block);
+        }
+    }
+}
+
+}  // namespace Texxy
@@ -0,0 +1,108 @@
+// src/features/highlighter/highlightworker.h
+/*
+ * texxy/highlighter/highlightworker.h
+ */
+
+#ifndef HIGHLIGHTWORKER_H
+#define HIGHLIGHTWORKER_H
+
+#include <QColor>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+#include "highlighter.h"
+
+class QTextDocument;
+
+namespace Texxy {
+
+/* A copy of a highlighted document in the worker thread. It is kept up to date by
+   the edits of the original and is highlighted by a Highlighter of the same kind,
+   whose results are sent back in batches. Used only by HighlightWorker. */
+class HighlightMirror : public QObject {
+    Q_OBJECT
+
+   public:
+    HighlightMirror() = default;
+
+    /* These are called in the worker thread. */
+    void start(const QString& text,
+               int lastBlock,
+               const QString& lang,
+               bool darkColorScheme,
+               bool showWhiteSpace,
+               bool showEndings,
+               int whitespaceValue,
+               const QHash<QString, QColor>& syntaxColors);
+    void setLimit(int lastBlock);
+    void applyEdit(int position, int removed, const QString& text);
+    void record(HighlightResult&& result);
+
+    /* Called in the GUI thread when the results aren't needed anymore. */
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+   signals:
+    /* "edits" is the number of edits that were applied when the blocks were highlighted. */
+    void highlighted(int edits, const QList<Texxy::HighlightResult>& results);
+
+   private:
+    void flush();
+
+    static constexpr qsizetype kMaxBatch = 512;  // a long pass is sent in parts
+
+    QTextDocument* doc_ = nullptr;
+    Highlighter* highlighter_ = nullptr;
+    int edits_ = 0;
+    QList<HighlightResult> results_;
+    std::atomic<bool> cancelled_{false};
+};
+
+/* Lets the blocks of a document be highlighted in a worker thread (shared by all
+   documents), so that the cost of highlighting a language isn't paid by typing or
+   scrolling. The edits of the document are sent to its mirror there, and the
+   format runs, states and block data that come back are put into the blocks as
+   pending results. Those of the visible blocks are applied at once, with setFormat()
+   in Highlighter::highlightBlock(); the others when the blocks become visible. */
+class HighlightWorker : public QObject {
+    Q_OBJECT
+
+   public:
+    explicit HighlightWorker(Highlighter* highlighter);
+    ~HighlightWorker() override;
+
+    /* Lets the worker thread highlight the blocks up to a little after "lastBlock"
+       (see Highlighter::highlightDirtyBlocks()). */
+    void setLimit(int lastBlock);
+
+   private:
+    /* An edit that the mirror hasn't reported yet, as the blocks that it changed. */
+    struct Edit {
+        int seq;
+        int firstBlock;
+        int lastBlock;  // before the edit
+        int blockDelta;
+    };
+
+    void onContentsChange(int position, int removed, int added);
+    void onHighlighted(int edits, const QList<HighlightResult>& results);
+
+    Highlighter* highlighter_;
+    QTextDocument* doc_;
+    HighlightMirror* mirror_;  // lives in the worker thread
+    int revision_;
+    int blockCount_;
+    int edits_;
+    int lastBlock_;
+    QList<Edit> inFlight_;
+
+    static constexpr int kLookahead = 200;  // blocks after the visible ones that are highlighted in advance
+};
+
+}  // namespace Texxy
+
+#endif  // HIGHLIGHTWORKER_H
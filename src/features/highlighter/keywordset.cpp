@@ -0,0 +1,188 @@
+// src/features/highlighter/keywordset.cpp
+/*
+ * texxy/highlighter/keywordset.cpp
+ */
+
+#include "keywordset.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Texxy {
+
+namespace {
+
+inline bool isWordChar(QChar c) {
+    const char16_t u = c.unicode();
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_';
+}
+
+inline quint32 hashOf(QStringView word) {
+    quint32 h = 2166136261u;  // FNV-1a
+    for (const QChar c : word) {
+        h ^= c.unicode();
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Reads the characters of a lookaround like "(?!(\.|-|@|#|\$))", from "pos" to its end.
+bool parseLookaround(const QString& pattern, qsizetype& pos, QLatin1String head, QString& chars) {
+    if (!QStringView(pattern).sliced(pos).startsWith(head))
+        return false;
+    pos += head.size();
+    QString res;
+    for (;;) {
+        if (pos >= pattern.size())
+            return false;
+        QChar c = pattern.at(pos);
+        if (c == QLatin1Char('\\')) {
+            if (++pos >= pattern.size() || isWordChar(pattern.at(pos)))
+                return false;  // like "\s"
+            c = pattern.at(pos);
+        }
+        else if (QStringView(u"()|[]{}.*+?^$").contains(c)) {
+            return false;
+        }
+        res += c;
+        ++pos;
+        if (pos < pattern.size() && pattern.at(pos) == QLatin1Char('|')) {
+            ++pos;
+            continue;
+        }
+        if (!QStringView(pattern).sliced(pos).startsWith(u"))"))
+            return false;
+        pos += 2;
+        chars = res;
+        return true;
+    }
+}
+
+}  // namespace
+
+bool KeywordSet::parse(const QString& pattern, Spec& spec) {
+    if (!pattern.startsWith(QLatin1String("\\b")) || !pattern.endsWith(QLatin1String("\\b")))
+        return false;
+    qsizetype pos = 2;
+    QString notBefore, notAfter;
+    if (QStringView(pattern).sliced(pos).startsWith(u"(?<!(") &&
+        !parseLookaround(pattern, pos, QLatin1String("(?<!("), notBefore)) {
+        return false;
+    }
+    if (pos >= pattern.size() || pattern.at(pos) != QLatin1Char('('))
+        return false;
+    const qsizetype end = pattern.indexOf(QLatin1Char(')'), pos + 1);
+    if (end == -1)
+        return false;
+    const QStringList words = pattern.sliced(pos + 1, end - pos - 1).split(QLatin1Char('|'));
+    for (const QString& word : words) {
+        if (word.isEmpty() || !isWordChar(word.front()) || !isWordChar(word.back()))
+            return false;
+        for (qsizetype i = 0; i < word.size(); ++i) {
+            if (word.at(i) == QLatin1Char('.')) {
+                if (!isWordChar(word.at(i - 1)))
+                    return false;
+            }
+            else if (!isWordChar(word.at(i))) {
+                return false;
+            }
+        }
+    }
+    pos = end + 1;
+    if (QStringView(pattern).sliced(pos).startsWith(u"(?!(") &&
+        !parseLookaround(pattern, pos, QLatin1String("(?!("), notAfter)) {
+        return false;
+    }
+    if (pos != pattern.size() - 2)
+        return false;
+
+    spec.words = words;
+    spec.notBefore = notBefore;
+    spec.notAfter = notAfter;
+    return true;
+}
+
+KeywordSet::KeywordSet(const Spec& spec) : notBefore_(spec.notBefore), notAfter_(spec.notAfter) {
+    quint32 slotCount = 16;
+    while (slotCount < 2u * static_cast<quint32>(spec.words.size()))  // at most half full
+        slotCount <<= 1;
+    slots_.assign(slotCount, -1);
+    mask_ = slotCount - 1;
+
+    entries_.reserve(spec.words.size());
+    for (const QString& word : spec.words) {
+        if (contains(word))
+            continue;  // a repeated word
+        const Entry entry{static_cast<int>(chars_.size()), static_cast<int>(word.size())};
+        chars_ += word;
+        quint32 slot = hashOf(word) & mask_;
+        while (slots_[slot] != -1)
+            slot = (slot + 1) & mask_;
+        slots_[slot] = static_cast<int>(entries_.size());
+        entries_.push_back(entry);
+        if (word.contains(QLatin1Char('.')))
+            qualified_ = true;
+    }
+}
+
+bool KeywordSet::contains(QStringView word) const {
+    if (entries_.empty())
+        return false;
+    quint32 slot = hashOf(word) & mask_;
+    for (int i = slots_[slot]; i != -1; slot = (slot + 1) & mask_, i = slots_[slot]) {
+        const Entry& entry = entries_[i];
+        if (entry.length == word.size() &&
+            std::memcmp(chars_.constData() + entry.offset, word.data(), word.size() * sizeof(QChar)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the length of the word that starts at the identifier [start, end), or 0.
+int KeywordSet::matchAt(const QString& text, int start, int end) const {
+    const int size = text.size();
+    int length = 0;
+    for (;;) {
+        if ((end == size || !notAfter_.contains(text.at(end))) &&
+            contains(QStringView(text).sliced(start, end - start))) {
+            length = end - start;
+        }
+        if (!qualified_ || end + 1 >= size || text.at(end) != QLatin1Char('.') || !isWordChar(text.at(end + 1)))
+            break;
+        end += 2;
+        while (end < size && isWordChar(text.at(end)))
+            ++end;
+    }
+    return length;
+}
+
+int KeywordSet::indexIn(const QString& text, int from, int* length) const {
+    const int size = text.size();
+    int i = std::max(from, 0);
+    /* go to the start of the next identifier */
+    if (i > 0 && i < size && isWordChar(text.at(i - 1))) {
+        while (i < size && isWordChar(text.at(i)))
+            ++i;
+    }
+    while (i < size) {
+        if (!isWordChar(text.at(i))) {
+            ++i;
+            continue;
+        }
+        int end = i + 1;
+        while (end < size && isWordChar(text.at(end)))
+            ++end;
+        if (i == 0 || !notBefore_.contains(text.at(i - 1))) {
+            if (const int l = matchAt(text, i, end)) {
+                if (length)
+                    *length = l;
+                return i;
+            }
+        }
+        i = end;
+    }
+    return -1;
+}
+
+}  // namespace Texxy
@@ -0,0 +1,68 @@
+// src/features/highlighter/keywordset.h
+/*
+ * texxy/highlighter/keywordset.h
+ */
+
+#ifndef KEYWORDSET_H
+#define KEYWORDSET_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include <vector>
+
+namespace Texxy {
+
+/* An immutable set of words (keywords, types, class names...) that finds them
+   in a text by splitting it into identifiers and looking each one up in an open
+   addressing table, instead of trying a regex alternation of all words at every
+   position. It stands for a pattern like
+
+       \b(?<!(@|#))(if|else|while)(?!(\.|-|@|#|\$))\b
+
+   that is, a word that is a whole identifier (of ASCII letters, digits and
+   underscores, as with "\w" of QRegularExpression) and isn't preceded or
+   followed by some characters. A word may be qualified with dots ("Map.Entry"),
+   in which case the longest qualified match is found. */
+class KeywordSet {
+   public:
+    struct Spec {
+        QStringList words;
+        QString notBefore;  // characters that may not precede a word
+        QString notAfter;   // characters that may not follow it
+    };
+
+    /* Splits a pattern of the above form into "spec". Returns false, without
+       changing "spec", if the pattern is anything else. */
+    static bool parse(const QString& pattern, Spec& spec);
+
+    explicit KeywordSet(const Spec& spec);
+
+    /* Like QString::indexOf() with the equivalent regex: returns the index of the
+       first word at or after "from", or -1, and sets "length" to its length. */
+    int indexIn(const QString& text, int from, int* length = nullptr) const;
+
+    bool contains(QStringView word) const;
+    int size() const { return static_cast<int>(entries_.size()); }
+
+   private:
+    struct Entry {
+        int offset;
+        int length;
+    };
+
+    int matchAt(const QString& text, int start, int end) const;
+
+    QString chars_;  // all words, one after another
+    std::vector<Entry> entries_;
+    std::vector<int> slots_;  // indices of "entries_", -1 for an empty slot
+    quint32 mask_ = 0;
+    bool qualified_ = false;  // whether a word has a dot
+    QString notBefore_;
+    QString notAfter_;
+};
+
+}  // namespace Texxy
+
+#endif  // KEYWORDSET_H
@@ -0,0 +1,79 @@
+// src/features/highlighter/regexcache.cpp
+/*
+ * texxy/highlighter/regexcache.cpp
+ */
+
+#include "regexcache.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QtDebug>
+
+#include <atomic>
+
+namespace Texxy {
+
+namespace {
+
+// patterns made of delimiters are few in a document but may pile up over many documents
+constexpr qsizetype kMaxEntries = 1024;
+
+struct Key {
+    QString pattern;
+    QRegularExpression::PatternOptions options;
+    bool operator==(const Key& other) const { return options == other.options && pattern == other.pattern; }
+};
+
+size_t qHash(const Key& key, size_t seed = 0) {
+    return ::qHash(key.pattern, seed) ^ static_cast<size_t>(key.options.toInt());
+}
+
+QMutex mutex;
+QHash<Key, QRegularExpression> cache;  // guarded by "mutex"
+std::atomic<quint64> compiled{0};
+
+#ifndef QT_NO_DEBUG
+QElapsedTimer second;  // guarded by "mutex"
+int compiledInSecond = 0;
+#endif
+
+}  // namespace
+
+QRegularExpression RegexCache::get(const QString& pattern, QRegularExpression::PatternOptions options) {
+    const Key key{pattern, options};
+    {
+        QMutexLocker locker(&mutex);
+        const auto it = cache.constFind(key);
+        if (it != cache.constEnd())
+            return it.value();
+    }
+
+    // compiled outside the lock; if another thread compiles the same pattern, one of them is kept
+    QRegularExpression exp(pattern, options);
+    exp.optimize();
+    compiled.fetch_add(1, std::memory_order_relaxed);
+
+    QMutexLocker locker(&mutex);
+    if (cache.size() >= kMaxEntries)
+        cache.clear();  // the copies in use keep their compiled patterns
+    cache.insert(key, exp);
+#ifndef QT_NO_DEBUG
+    // a pattern that is built on a hot path shows up as a steady rate
+    ++compiledInSecond;
+    if (!second.isValid()) {
+        second.start();
+    }
+    else if (second.elapsed() >= 1000) {
+        qDebug("RegexCache: %d regex compilations in %lld ms", compiledInSecond, second.restart());
+        compiledInSecond = 0;
+    }
+#endif
+    return exp;
+}
+
+quint64 RegexCache::compilations() noexcept {
+    return compiled.load(std::memory_order_relaxed);
+}
+
+}  // namespace Texxy
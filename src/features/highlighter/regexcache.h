@@ -0,0 +1,31 @@
+// src/features/highlighter/regexcache.h
+/*
+ * texxy/highlighter/regexcache.h
+ */
+
+#ifndef REGEXCACHE_H
+#define REGEXCACHE_H
+
+#include <QRegularExpression>
+#include <QString>
+
+namespace Texxy {
+
+/* A process-wide cache of the regular expressions whose patterns are known only
+   at runtime (like here-doc delimiters or patterns made of other patterns), so
+   that each of them is compiled once, when it is first asked for, instead of
+   whenever a block is highlighted. The expressions are optimized and immutable;
+   a copy shares the compiled pattern. Patterns that are known at compile time are
+   function-local statics instead. Thread-safe. */
+class RegexCache {
+   public:
+    static QRegularExpression get(const QString& pattern,
+                                  QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+
+    /* The number of expressions that have been compiled by the cache so far. */
+    static quint64 compilations() noexcept;
+};
+
+}  // namespace Texxy
+
+#endif  // REGEXCACHE_H
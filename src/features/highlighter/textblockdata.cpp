@@ -15,6 +15,16 @@ void clearPointerList(QList<T*>& container) {
     container.clear();
 }
 
+template <typename T>
+QList<T*> copyPointerList(const QList<T*>& container) {
+    QList<T*> copy;
+    copy.reserve(container.size());
+    for (const T* ptr : container) {
+        copy.append(new T(*ptr));
+    }
+    return copy;
+}
+
 template <typename T>
 void insertByPosition(QList<T*>& container, T* info) {
     int index = 0;
@@ -34,6 +44,24 @@ TextBlockData::~TextBlockData() {
     clearPointerList(allBrackets);
 }
 /*************************/
+TextBlockData* TextBlockData::clone() const {
+    auto* copy = new TextBlockData;
+    copy->allParentheses = copyPointerList(allParentheses);
+    copy->allBraces = copyPointerList(allBraces);
+    copy->allBrackets = copyPointerList(allBrackets);
+    copy->label = label;
+    copy->Highlighted = Highlighted;
+    copy->Property = Property;
+    copy->Dirty = Dirty;
+    copy->LastState = LastState;
+    copy->OpenNests = OpenNests;
+    copy->LastFormattedQuote = LastFormattedQuote;
+    copy->LastFormattedRegex = LastFormattedRegex;
+    copy->OpenQuotes = OpenQuotes;
+    copy->Checkpoint = Checkpoint;
+    return copy;
+}
+/*************************/
 QList<ParenthesisInfo*> TextBlockData::parentheses() const {
     return allParentheses;
 }
@@ -78,6 +106,18 @@ QSet<int> TextBlockData::openQuotes() const {
     return OpenQuotes;
 }
 /*************************/
+bool TextBlockData::isDirty() const {
+    return Dirty;
+}
+/*************************/
+size_t TextBlockData::checkpoint() const {
+    return Checkpoint;
+}
+/*************************/
+size_t TextBlockData::stateHash(int blockState) const {
+    return qHashMulti(0, blockState, Property, OpenNests, LastFormattedQuote, LastFormattedRegex, label, OpenQuotes);
+}
+/*************************/
 void TextBlockData::insertInfo(ParenthesisInfo* info) {
     insertByPosition(allParentheses, info);
 }
@@ -121,5 +161,13 @@ void TextBlockData::insertLastFormattedRegex(int last) {
 void TextBlockData::insertOpenQuotes(const QSet<int>& openQuotes) {
     OpenQuotes.unite(openQuotes);
 }
+/*************************/
+void TextBlockData::setDirty(bool dirty) {
+    Dirty = dirty;
+}
+/*************************/
+void TextBlockData::setCheckpoint(size_t checkpoint) {
+    Checkpoint = checkpoint;
+}
 
 }  // namespace Texxy
@@ -31,11 +31,6 @@ struct ScopedUpdatesOff {
     bool was;
 };
 
-// ensures we always make progress when a match is zero length
-inline void advanceAtLeastOne(QTextCursor& c) {
-    c.movePosition(QTextCursor::NextCharacter, QTextCursor::MoveAnchor);
-}
-
 // compute replacement highlight color once per pass
 inline QColor replaceColor(const TextEdit* te) {
     return te->hasDarkScheme() ? QColor(Qt::darkGreen) : QColor(Qt::green);
@@ -219,90 +214,30 @@ void TexxyWindow::replaceAll() {
     }
     es.reserve(es.size() + 128);  // reduce realloc churn for many matches
 
-    const QTextDocument::FindFlags searchFlags = getSearchFlags();
-
-    // precompile regex if enabled
-    QRegularExpression regexFind;
-    const bool useRegex = tabPage->matchRegex();
-    if (useRegex) {
-        regexFind = QRegularExpression(txtFind, (searchFlags & QTextDocument::FindCaseSensitively)
-                                                    ? QRegularExpression::NoPatternOption
-                                                    : QRegularExpression::CaseInsensitiveOption);
-    }
-
     // align the primary cursor to its anchor to avoid accidental partial selections
     QTextCursor origin = textEdit->textCursor();
     origin.setPosition(origin.anchor());
     textEdit->setTextCursor(origin);
 
-    const QColor color = replaceColor(textEdit);
-
-    QTextCursor start = origin;
-    QTextCursor tmp = start;
-    int count = 0;
-
-    QTextEdit::ExtraSelection extra;
-    extra.format.setBackground(color);
-
     // block signals and updates during the batch edit for speed
     const QSignalBlocker blocker(textEdit);
     ScopedUpdatesOff updatesOff(textEdit->viewport());
 
     makeBusy();
 
-    start.beginEditBlock();
-    start.setPosition(0);
-
-    // repeatedly find then replace, enforcing progress for zero-length matches
-    QTextCursor found;
-    int lastPos = -1;
-
-    while (!(found = textEdit->finding(txtFind, start, searchFlags, useRegex)).isNull()) {
-        const int matchStart = found.anchor();
-        const int matchEnd = found.position();
+    QList<QTextCursor> replaced;
+    const int count =
+        textEdit->replaceAll(txtFind, txtReplace, getSearchFlags(), tabPage->matchRegex(), &replaced, 1000);
 
-        // guard against zero-length progress to avoid infinite loops on patterns like ^ or lookarounds
-        if (matchEnd == matchStart && matchEnd == lastPos) {
-            advanceAtLeastOne(start);
-            continue;
-        }
-        lastPos = matchEnd;
-
-        start.setPosition(matchStart);
-        start.setPosition(matchEnd, QTextCursor::KeepAnchor);
-
-        if (useRegex) {
-            const QString replaced = found.selectedText().replace(regexFind, txtReplace);
-            start.insertText(replaced);
-            if (count < 1000) {
-                tmp.setPosition(matchStart);
-                tmp.setPosition(start.position(), QTextCursor::KeepAnchor);
-                extra.cursor = tmp;
-                es.append(extra);
-            }
-        }
-        else {
-            start.insertText(txtReplace);
-            if (count < 1000) {
-                tmp.setPosition(matchStart);
-                tmp.setPosition(start.position(), QTextCursor::KeepAnchor);
-                extra.cursor = tmp;
-                es.append(extra);
-            }
-        }
-
-        // continue scanning from end of the inserted text
-        start.setPosition(start.position());
-        ++count;
+    unbusy();
 
-        // for zero-length matches ensure we always advance at least one character
-        if (start.position() == matchEnd)
-            advanceAtLeastOne(start);
+    QTextEdit::ExtraSelection extra;
+    extra.format.setBackground(replaceColor(textEdit));
+    for (const QTextCursor& cursor : std::as_const(replaced)) {
+        extra.cursor = cursor;
+        es.append(extra);
     }
 
-    start.endEditBlock();
-    unbusy();
-
     textEdit->setGreenSel(es);
     textEdit->setExtraSelections(composeSelections(textEdit, es));
 
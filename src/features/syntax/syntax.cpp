@@ -410,7 +410,8 @@ void TexxyWindow::syntaxHighlighting(TextEdit* textEdit, bool highlight, const Q
                 config.getShowEndings(), config.getWhiteSpaceValue(),
                 config.customSyntaxColors().isEmpty()
                     ? (textEdit->hasDarkScheme() ? config.darkSyntaxColors() : config.lightSyntaxColors())
-                    : config.customSyntaxColors());
+                    : config.customSyntaxColors(),
+                true);
             textEdit->setHighlighter(highlighter);
         }
 
@@ -480,11 +481,14 @@ void TexxyWindow::formatTextRect() const {
             QTextCursor end = textEdit->cursorForPosition(bottomRight);
 
             highlighter->setLimit(start, end);
+            highlighter->highlightDirtyBlocks();
 
+            // with a worker thread, only what it has sent is applied
+            const bool worker = highlighter->usesWorker();
             QTextBlock block = start.block();
             while (block.isValid() && block.blockNumber() <= end.blockNumber()) {
                 if (auto* data = static_cast<TextBlockData*>(block.userData())) {
-                    if (!data->isHighlighted())
+                    if (worker ? data->hasPendingResult() : !data->isHighlighted())
                         highlighter->rehighlightBlock(block);
                 }
                 block = block.next();
@@ -0,0 +1,91 @@
+// src/features/textedit/append.cpp
+#include "textedit/textedit_prelude.h"
+
+namespace Texxy {
+
+/* A streamed file is shown as soon as its first part is in the document. The
+   rest is appended at the end in short time slices, so that the view can be
+   painted and scrolled while the text is still arriving. */
+void TextEdit::startQueuingText() {
+    textQueue_.clear();
+    queuingText_ = true;
+    textQueueClosed_ = false;
+    pendingLine_ = -1;
+    softBreaks_.clear();
+    softBreakRevision_ = -1;
+    queuedSoftBreaks_.clear();
+    document()->setUndoRedoEnabled(false);  // appending is not an edit
+}
+
+void TextEdit::queueText(const QString& text, bool last) {
+    if (!queuingText_)
+        return;
+    // queue pieces of a limited size but don't split CRLF or a surrogate pair
+    qsizetype from = 0;
+    while (from < text.size()) {
+        qsizetype n = std::min<qsizetype>(kAppendSliceChars, text.size() - from);
+        while (from + n < text.size() &&
+               (text.at(from + n - 1) == QLatin1Char('\r') || text.at(from + n - 1).isHighSurrogate()))
+            ++n;
+        textQueue_.append(text.mid(from, n));
+        from += n;
+    }
+    if (last)
+        textQueueClosed_ = true;
+    if (!appendScheduled_) {
+        appendScheduled_ = true;
+        QTimer::singleShot(0, this, &TextEdit::appendQueuedText);
+    }
+}
+
+void TextEdit::goToLineWhenAppended(qint64 line, int posInLine) {
+    pendingLine_ = std::max<qint64>(0, line);
+    pendingPosInLine_ = posInLine;
+    goToPendingLine();
+}
+
+void TextEdit::goToPendingLine() {
+    if (pendingLine_ < 0)
+        return;
+    // the last block may still be incomplete
+    const bool complete = !queuingText_ || (textQueue_.isEmpty() && textQueueClosed_);
+    if (pendingLine_ >= blockCount() - 1 && !complete)
+        return;
+
+    const QTextBlock block =
+        document()->findBlockByNumber(static_cast<int>(std::min<qint64>(pendingLine_, blockCount() - 1)));
+    const int endPos = block.length() - 1;
+    QTextCursor cur(block);
+    cur.setPosition(block.position() + (pendingPosInLine_ < 0 ? endPos : std::min(pendingPosInLine_, endPos)));
+    setTextCursor(cur);
+    centerCursor();
+    pendingLine_ = -1;
+}
+
+void TextEdit::appendQueuedText() {
+    appendScheduled_ = false;
+
+    QElapsedTimer timer;
+    timer.start();
+    QTextCursor cur(document());
+    cur.movePosition(QTextCursor::End);
+    while (!textQueue_.isEmpty() && timer.elapsed() < kAppendSliceMs)
+        cur.insertText(textQueue_.takeFirst());
+    document()->setModified(false);
+    goToPendingLine();
+
+    if (!textQueue_.isEmpty()) {
+        appendScheduled_ = true;
+        QTimer::singleShot(0, this, &TextEdit::appendQueuedText);
+    }
+    else if (textQueueClosed_) {
+        queuingText_ = false;
+        textQueueClosed_ = false;
+        applySoftBreaks(queuedSoftBreaks_);
+        queuedSoftBreaks_.clear();
+        document()->setUndoRedoEnabled(true);
+        emit queuedTextAppended();
+    }
+}
+
+}  // namespace Texxy
@@ -111,8 +111,20 @@ QMimeData* TextEdit::createMimeDataFromSelection() const {
     if (!cur.hasSelection())
         return nullptr;
 
+    QString text = cur.selection().toPlainText();  // a character for each one of the selection
+    if (hasSoftBreaks()) {
+        // the soft separators aren't in the file
+        const int start = cur.selectionStart();
+        const QList<int> positions = softBreakPositions();
+        auto it = std::upper_bound(positions.cbegin(), positions.cend(), cur.selectionEnd() - 1);
+        while (it != positions.cbegin() && *(it - 1) >= start) {
+            --it;
+            text.remove(*it - start, 1);
+        }
+    }
+
     auto* md = new QMimeData;
-    md->setText(cur.selection().toPlainText());
+    md->setText(text);
     return md;
 }
 
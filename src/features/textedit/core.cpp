@@ -80,9 +80,21 @@ TextEdit::TextEdit(QWidget* parent, int bgColorValue) : QPlainTextEdit(parent) {
     highlightThisSelection_ = true;
     removeSelectionHighlights_ = false;
     size_ = 0;
+    contentHash_ = 0;
     wordNumber_ = -1;  // not calculated yet
     encoding_ = "UTF-8";
+    lineEnd_ = LineEnd::Lf;
+    mixedLineEnds_ = false;
     uneditable_ = false;
+    largeFirstLine_ = 0;
+    movingLargeWindow_ = false;
+    queuingText_ = false;
+    textQueueClosed_ = false;
+    appendScheduled_ = false;
+    pendingLine_ = -1;
+    pendingPosInLine_ = 0;
+    softBreakRevision_ = -1;
+    follower_ = nullptr;
 
     setMouseTracking(true);
     // document()->setUseDesignMetrics(true)
@@ -180,6 +192,39 @@ void TextEdit::setEditorFont(const QFont& f, bool setDefault) {
     }
 }
 
+/*************************/
+void TextEdit::adoptDocument(QTextDocument* doc) {
+    QTextDocument* old = document();
+    if (!doc || doc == old)
+        return;
+
+    doc->setDefaultFont(old->defaultFont());
+    doc->setDefaultTextOption(old->defaultTextOption());  // tab stops and whitespace flags
+    doc->setDocumentMargin(old->documentMargin());
+    doc->setUndoRedoEnabled(old->isUndoRedoEnabled());
+    doc->setModified(false);
+    doc->setParent(this);
+
+    // the cursors of these selections belong to the old document
+    greenSel_.clear();
+    blueSel_.clear();
+    colSel_.clear();
+    redSel_.clear();
+    setExtraSelections(QList<QTextEdit::ExtraSelection>());
+    softBreaks_.clear();
+    softBreakRevision_ = -1;
+
+    disconnect(old, &QTextDocument::contentsChange, this, &TextEdit::onContentsChange);
+    const int cursorW = cursorWidth();  // a property of the layout
+    setDocument(doc);                   // deletes the initial document
+    setCursorWidth(cursorW);
+    if (selectionHighlighting_)
+        connect(doc, &QTextDocument::contentsChange, this, &TextEdit::onContentsChange, Qt::UniqueConnection);
+
+    if (old->parent() == this)  // adopted before
+        old->deleteLater();
+}
+
 /*************************/
 TextEdit::~TextEdit() {
     if (scrollTimer_) {
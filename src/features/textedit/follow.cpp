@@ -0,0 +1,58 @@
+// src/features/textedit/follow.cpp
+#include "textedit/textedit_prelude.h"
+
+#include "filefollower.h"
+
+namespace Texxy {
+
+/* A followed file is read from the size it had when it was loaded or saved,
+   so nothing that was written in between is missed. Appending isn't an edit:
+   it can't be undone and leaves the document unmodified. */
+void TextEdit::startFollowing() {
+    stopFollowing();
+    if (fileName_.isEmpty())
+        return;
+    follower_ = new FileFollower(fileName_, encoding_, size_, this);
+    connect(follower_, &FileFollower::appended, this, &TextEdit::appendFollowedText);
+    connect(follower_, &FileFollower::replaced, this, &TextEdit::followedFileReplaced);
+    lineIndex_.reset();  // lines will be added
+    document()->setUndoRedoEnabled(false);
+}
+
+void TextEdit::stopFollowing() {
+    if (!follower_)
+        return;
+    follower_->disconnect(this);
+    follower_->deleteLater();  // it may be emitting
+    follower_ = nullptr;
+    document()->setUndoRedoEnabled(true);
+}
+
+bool TextEdit::needsReopening() const {
+    return follower_ && follower_->isReplaced();
+}
+
+void TextEdit::appendFollowedText(const QString& text, bool replacesLast, const QDateTime& lastModified) {
+    // the view follows the end only while the cursor is there, as with "tail -f"
+    const bool atEnd = textCursor().atEnd() && !textCursor().hasSelection();
+    QTextCursor cur(document());
+    cur.movePosition(QTextCursor::End);
+    // an incomplete character at the end was decoded as a replacement
+    if (replacesLast && document()->characterAt(cur.position() - 1) == QChar::ReplacementCharacter)
+        cur.deletePreviousChar();
+    cur.insertText(text);  // only the new blocks are highlighted
+    document()->setModified(false);
+
+    size_ = follower_->offset();
+    contentHash_ = 0;  // the appended bytes aren't hashed
+    lastModified_ = lastModified;  // not a change elsewhere
+
+    if (atEnd) {
+        QTextCursor end = textCursor();
+        end.movePosition(QTextCursor::End);
+        setTextCursor(end);
+        ensureCursorVisible();
+    }
+}
+
+}  // namespace Texxy
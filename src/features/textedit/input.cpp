@@ -7,6 +7,9 @@ namespace Texxy {
 void TextEdit::keyPressEvent(QKeyEvent* event) {
     keepTxtCurHPos_ = false;
 
+    if (largeFile_ && handleLargeFileKey(event))
+        return;
+
     // first, handle special cases of pressing Ctrl
     if (event->modifiers() & Qt::ControlModifier) {
         if (event->modifiers() == Qt::ControlModifier) {  // no other modifier is pressed
@@ -580,8 +583,9 @@ void TextEdit::keyPressEvent(QKeyEvent* event) {
             for (int i = 0; i <= newLines; ++i) {
                 // skip leading spaces to align the real text
                 int indx = 0;
+                static const QRegularExpression leadingSpaces("^\\s+");
                 QRegularExpressionMatch match;
-                if (cursor.block().text().indexOf(QRegularExpression("^\\s+"), 0, &match) > -1)
+                if (cursor.block().text().indexOf(leadingSpaces, 0, &match) > -1)
                     indx = match.capturedLength();
                 cursor.setPosition(cursor.block().position() + indx);
                 if (event->modifiers() & Qt::ControlModifier) {
@@ -742,8 +746,9 @@ void TextEdit::keyPressEvent(QKeyEvent* event) {
             QTextCursor cur = textCursor();
             int p = cur.positionInBlock();
             int indx = 0;
+            static const QRegularExpression leadingSpaces("^\\s+");
             QRegularExpressionMatch match;
-            if (cur.block().text().indexOf(QRegularExpression("^\\s+"), 0, &match) > -1)
+            if (cur.block().text().indexOf(leadingSpaces, 0, &match) > -1)
                 indx = match.capturedLength();
             if (p > 0) {
                 p = (p <= indx) ? 0 : indx;
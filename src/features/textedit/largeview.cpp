@@ -0,0 +1,116 @@
+// src/features/textedit/largeview.cpp
+#include "textedit/textedit_prelude.h"
+
+namespace Texxy {
+
+/* Only a window of a large file is put into the document. The window is
+   moved when the view gets close to one of its edges, and line numbers,
+   "Go to line" and the line count are translated to the whole file. */
+void TextEdit::setLargeFile(const QSharedPointer<LargeFile>& file, qint64 firstLine) {
+    QScrollBar* vbar = verticalScrollBar();
+    disconnect(vbar, &QScrollBar::valueChanged, this, &TextEdit::onLargeFileScrolled);
+    disconnect(vbar, &QScrollBar::sliderReleased, this, &TextEdit::onLargeFileScrolled);
+
+    largeFile_ = file;
+    largeFirstLine_ = 0;
+    if (!largeFile_)
+        return;
+
+    firstLine = std::clamp<qint64>(firstLine, 0, std::max<qint64>(0, largeFile_->lineCount() - kLargeWindowLines));
+    loadLargeWindow(firstLine, firstLine, firstLine, 0);
+
+    connect(vbar, &QScrollBar::valueChanged, this, &TextEdit::onLargeFileScrolled);
+    connect(vbar, &QScrollBar::sliderReleased, this, &TextEdit::onLargeFileScrolled);
+}
+
+void TextEdit::loadLargeWindow(qint64 firstLine, qint64 topLine, qint64 curLine, int curPosInLine) {
+    movingLargeWindow_ = true;
+
+    largeFirstLine_ = firstLine;
+    setPlainText(largeFile_->lines(firstLine, kLargeWindowLines));
+    if (topLine >= firstLine + blockCount()) {
+        // the window was cut short by very long lines
+        largeFirstLine_ = topLine;
+        setPlainText(largeFile_->lines(topLine, kLargeWindowLines));
+    }
+
+    const qint64 shown = blockCount();
+    auto blockOf = [this, shown](qint64 line) {
+        return document()->findBlockByNumber(static_cast<int>(std::clamp<qint64>(line - largeFirstLine_, 0, shown - 1)));
+    };
+
+    // keep the cursor where it was if it is inside the new window, otherwise put it at the top
+    const bool curInside = curLine >= largeFirstLine_ && curLine < largeFirstLine_ + shown;
+    const QTextBlock curBlock = blockOf(curInside ? curLine : topLine);
+    QTextCursor cur(curBlock);
+    if (curInside) {
+        const int endPos = curBlock.length() - 1;
+        cur.setPosition(curBlock.position() + (curPosInLine < 0 ? endPos : std::min(curPosInLine, endPos)));
+    }
+    QPlainTextEdit::setTextCursor(cur);
+
+    verticalScrollBar()->setValue(blockOf(topLine).firstLineNumber());
+
+    movingLargeWindow_ = false;
+}
+
+void TextEdit::onLargeFileScrolled() {
+    if (!largeFile_ || movingLargeWindow_ || verticalScrollBar()->isSliderDown())
+        return;
+
+    const qint64 shown = blockCount();
+    const qint64 top = firstVisibleBlock().blockNumber();
+    const qint64 edge = std::min<qint64>(kLargeEdgeLines, shown / 4);
+    const bool nearStart = largeFirstLine_ > 0 && top < edge;
+    const bool nearEnd = largeFirstLine_ + shown < largeFile_->lineCount() && shown - top < edge;
+    if (!nearStart && !nearEnd)
+        return;
+
+    const qint64 topLine = largeFirstLine_ + top;
+    const qint64 newFirst = std::clamp<qint64>(topLine - shown / 2, 0,
+                                               std::max<qint64>(0, largeFile_->lineCount() - kLargeWindowLines));
+    if (newFirst == largeFirstLine_)
+        return;
+
+    const QTextCursor cur = textCursor();
+    loadLargeWindow(newFirst, topLine, largeFirstLine_ + cur.blockNumber(), cur.positionInBlock());
+}
+
+void TextEdit::goToLargeLine(qint64 line, int posInLine) {
+    if (!largeFile_)
+        return;
+
+    line = std::clamp<qint64>(line, 0, largeFile_->lineCount() - 1);
+    if (line < largeFirstLine_ || line >= largeFirstLine_ + blockCount()) {
+        const qint64 first = std::clamp<qint64>(line - kLargeWindowLines / 2, 0,
+                                                std::max<qint64>(0, largeFile_->lineCount() - kLargeWindowLines));
+        loadLargeWindow(first, line, line, posInLine);
+    }
+
+    const QTextBlock block = document()->findBlockByNumber(static_cast<int>(line - largeFirstLine_));
+    QTextCursor cur(block);
+    const int endPos = block.length() - 1;
+    cur.setPosition(block.position() + (posInLine < 0 ? endPos : std::min(posInLine, endPos)));
+    setTextCursor(cur);
+    centerCursor();
+}
+
+bool TextEdit::handleLargeFileKey(QKeyEvent* event) {
+    if (event->matches(QKeySequence::MoveToStartOfDocument) || event->matches(QKeySequence::SelectStartOfDocument)) {
+        if (largeFirstLine_ > 0) {
+            goToLargeLine(0);
+            event->accept();
+            return true;
+        }
+    }
+    else if (event->matches(QKeySequence::MoveToEndOfDocument) || event->matches(QKeySequence::SelectEndOfDocument)) {
+        if (largeFirstLine_ + blockCount() < largeFile_->lineCount()) {
+            goToLargeLine(largeFile_->lineCount() - 1, -1);
+            event->accept();
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace Texxy
@@ -59,7 +59,7 @@ void TextEdit::showLineNumbers(bool show) {
 
 int TextEdit::lineNumberAreaWidth() {
     // compute number of digits for the largest visible line number
-    int blocks = std::max(1, blockCount());
+    qint64 blocks = std::max<qint64>(1, lineCount());
     int digits = 1;
     while (blocks >= 10) {
         blocks /= 10;
@@ -167,9 +167,16 @@ void TextEdit::lineNumberAreaPaintEvent(QPaintEvent* event) {
     QLocale loc = locale();
     loc.setNumberOptions(QLocale::OmitGroupSeparator);
 
+    // the numbers are those of the file, where the segments of a split line have none
+    const QList<int>& softBlocks = softBreakBlocks();
+    auto nextSoft = std::lower_bound(softBlocks.cbegin(), softBlocks.cend(), blockNumber);
+
     while (block.isValid() && top <= event->rect().bottom()) {
+        const bool segment = nextSoft != softBlocks.cend() && *nextSoft == blockNumber;
+        if (segment)
+            ++nextSoft;
         if (block.isVisible() && bottom >= event->rect().top()) {
-            const QString number = loc.toString(blockNumber + 1);
+            const QString number = segment ? QString() : loc.toString(lineOfBlock(blockNumber) + 1);
 
             if (blockNumber == curBlock) {
                 // remember the painted rectangle for targeted updates
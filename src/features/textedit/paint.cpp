@@ -218,8 +218,9 @@ void TextEdit::paintEvent(QPaintEvent* event) {
 
             // indentation guide lines based on leading whitespace of the block
             if (drawIndetLines_) {
+                static const QRegularExpression leadingSpaces("^\\s+");
                 QRegularExpressionMatch match;
-                if (block.text().indexOf(QRegularExpression("\\s+"), 0, &match) == 0) {
+                if (block.text().indexOf(leadingSpaces, 0, &match) == 0) {
                     painter.save();
                     painter.setOpacity(0.18);
 
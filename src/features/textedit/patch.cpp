@@ -0,0 +1,63 @@
+// src/features/textedit/patch.cpp
+#include "textedit/textedit_prelude.h"
+
+namespace Texxy {
+
+/* The hunks are applied from the last one, so that the block numbers of the
+   others still refer to the document. Lines are inserted and removed after the
+   end of the previous block where possible, so that the blocks around them,
+   with their highlighting data and layout, are left untouched. */
+void TextEdit::applyLineHunks(const QString& text, const QList<LineHunk>& hunks) {
+    const QList<QStringView> lines = splitBlocks(text);
+    auto joinLines = [&lines](int from, int count) {
+        QString joined;
+        for (int i = from; i < from + count; ++i) {
+            if (i > from)
+                joined += QLatin1Char('\n');
+            joined += lines.at(i);
+        }
+        return joined;
+    };
+
+    QTextDocument* doc = document();
+    QTextCursor cur(doc);
+    cur.beginEditBlock();
+    for (auto it = hunks.crbegin(); it != hunks.crend(); ++it) {
+        const LineHunk& hunk = *it;
+        if (hunk.oldCount > 0 && hunk.newCount > 0) {
+            const QTextBlock first = doc->findBlockByNumber(hunk.oldStart);
+            const QTextBlock last = doc->findBlockByNumber(hunk.oldStart + hunk.oldCount - 1);
+            cur.setPosition(first.position());
+            cur.setPosition(last.position() + last.length() - 1, QTextCursor::KeepAnchor);
+            cur.insertText(joinLines(hunk.newStart, hunk.newCount));
+        }
+        else if (hunk.newCount > 0) {
+            if (hunk.oldStart > 0) {
+                const QTextBlock prev = doc->findBlockByNumber(hunk.oldStart - 1);
+                cur.setPosition(prev.position() + prev.length() - 1);
+                cur.insertText(QLatin1Char('\n') + joinLines(hunk.newStart, hunk.newCount));
+            }
+            else {
+                cur.setPosition(0);
+                cur.insertText(joinLines(hunk.newStart, hunk.newCount) + QLatin1Char('\n'));
+            }
+        }
+        else if (hunk.oldCount > 0) {
+            const QTextBlock last = doc->findBlockByNumber(hunk.oldStart + hunk.oldCount - 1);
+            if (hunk.oldStart > 0) {
+                const QTextBlock prev = doc->findBlockByNumber(hunk.oldStart - 1);
+                cur.setPosition(prev.position() + prev.length() - 1);
+                cur.setPosition(last.position() + last.length() - 1, QTextCursor::KeepAnchor);
+            }
+            else {
+                cur.setPosition(0);
+                cur.setPosition(last.next().position(), QTextCursor::KeepAnchor);
+            }
+            cur.removeSelectedText();
+        }
+    }
+    cur.endEditBlock();
+    doc->setModified(false);
+}
+
+}  // namespace Texxy
@@ -1,13 +1,15 @@
 // src/features/textedit/search.cpp
 #include "textedit/textedit_prelude.h"
 
+#include "regexcache.h"
+
 namespace {
 
 QRegularExpression buildRegex(const QString& pattern, QTextDocument::FindFlags flags) {
     QRegularExpression::PatternOptions opts = QRegularExpression::NoPatternOption;
     if (!(flags & QTextDocument::FindCaseSensitively))
         opts |= QRegularExpression::CaseInsensitiveOption;
-    return QRegularExpression(pattern, opts);
+    return Texxy::RegexCache::get(pattern, opts);  // not recompiled for every match of Replace All
 }
 
 bool exceedsLimit(const QTextCursor& cursor, int limit, bool backward) {
@@ -17,6 +19,11 @@ bool exceedsLimit(const QTextCursor& cursor, int limit, bool backward) {
     return backward ? (cursor.anchor() < limit) : (cursor.selectionEnd() > limit);
 }
 
+// ensures we always make progress when a match is zero length
+inline void advanceAtLeastOne(QTextCursor& c) {
+    c.movePosition(QTextCursor::NextCharacter, QTextCursor::MoveAnchor);
+}
+
 }  // namespace
 
 namespace Texxy {
@@ -61,4 +68,65 @@ QTextCursor TextEdit::finding(const QString& str,
     return result;
 }
 
+int TextEdit::replaceAll(const QString& str,
+                         const QString& replacement,
+                         QTextDocument::FindFlags flags,
+                         bool useRegex,
+                         QList<QTextCursor>* replaced,
+                         int maxReplaced) {
+    if (str.isEmpty() || !document())
+        return 0;
+
+    // precompile regex if enabled
+    QRegularExpression regexFind;
+    if (useRegex)
+        regexFind = buildRegex(str, flags);
+
+    QTextCursor start(document());
+    QTextCursor tmp = start;
+    int count = 0;
+
+    start.beginEditBlock();
+
+    // repeatedly find then replace, enforcing progress for zero-length matches
+    QTextCursor found;
+    int lastPos = -1;
+
+    while (!(found = finding(str, start, flags, useRegex)).isNull()) {
+        const int matchStart = found.anchor();
+        const int matchEnd = found.position();
+
+        // guard against zero-length progress to avoid infinite loops on patterns like ^ or lookarounds
+        if (matchEnd == matchStart && matchEnd == lastPos) {
+            advanceAtLeastOne(start);
+            continue;
+        }
+        lastPos = matchEnd;
+
+        start.setPosition(matchStart);
+        start.setPosition(matchEnd, QTextCursor::KeepAnchor);
+
+        if (useRegex)
+            start.insertText(found.selectedText().replace(regexFind, replacement));
+        else
+            start.insertText(replacement);
+        if (replaced && count < maxReplaced) {
+            tmp.setPosition(matchStart);
+            tmp.setPosition(start.position(), QTextCursor::KeepAnchor);
+            replaced->append(tmp);
+        }
+
+        // continue scanning from end of the inserted text
+        start.setPosition(start.position());
+        ++count;
+
+        // for zero-length matches ensure we always advance at least one character
+        if (start.position() == matchEnd)
+            advanceAtLeastOne(start);
+    }
+
+    start.endEditBlock();
+    return count;
+}
+
 }  // namespace Texxy
@@ -0,0 +1,90 @@
+// src/features/textedit/softbreaks.cpp
+#include "textedit/textedit_prelude.h"
+
+namespace Texxy {
+
+/* A soft separator is bracketed by two cursors, one moving with insertions at
+   its position and one staying. Nothing can be inserted between them, so they
+   are one character apart exactly as long as the separator isn't removed;
+   a separator that is removed and then restored by undo becomes a real one. */
+void TextEdit::setSoftBreaks(const QList<int>& blocks) {
+    if (queuingText_) {
+        queuedSoftBreaks_ = blocks;
+        return;
+    }
+    applySoftBreaks(blocks);
+}
+
+void TextEdit::applySoftBreaks(const QList<int>& blocks) {
+    softBreaks_.clear();
+    softBreakRevision_ = -1;
+    softBreaks_.reserve(blocks.size());
+    QTextDocument* doc = document();
+    for (const int number : blocks) {
+        const QTextBlock block = doc->findBlockByNumber(number);
+        if (!block.isValid() || block.position() == 0)
+            continue;
+        SoftBreak softBreak{QTextCursor(doc), QTextCursor(doc)};
+        softBreak.before.setPosition(block.position() - 1);
+        softBreak.after.setPosition(block.position());
+        softBreak.after.setKeepPositionOnInsert(true);
+        softBreaks_.append(softBreak);
+    }
+}
+
+QList<int> TextEdit::softBreakPositions() const {
+    QList<int> positions;
+    for (const SoftBreak& softBreak : softBreaks_) {
+        const int pos = softBreak.before.position();
+        if (softBreak.after.position() - pos == 1)
+            positions.append(pos);
+    }
+    return positions;
+}
+
+/* The soft breaks are few (only huge lines have them), but the line numbers
+   are painted often, so their blocks are found once per revision. */
+const QList<int>& TextEdit::softBreakBlocks() const {
+    const int revision = document()->revision();
+    if (softBreakRevision_ != revision) {
+        softBreakBlocks_.clear();
+        for (const SoftBreak& softBreak : softBreaks_) {
+            if (softBreak.after.position() - softBreak.before.position() == 1)
+                softBreakBlocks_.append(softBreak.after.blockNumber());
+        }
+        softBreakRevision_ = revision;
+    }
+    return softBreakBlocks_;
+}
+
+qint64 TextEdit::lineOfBlock(int blockNumber) const {
+    const QList<int>& blocks = softBreakBlocks();
+    const qint64 segments = std::upper_bound(blocks.cbegin(), blocks.cend(), blockNumber) - blocks.cbegin();
+    return largeFirstLine_ + blockNumber - segments;
+}
+
+int TextEdit::positionInLine(const QTextCursor& cursor) const {
+    int pos = cursor.positionInBlock();
+    const QList<int>& blocks = softBreakBlocks();
+    QTextBlock block = cursor.block();
+    auto it = std::upper_bound(blocks.cbegin(), blocks.cend(), block.blockNumber());
+    // each soft break before the block, from the nearest on, adds the previous segment
+    while (it != blocks.cbegin() && *(it - 1) == block.blockNumber()) {
+        --it;
+        block = block.previous();
+        pos += block.length() - 1;
+    }
+    return pos;
+}
+
+int TextEdit::blockOfLine(qint64 line) const {
+    qint64 block = line - largeFirstLine_;
+    for (const int softBlock : softBreakBlocks()) {
+        if (softBlock > block)
+            break;
+        ++block;  // a segment of a previous line
+    }
+    return static_cast<int>(std::min<qint64>(block, std::numeric_limits<int>::max()));
+}
+
+}  // namespace Texxy
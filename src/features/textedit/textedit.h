@@ -9,9 +9,16 @@
 #include <QDateTime>
 #include <QElapsedTimer>
 #include <QSyntaxHighlighter>
+#include <QSharedPointer>
+
+#include "largefile.h"
+#include "linediff.h"
+#include "lineindex.h"
 
 namespace Texxy {
 
+class FileFollower;
+
 /* This is for auto-indentation, line numbers, DnD, zooming, customized
    vertical scrollbar, appropriate signals, and saving/getting useful info. */
 class TextEdit : public QPlainTextEdit {
@@ -30,6 +37,9 @@ class TextEdit : public QPlainTextEdit {
     bool pastingIsPossible() const;
 
     void setEditorFont(const QFont& f, bool setDefault = true);
+    /* Replaces the document with "doc" (which has a QPlainTextDocumentLayout), keeping
+       the settings of the current one. The connections of others aren't moved. */
+    void adoptDocument(QTextDocument* doc);
     void adjustScrollbars();
 
     void lineNumberAreaPaintEvent(QPaintEvent* event);
@@ -84,6 +94,8 @@ class TextEdit : public QPlainTextEdit {
 
     qint64 getSize() const { return size_; }
     void setSize(qint64 size) { size_ = size; }
+    quint64 getContentHash() const { return contentHash_; }
+    void setContentHash(quint64 hash) { contentHash_ = hash; }
 
     QDateTime getLastModified() const { return lastModified_; }
     void setLastModified(const QDateTime& m) { lastModified_ = m; }
@@ -112,6 +124,12 @@ class TextEdit : public QPlainTextEdit {
     QString getEncoding() const { return encoding_; }
     void setEncoding(const QString& encoding) { encoding_ = encoding; }
 
+    /* The line ends of the file, which are kept on saving (see LineScan). */
+    LineEnd getLineEnd() const { return lineEnd_; }
+    void setLineEnd(LineEnd lineEnd) { lineEnd_ = lineEnd; }
+    bool hasMixedLineEnds() const { return mixedLineEnds_; }
+    void setMixedLineEnds(bool mixed) { mixedLineEnds_ = mixed; }
+
     QList<QTextEdit::ExtraSelection> getGreenSel() const { return greenSel_; }
     void setGreenSel(QList<QTextEdit::ExtraSelection> sel) { greenSel_ = sel; }
 
@@ -147,6 +165,63 @@ class TextEdit : public QPlainTextEdit {
         txtCurHPos_ = -1;
     }
 
+    /* Large files are shown through a window of lines that follows scrolling. */
+    LargeFile* getLargeFile() const { return largeFile_.data(); }
+    qint64 getLargeFirstLine() const { return largeFirstLine_; }  // file line of the first block
+    void setLargeFile(const QSharedPointer<LargeFile>& file, qint64 firstLine = 0);
+    void goToLargeLine(qint64 line, int posInLine = 0);
+    /* The lines of the file, even those that aren't in the document yet. */
+    qint64 lineCount() const {
+        if (largeFile_)
+            return largeFile_->lineCount();
+        if (queuingText_ && lineIndex_)
+            return lineIndex_->lineCount();
+        return blockCount() - softBreakBlocks().size();
+    }
+
+    /* The line index of the loaded file, as long as the text is not edited or saved. */
+    const LineIndex* getLineIndex() const {
+        return lineIndex_ && !document()->isModified() ? lineIndex_.data() : nullptr;
+    }
+    void setLineIndex(const QSharedPointer<LineIndex>& index) { lineIndex_ = index; }
+
+    /* While a file is streamed in, its text is appended in time slices. */
+    void startQueuingText();
+    void queueText(const QString& text, bool last);
+    bool isQueuingText() const { return queuingText_; }
+    /* Puts the cursor on a line as soon as it is appended ("posInLine" < 0 means its end). */
+    void goToLineWhenAppended(qint64 line, int posInLine = 0);
+
+    /* Turns the document into "text" by replacing only the lines in "hunks" (see
+       diffLines()), as a single edit that leaves the document unmodified. */
+    void applyLineHunks(const QString& text, const QList<LineHunk>& hunks);
+
+    /* In follow mode, what is written to the file is appended to the document, from
+       where the file was loaded or saved (see FileFollower). The view follows the
+       end while the cursor is there. followedFileReplaced() means that the file
+       should be reopened, after which following is started again. */
+    void startFollowing();
+    void stopFollowing();
+    bool isFollowing() const { return follower_ != nullptr; }
+    bool needsReopening() const;
+
+    /* Soft breaks are the block separators that were put into lines too long
+       for layout (see LineSplitter). They are given as the numbers of the blocks
+       after them, are kept while the text is edited around them and are left
+       out of the saved and copied text. With a streamed text, they are set after
+       appending. Like any block separator, a soft one ends the text that a search
+       can match, so a match that spans one isn't found. */
+    void setSoftBreaks(const QList<int>& blocks);
+    bool hasSoftBreaks() const { return !softBreaks_.isEmpty(); }
+    /* The positions of the soft separators that are still in the document, in order. */
+    QList<int> softBreakPositions() const;
+    /* The 0-based line of the file that contains a block, and the first block of
+       such a line; they differ only after soft breaks. */
+    qint64 lineOfBlock(int blockNumber) const;
+    int blockOfLine(qint64 line) const;
+    /* The position of a cursor in its line of the file (not only in its block). */
+    int positionInLine(const QTextCursor& cursor) const;
+
     bool getSelectionHighlighting() const { return selectionHighlighting_; }
     void setSelectionHighlighting(bool enable);
     static bool isOnlySpaces(const QString& str);
@@ -166,6 +241,15 @@ class TextEdit : public QPlainTextEdit {
                         QTextDocument::FindFlags flags = QTextDocument::FindFlags(),
                         bool isRegex = false,
                         const int end = 0) const;
+    /* Replaces every match of "str" in the document as a single edit and returns
+       the number of replacements. The first "maxReplaced" replaced texts are put
+       into "replaced" as selections. */
+    int replaceAll(const QString& str,
+                   const QString& replacement,
+                   QTextDocument::FindFlags flags = QTextDocument::FindFlags(),
+                   bool isRegex = false,
+                   QList<QTextCursor>* replaced = nullptr,
+                   int maxReplaced = 0);
 
     /*************************
      ***** View Position *****
@@ -192,6 +276,8 @@ class TextEdit : public QPlainTextEdit {
     void updateBracketMatching();
     void hugeColumn();
     void canCopy(bool yes);
+    void queuedTextAppended();  // all of the queued text is in the document
+    void followedFileReplaced();
 
    public slots:
     void copy();
@@ -233,11 +319,18 @@ class TextEdit : public QPlainTextEdit {
     void onUpdateRequesting(const QRect&, int dy);
     void onSelectionChanged();
     void scrollWithInertia();
+    void onLargeFileScrolled();
+    void appendQueuedText();
+    void appendFollowedText(const QString& text, bool replacesLast, const QDateTime& lastModified);
 
    private:
     static constexpr int kUpdateIntervalMs = 50;    // timer interval (ms)
     static constexpr int kScrollFramesPerSec = 60;  // inertia animation FPS
     static constexpr int kScrollDurationMs = 300;   // inertia animation duration (ms)
+    static constexpr qint64 kLargeWindowLines = 4000;  // lines of a large file kept in the document
+    static constexpr int kLargeEdgeLines = 500;        // the window moves when the view gets this close to its edge
+    static constexpr int kAppendSliceChars = 32 * 1024;  // queued text is inserted in pieces of this size
+    static constexpr int kAppendSliceMs = 12;            // time spent on appending before input is processed
     QString computeIndentation(const QTextCursor& cur) const;
     QString remainingSpaces(const QString& spaceTab, const QTextCursor& cursor) const;
     QTextCursor backTabCursor(const QTextCursor& cursor, bool twoSpace) const;
@@ -248,6 +341,11 @@ class TextEdit : public QPlainTextEdit {
     void cutColumn();
     void deleteColumn();
     void pasteOnColumn();
+    void loadLargeWindow(qint64 firstLine, qint64 topLine, qint64 curLine, int curPosInLine);
+    bool handleLargeFileKey(QKeyEvent* event);
+    void goToPendingLine();
+    void applySoftBreaks(const QList<int>& blocks);
+    const QList<int>& softBreakBlocks() const;
 
     int prevAnchor_, prevPos_;  // used only for bracket matching
     QWidget* lineNumberArea_;
@@ -277,6 +375,7 @@ class TextEdit : public QPlainTextEdit {
      ***** All needed information on a page *****
      ********************************************/
     qint64 size_;             // file size for limiting syntax highlighting (the file may be removed)
+    quint64 contentHash_;     // fingerprint of the file as it was loaded or saved (0 if unknown)
     QDateTime lastModified_;  // the last modification time for knowing about changes.
     int wordNumber_;          // the calculated number of words (-1 if not counted yet)
     QString searchedText_;    // the text that is being searched in the document
@@ -285,6 +384,8 @@ class TextEdit : public QPlainTextEdit {
     QString prog_;            // real programming language (never empty; defaults to "url")
     QString lang_;            // selected (enforced) programming language (empty if nothing's enforced)
     QString encoding_;        // text encoding (UTF-8 by default)
+    LineEnd lineEnd_;         // the most common line end of the file (LF by default)
+    bool mixedLineEnds_;      // the file had more than one kind of line ends
     /*
        Highlighting order: (1) current line;
                            (2) replacing;
@@ -302,6 +403,25 @@ class TextEdit : public QPlainTextEdit {
     bool matchedBrackets_;                       // is bracket matching done (is TexxyWindow::matchBrackets called)?
     bool uneditable_;                            // the doc should be made uneditable because of its contents
     QPointer<QSyntaxHighlighter> highlighter_;   // syntax highlighter
+    QSharedPointer<LargeFile> largeFile_;        // the mapped file if only a window of it is in the document
+    qint64 largeFirstLine_;                      // file line of the first block of the window
+    bool movingLargeWindow_;                     // used only internally
+    QList<QString> textQueue_;                   // streamed text waiting to be appended
+    bool queuingText_;                           // the document is being streamed in
+    bool textQueueClosed_;                       // the last part of the streamed text is queued
+    bool appendScheduled_;                       // appendQueuedText() is already scheduled
+    qint64 pendingLine_;                         // the line to go to when it is appended (or -1)
+    int pendingPosInLine_;                       // the cursor position in that line
+    QSharedPointer<LineIndex> lineIndex_;        // line starts and longest line of the loaded file
+    struct SoftBreak {
+        QTextCursor before;  // at the separator (moves with insertions there)
+        QTextCursor after;   // after the separator (stays with insertions there)
+    };
+    QList<SoftBreak> softBreaks_;                // separators that aren't in the file
+    QList<int> queuedSoftBreaks_;                // soft breaks of the text being appended
+    mutable QList<int> softBreakBlocks_;         // the blocks after the soft breaks that are still there
+    mutable int softBreakRevision_;              // the document revision of softBreakBlocks_ (or -1)
+    FileFollower* follower_;                     // the file is followed
     bool saveCursor_;
     bool pastePaths_;
     /******************************
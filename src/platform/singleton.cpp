@@ -1,6 +1,7 @@
 // src/platform/singleton.cpp
 
 #include "singleton.h"
+#include "messagebox.h"
 #include "texxyadaptor.h"
 
 #include <QApplication>
@@ -54,6 +55,10 @@ TexxyApplication::TexxyApplication(int& argc, char** argv) : QApplication(argc,
     config_.readConfig();
     lastFiles_ = config_.getLastFiles();
 
+    loaderPool_ = new LoaderPool(config_.getLoaderThreads(), this);
+    saverPool_ = new LoaderPool(0, this);  // Save All writes many files at once
+    fileWatcher_ = new FileWatcher(this);
+
     if (config_.getSharedSearchHistory())
         searchModel_ = new QStandardItemModel(0, 1, this);
     else
@@ -97,6 +102,8 @@ void TexxyApplication::quitting() {
 
 void TexxyApplication::quitSignalReceived() {
     quitSignalReceived_ = true;
+    if (journal_)
+        journal_->keepAll();  // the windows are closed without prompts
     quit();
 }
 
@@ -251,9 +258,42 @@ void TexxyApplication::firstWin(const QStringList& info) {
     long d = -1;
     bool openNewWin = false;
 
-    const QStringList filesList = processInfo(info, d, lineNum, posInLine, &openNewWin);
+    QStringList filesList = processInfo(info, d, lineNum, posInLine, &openNewWin);
+
+    // the unsaved texts of a process that didn't end properly are offered for recovery
+    journal_ = new Journal(this);
+    QList<Journal::Recovery> recoveries = journal_->takeOrphans();
+    if (!recoveries.isEmpty()) {
+        MessageBox msgBox;
+        msgBox.setIcon(QMessageBox::Question);
+        msgBox.addButton(QMessageBox::Yes);
+        msgBox.addButton(QMessageBox::No);
+        msgBox.changeButtonText(QMessageBox::Yes, tr("Yes"));
+        msgBox.changeButtonText(QMessageBox::No, tr("No"));
+        msgBox.setText(QStringLiteral("<center><b><big>%1</big></b></center>")
+                           .arg(tr("Texxy was not closed properly last time.")));
+        msgBox.setInformativeText(QStringLiteral("<center><i>%1</i></center>")
+                                      .arg(tr("Do you want to recover the unsaved changes of %n document(s)?", "",
+                                              recoveries.size())));
+        msgBox.setDefaultButton(QMessageBox::Yes);
+        if (msgBox.exec() == QMessageBox::Yes) {
+            // the recovered files are opened by the window
+            const bool hasFiles = !filesList.isEmpty();
+            for (const Journal::Recovery& recovery : std::as_const(recoveries)) {
+                filesList.removeAll(recovery.fileName);
+                lastFiles_.removeAll(recovery.fileName);
+            }
+            if (hasFiles)
+                lastFiles_.clear();
+        }
+        else {
+            recoveries.clear();
+        }
+    }
 
-    newWin(filesList, lineNum, posInLine);
+    TexxyWindow* window = newWin(filesList, lineNum, posInLine);
+    if (!recoveries.isEmpty())
+        window->recoverDocuments(recoveries);
 
     lastFiles_.clear();
 }
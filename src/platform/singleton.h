@@ -5,6 +5,9 @@
 #include <QStandardItemModel>
 #include "texxywindow.h"
 #include "config.h"
+#include "filewatcher.h"
+#include "journal.h"
+#include "loaderpool.h"
 
 namespace Texxy {
 
@@ -30,6 +33,10 @@ class TexxyApplication : public QApplication {
     QList<TexxyWindow*> Wins;
 
     Config& getConfig() { return config_; }
+    LoaderPool* getLoaderPool() const { return loaderPool_; }
+    LoaderPool* getSaverPool() const { return saverPool_; }
+    FileWatcher* getFileWatcher() const { return fileWatcher_; }
+    Journal* getJournal() const { return journal_; }
 
     bool isPrimaryInstance() const { return isPrimaryInstance_; }
     bool isStandAlone() const { return standalone_; }
@@ -61,6 +68,10 @@ class TexxyApplication : public QApplication {
     bool isWayland_ = false;
     bool isRoot_ = false;
     QStandardItemModel* searchModel_ = nullptr;
+    LoaderPool* loaderPool_ = nullptr;
+    LoaderPool* saverPool_ = nullptr;
+    FileWatcher* fileWatcher_ = nullptr;
+    Journal* journal_ = nullptr;  // created with the first window
 };
 
 }  // namespace Texxy
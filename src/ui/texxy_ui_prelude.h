@@ -7,6 +7,7 @@
 #include "loading.h"
 #include "messagebox.h"
 #include "pref.h"
+#include "saving.h"
 #include "session.h"
 #include "singleton.h"
 #include "svgicons.h"
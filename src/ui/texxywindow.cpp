@@ -12,6 +12,8 @@ TexxyWindow::TexxyWindow(QWidget* parent) : QMainWindow(parent), dummyWidget(nul
     shownBefore_ = false;
     closePreviousPages_ = false;
     loadingProcesses_ = 0;
+    scrollToFirstItem_ = false;
+    firstSideItem_ = nullptr;
     rightClicked_ = -1;
 
     autoSaver_ = nullptr;
@@ -82,6 +84,7 @@ TexxyWindow::TexxyWindow(QWidget* parent) : QMainWindow(parent), dummyWidget(nul
     }
     // exceptions
     defaultShortcuts_.insert(ui->actionSaveAllFiles, QKeySequence());
+    defaultShortcuts_.insert(ui->actionFollow, QKeySequence());
     defaultShortcuts_.insert(ui->actionSoftTab, QKeySequence());
     defaultShortcuts_.insert(ui->actionStartCase, QKeySequence());
     defaultShortcuts_.insert(ui->actionFont, QKeySequence());
@@ -129,6 +132,7 @@ TexxyWindow::TexxyWindow(QWidget* parent) : QMainWindow(parent), dummyWidget(nul
     connect(ui->tabWidget, &QTabWidget::tabCloseRequested, this, &TexxyWindow::closeTabAtIndex);
     connect(ui->actionOpen, &QAction::triggered, this, &TexxyWindow::fileOpen);
     connect(ui->actionReload, &QAction::triggered, this, &TexxyWindow::reload);
+    connect(ui->actionFollow, &QAction::triggered, this, &TexxyWindow::toggleFollowing);
     connect(aGroup_, &QActionGroup::triggered, this, &TexxyWindow::enforceEncoding);
     connect(ui->actionSave, &QAction::triggered, this, [this] { saveFile(false); });
     connect(ui->actionSaveAs, &QAction::triggered, this, [this] { saveFile(false); });
@@ -215,6 +219,9 @@ TexxyWindow::TexxyWindow(QWidget* parent) : QMainWindow(parent), dummyWidget(nul
             sidePane_->listWidget()->scrollToCurrentItem();
     });
 
+    connect(static_cast<TexxyApplication*>(qApp)->getFileWatcher(), &FileWatcher::stateChanged, this,
+            &TexxyWindow::onFileStateChanged);
+
     ui->actionSidePane->setAutoRepeat(false);  // don't let UI change too rapidly
     connect(ui->actionSidePane, &QAction::triggered, this, &TexxyWindow::toggleSidePane);
 
@@ -254,6 +261,22 @@ TexxyWindow::TexxyWindow(QWidget* parent) : QMainWindow(parent), dummyWidget(nul
 TexxyWindow::~TexxyWindow() {
     startAutoSaving(false);
 
+    // files that are still being loaded have nowhere to go
+    static_cast<TexxyApplication*>(qApp)->getLoaderPool()->cancel(this);
+    // nor can their loaders be counted off when the tabs are deleted after this
+    const QList<TextEdit*> textEdits = findChildren<TextEdit*>();
+    for (TextEdit* textEdit : textEdits)
+        textEdit->disconnect(this);
+
+    // files that are still being written are finished without updating the pages
+    LoaderPool* saverPool = static_cast<TexxyApplication*>(qApp)->getSaverPool();
+    for (SaveJob& job : saveJobs_) {  // in the order of their snapshots
+        queueSaving(job);
+        saverPool->startNow(job.saving);
+        job.saving->wait();
+    }
+    saveJobs_.clear();
+
     delete dummyWidget;
     dummyWidget = nullptr;
 
@@ -274,6 +297,7 @@ void TexxyWindow::closeEvent(QCloseEvent* event) {
         return;
     }
 
+    waitForSaving();  // the pages should know whether their files are written
     const bool keep = locked_ || closePages(-1, -1, true);
     if (keep) {
         event->ignore();
@@ -947,23 +971,9 @@ bool TexxyWindow::event(QEvent* event) {
     if (event->type() == QEvent::ActivationChange && isActiveWindow()) {
         if (auto* tabPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget())) {
             if (auto* textEdit = tabPage->textEdit().data()) {
-                const QString fname = textEdit->getFileName();
-                if (!fname.isEmpty()) {
-                    if (!QFile::exists(fname)) {
-                        if (isLoading())
-                            connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningNonexistent,
-                                    Qt::UniqueConnection);
-                        else
-                            onOpeningNonexistent();
-                    }
-                    else if (textEdit->getLastModified() != QFileInfo(fname).lastModified()) {
-                        showWarningBar(
-                            "<center><b><big>" + tr("This file has been modified elsewhere or in another way!") +
-                                "</big></b></center>\n" + "<center>" +
-                                tr("Please be careful about reloading or saving this document!") + "</center>",
-                            15);
-                    }
-                }
+                // the cached state is used now; a change found by the new check comes later
+                warnAboutFileState(textEdit);
+                static_cast<TexxyApplication*>(qApp)->getFileWatcher()->refresh(textEdit->getFileName());
             }
         }
     }
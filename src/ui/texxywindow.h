@@ -12,6 +12,7 @@
 #include "ui/tabpage.h"
 #include "ui/sidepane.h"
 #include "config.h"
+#include "journal.h"
 
 namespace Texxy {
 
@@ -19,6 +20,8 @@ namespace Ui {
 class TexxyWindow;
 }
 
+class Saving;
+
 // A Texxy window.
 class TexxyWindow : public QMainWindow {
     Q_OBJECT
@@ -51,6 +54,7 @@ class TexxyWindow : public QMainWindow {
     void updateCustomizableShortcuts(bool disable = false);
 
     void startAutoSaving(bool start, int interval = 1);
+    void recoverDocuments(const QList<Journal::Recovery>& recoveries);
 
     QHash<QAction*, QKeySequence> defaultShortcuts() const { return defaultShortcuts_; }
 
@@ -89,6 +93,9 @@ class TexxyWindow : public QMainWindow {
     void closeOtherPages();
     void fileOpen();
     void reload();
+    void toggleFollowing(bool follow);
+    void onFollowedFileReplaced();
+    void reopenFollowed();
     void enforceEncoding(QAction* a);
     void cutText();
     void copyText();
@@ -167,12 +174,19 @@ class TexxyWindow : public QMainWindow {
                  int restoreCursor,
                  int posInLine,
                  bool uneditable,  // This doc should be uneditable?
-                 bool multiple);   // Multiple files are being loaded?
+                 bool multiple,    // Multiple files are being loaded?
+                 const QSharedPointer<LargeFile>& largeFile);  // Set only for files that are too large to load
+    void appendText(const QString& text, bool last);
     void onOpeningHugeFiles();
+    void onOpeningLargeFiles();
+    void onOpeningCompressedFiles();
+    void onOpeningTruncatedFiles();
     void onOpeninNonTextFiles();
     void onPermissionDenied();
     void onOpeningUneditable();
     void onOpeningNonexistent();
+    void onFileStateChanged(const QString& path);
+    void onRecoveringFiles();
     void columnWarning();
     void autoSave();
     void pauseAutoSaving(bool pause);
@@ -185,6 +199,16 @@ class TexxyWindow : public QMainWindow {
 
    private:
     enum DOCSTATE { SAVED, UNDECIDED, DISCARDED };
+    /* A document that is being written in the background. */
+    struct SaveJob {
+        Saving* saving;
+        QPointer<TextEdit> textEdit;
+        int revision;  // of the document when it was taken
+        bool keepSyntax;
+        bool saveAll;  // started by saveAllFiles()
+        bool showWarning;
+        bool queued;  // given to the saver pool after the earlier savings of its file
+    };
     static constexpr int kMaxLastWinFiles = 50;
 
     TabPage* createEmptyTab(bool setCurrent, bool allowNormalHighlighter = true);
@@ -199,6 +223,8 @@ class TexxyWindow : public QMainWindow {
                   bool multiple = false);
     void openFilesFromDialog();
     bool alreadyOpen(TabPage* tabPage) const;
+    bool canFollow(TextEdit* textEdit) const;
+    void warnAboutFileState(TextEdit* textEdit);
     void setWinTitle(const QString& title);
     void setTitle(const QString& fileName, int tabIndex = -1);
     DOCSTATE savePrompt(int tabIndex,
@@ -217,6 +243,20 @@ class TexxyWindow : public QMainWindow {
     void reloadSyntaxHighlighter(TextEdit* textEdit);
     void lockWindow(TabPage* tabPage, bool lock);
     void saveAllFiles(bool showWarning);
+    bool chooseLineEnds(TextEdit* textEdit, const QString& encoding, LineEnd& lineEnd);
+    void startSaving(TextEdit* textEdit,
+                     const QString& fname,
+                     const QString& encoding,
+                     LineEnd lineEnd,
+                     bool keepSyntax,
+                     bool saveAll,
+                     bool showWarning = false);
+    void queueSaving(SaveJob& job);
+    bool finishSaving(Saving* saving);
+    void finishSavingAll();
+    bool waitForSaving(TextEdit* textEdit = nullptr);
+    void updateSavedPage(TabPage* tabPage, const QString& encoding, bool keepSyntax);
+    void updateSavedInactivePage(TabPage* tabPage);
     void closeEvent(QCloseEvent* event);
     bool closePages(int first, int last, bool saveFilesList = false);
     void dragEnterEvent(QDragEnterEvent* event);
@@ -252,6 +292,11 @@ class TexxyWindow : public QMainWindow {
     void showWarningBar(const QString& message, int timeout = 10, bool startupBar = false);
     void closeWarningBar(bool keepOnStartup = false);
     void disconnectLambda();
+    void restoreCursorOnLoading(TextEdit* textEdit, const QString& fileName, int restoreCursor, int posInLine);
+    void adoptDocument(TextEdit* textEdit, QTextDocument* doc);
+    void finishLoading(TextEdit* textEdit, bool reload, bool uneditable, const TextEdit::viewPosition& vPos);
+    void dropLoadingProcess();
+    void showReadOnly(TextEdit* textEdit, bool uneditable, bool updateActions);
     void updateLangBtn(TextEdit* textEdit);
     void updateGUIForSingleTab(bool single);
     void stealFocus(QWidget* w);
@@ -259,13 +304,9 @@ class TexxyWindow : public QMainWindow {
     void addRecentFile(const QString& file);
     bool showSaveDialogAndSetFileName(QString& fname, const QString& filter, const QString& title);
     void removeTrailingSpacesIfNeeded(TextEdit* textEdit);
-    bool writeFileWithEncoding(const QString& fname, TextEdit* textEdit, bool& MSWinLineEnd);
     void handleSaveFailure(const QString& fname);
-    bool writeUtf16File(const QString& fname, TextEdit* textEdit);
-    bool promptAndWriteWithChosenEOL(const QString& fname,
-                                     TextEdit* textEdit,
-                                     const QString& encoding,
-                                     bool& MSWinLineEnd);
+    void recoverText(TextEdit* textEdit);
+    void replayRecovery(TabPage* tabPage, const Journal::Recovery& recovery);
 
     QActionGroup* aGroup_;
     QString lastFile_;                          // The last opened or saved file (for file dialogs).
@@ -273,6 +314,9 @@ class TexxyWindow : public QMainWindow {
     int rightClicked_;                          // The index/row of the right-clicked tab/item.
     int loadingProcesses_;                      // The number of loading processes (used to prevent early closing).
     QMetaObject::Connection lambdaConnection_;  // Captures a lambda connection to disconnect it later.
+    QHash<QObject*, QPointer<TextEdit>> streamedTexts_;  // Loaders whose texts are still being streamed.
+    bool scrollToFirstItem_;                             // Only for the side-pane mode.
+    QListWidgetItem* firstSideItem_;                     // Only for the side-pane mode.
     SidePane* sidePane_;
     QHash<QListWidgetItem*, TabPage*> sideItems_;  // For fast tab switching.
     QHash<QString, QAction*> langs_;               // All programming languages (to be enforced by the user).
@@ -286,6 +330,10 @@ class TexxyWindow : public QMainWindow {
     // Needed with saving as root:
     bool locked_;
     bool closePreviousPages_;
+    QList<SaveJob> saveJobs_;  // Documents that are being written in the background.
+    QList<QPointer<TabPage>> savedAllPages_;  // Pages saved by saveAllFiles() but not updated yet.
+    QStringList unsavedAllFiles_;             // Files that saveAllFiles() couldn't write.
+    QHash<QString, Journal::Recovery> recoveries_;  // Unsaved texts of the files that are being loaded.
 };
 
 }  // namespace Texxy
@@ -22,10 +22,12 @@ void TexxyWindow::deleteTabPage(int tabIndex, bool saveToList, bool closeWithLas
     Config& config = static_cast<TexxyApplication*>(qApp)->getConfig();
 
     if (!fileName.isEmpty()) {
+        // the cursor position of a large file is relative to its window
+        const int curPos = textEdit->getLargeFile() ? 0 : textEdit->textCursor().position();
         if (textEdit->getSaveCursor())
-            config.saveCursorPos(fileName, textEdit->textCursor().position());
+            config.saveCursorPos(fileName, curPos);
         if (saveToList && config.getSaveLastFilesList() && QFile::exists(fileName))
-            lastWinFilesCur_.insert(fileName, textEdit->textCursor().position());
+            lastWinFilesCur_.insert(fileName, curPos);
     }
 
     // deleting the syntax highlighter changes the text, disconnect contentsChange to prevent a crash
@@ -78,6 +80,7 @@ TabPage* TexxyWindow::createEmptyTab(bool setCurrent, bool allowNormalHighlighte
         textEdit->document()->setDocumentMargin(12);
         textEdit->document()->setModified(false);
     }
+    singleton->getJournal()->track(textEdit->document(), QString(), QString(), 0);
 
     if (allowNormalHighlighter && ui->actionSyntax->isChecked())
         syntaxHighlighting(textEdit);  // the default url syntax highlighter
@@ -131,6 +134,7 @@ TabPage* TexxyWindow::createEmptyTab(bool setCurrent, bool allowNormalHighlighte
     connect(textEdit, &TextEdit::filePasted, this, &TexxyWindow::newTabFromName);
     connect(textEdit, &TextEdit::zoomedOut, this, &TexxyWindow::reformat);
     connect(textEdit, &TextEdit::hugeColumn, this, &TexxyWindow::columnWarning);
+    connect(textEdit, &TextEdit::followedFileReplaced, this, &TexxyWindow::onFollowedFileReplaced);
 
     connect(tabPage, &TabPage::find, this, &TexxyWindow::find);
     connect(tabPage, &TabPage::searchFlagChanged, this, &TexxyWindow::searchFlagChanged);
@@ -268,23 +272,74 @@ void TexxyWindow::loadText(const QString& fileName,
                            int posInLine,
                            bool enforceUneditable,
                            bool multiple) {
+    // the current tab and the first file of a batch are loaded before the others
+    const bool urgent = reload || enforceEncod || !isLoading();
     ++loadingProcesses_;
 
     QString charset;
     if (enforceEncod)
         charset = checkToEncoding();
 
+    auto* singleton = static_cast<TexxyApplication*>(qApp);
     auto* thread = new Loading(fileName, charset, reload, restoreCursor, posInLine, enforceUneditable, multiple);
-    thread->setSkipNonText(static_cast<TexxyApplication*>(qApp)->getConfig().getSkipNonText());
+    thread->setSkipNonText(singleton->getConfig().getSkipNonText());
+    thread->setProgressive(!reload && !enforceEncod);
+    // a reloaded text is compared with the current one in the loader's thread
+    if (reload) {
+        if (auto* tabPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget())) {
+            TextEdit* textEdit = tabPage->textEdit();
+            if (textEdit->getFileName() == fileName && !textEdit->getLargeFile() && !textEdit->hasSoftBreaks() &&
+                !textEdit->isQueuingText()) {
+                thread->setBaseText(textEdit->document()->toRawText(), textEdit->document()->revision());
+            }
+            else if (textEdit->getFileName() == fileName && textEdit->getLargeFile() && !enforceEncod) {
+                thread->setKnownContent(textEdit->getSize(), textEdit->getContentHash());
+            }
+        }
+    }
     connect(thread, &Loading::completed, this, &TexxyWindow::addText);
-    connect(thread, &Loading::finished, thread, &QObject::deleteLater);
-    thread->start();
+    connect(thread, &Loading::chunkLoaded, this, &TexxyWindow::appendText);
+    singleton->getLoaderPool()->enqueue(thread, this, urgent);
 
     makeBusy();
     ui->tabWidget->tabBar()->lockTabs(true);
     updateShortcuts(true, false);
 }
 
+/* Gives a document that was built by a loader to a text edit and moves the
+   window's connections from the old document to it. */
+void TexxyWindow::adoptDocument(TextEdit* textEdit, QTextDocument* doc) {
+    QTextDocument* old = textEdit->document();
+    const bool wordInfo = disconnect(old, &QTextDocument::contentsChange, this, &TexxyWindow::updateWordInfo);
+    const bool formatting = disconnect(old, &QTextDocument::contentsChange, this, &TexxyWindow::formatOnTextChange);
+    const bool max = disconnect(old, &QTextDocument::blockCountChanged, this, &TexxyWindow::setMax);
+    const bool saving = disconnect(old, &QTextDocument::modificationChanged, this, &TexxyWindow::enableSaving);
+    const bool title = disconnect(old, &QTextDocument::modificationChanged, this, &TexxyWindow::asterisk);
+    const bool undo = disconnect(old, &QTextDocument::undoAvailable, ui->actionUndo, &QAction::setEnabled);
+    const bool redo = disconnect(old, &QTextDocument::redoAvailable, ui->actionRedo, &QAction::setEnabled);
+
+    textEdit->adoptDocument(doc);
+
+    if (wordInfo)
+        connect(doc, &QTextDocument::contentsChange, this, &TexxyWindow::updateWordInfo);
+    if (formatting)
+        connect(doc, &QTextDocument::contentsChange, this, &TexxyWindow::formatOnTextChange);
+    if (max)
+        connect(doc, &QTextDocument::blockCountChanged, this, &TexxyWindow::setMax);
+    if (saving)
+        connect(doc, &QTextDocument::modificationChanged, this, &TexxyWindow::enableSaving);
+    if (title)
+        connect(doc, &QTextDocument::modificationChanged, this, &TexxyWindow::asterisk);
+    if (undo) {
+        connect(doc, &QTextDocument::undoAvailable, ui->actionUndo, &QAction::setEnabled);
+        ui->actionUndo->setEnabled(false);  // as after setPlainText()
+    }
+    if (redo) {
+        connect(doc, &QTextDocument::redoAvailable, ui->actionRedo, &QAction::setEnabled);
+        ui->actionRedo->setEnabled(false);
+    }
+}
+
 void TexxyWindow::addText(const QString& text,
                           const QString& fileName,
                           const QString& charset,
@@ -293,10 +348,18 @@ void TexxyWindow::addText(const QString& text,
                           int restoreCursor,
                           int posInLine,
                           bool uneditable,
-                          bool multiple) {
+                          bool multiple,
+                          const QSharedPointer<LargeFile>& largeFile) {
+    auto* loader = qobject_cast<Loading*>(QObject::sender());
+
     // early error and special-case routing
     if (fileName.isEmpty() || charset.isEmpty()) {
-        if (!fileName.isEmpty() && charset.isEmpty())  // very large file
+        if (loader && loader->isUnchanged()) {  // a reloaded large file was only touched
+            TextEdit* textEdit = currentTextEdit();
+            if (textEdit && textEdit->getFileName() == fileName)
+                textEdit->setLastModified(QFileInfo(fileName).lastModified());
+        }
+        else if (!fileName.isEmpty() && charset.isEmpty())  // very large file
             connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningHugeFiles, Qt::UniqueConnection);
         else if (fileName.isEmpty() && !charset.isEmpty())  // non-text file that shouldn't be opened
             connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeninNonTextFiles,
@@ -304,24 +367,15 @@ void TexxyWindow::addText(const QString& text,
         else
             connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onPermissionDenied, Qt::UniqueConnection);
 
-        --loadingProcesses_;  // cannot become negative
-        if (!isLoading()) {
-            ui->tabWidget->tabBar()->lockTabs(false);
-            updateShortcuts(false, false);
-            closeWarningBar();
-            emit finishedLoading();
-            QTimer::singleShot(0, this, &TexxyWindow::unbusy);
-            stealFocus();
-        }
+        dropLoadingProcess();
         return;
     }
 
     if (enforceEncod || reload)
         multiple = false;
 
-    // only for the side-pane mode
-    static bool scrollToFirstItem = false;
-    static QListWidgetItem* firstItem = nullptr;
+    // only the first part of a streamed text has arrived
+    const bool streaming = loader && loader->isStreaming();
 
     TabPage* tabPage = nullptr;
     if (ui->tabWidget->currentIndex() == -1)
@@ -343,10 +397,19 @@ void TexxyWindow::addText(const QString& text,
     }
     else {
         if (sidePane_ && !reload && !enforceEncod)  // an unused empty tab
-            scrollToFirstItem = true;
+            scrollToFirstItem_ = true;
     }
 
     textEdit->setSaveCursor(restoreCursor == 1);
+
+    // a reloaded text that differs from the document in a few lines is patched,
+    // so that the undo history, highlighting and layout of the other lines survive
+    const bool patching = reload && loader && loader->hasLineDiff() && !largeFile && !textEdit->getLargeFile() &&
+                          !textEdit->isQueuingText() && !textEdit->hasSoftBreaks() &&
+                          textEdit->document()->revision() == loader->baseRevision();
+    const QString prevProg = textEdit->getProg();
+    const bool keepHighlighter = patching && textEdit->getLang().isEmpty();
+
     textEdit->setLang(QString());  // remove enforced syntax
 
     // capture view position before changing highlighter on reload
@@ -359,82 +422,85 @@ void TexxyWindow::addText(const QString& text,
     // temporarily remove highlighter to avoid redundant work during setPlainText
     if (textEdit->getHighlighter()) {
         textEdit->setGreenSel(QList<QTextEdit::ExtraSelection>());  // previous finds are meaningless after load
-        syntaxHighlighting(textEdit, false);
+        if (!keepHighlighter)
+            syntaxHighlighting(textEdit, false);
     }
 
     const QFileInfo fInfo(fileName);
     Config& config = static_cast<TexxyApplication*>(qApp)->getConfig();
 
-    // set the text
-    inactiveTabModified_ = true;   // ignore modificationChanged during initial set
-    textEdit->setPlainText(text);  // resets undo/redo
+    // set the text (the document is journaled again when it is loaded)
+    static_cast<TexxyApplication*>(qApp)->getJournal()->untrack(textEdit->document());
+    inactiveTabModified_ = true;  // ignore modificationChanged during initial set
+    if (largeFile) {
+        // only a window of lines is put into the document
+        textEdit->setLargeFile(largeFile, reload ? textEdit->getLargeFirstLine() : 0);
+    }
+    else {
+        if (textEdit->getLargeFile())
+            textEdit->setLargeFile(QSharedPointer<LargeFile>());
+        // a long text comes with its document, so that its blocks aren't created here
+        if (patching)
+            textEdit->applyLineHunks(text, loader->lineHunks());  // an undoable edit
+        else if (QTextDocument* doc = loader ? loader->takeDocument() : nullptr)
+            adoptDocument(textEdit, doc);
+        else
+            textEdit->setPlainText(text);  // resets undo/redo
+    }
     inactiveTabModified_ = false;
 
-    // restore cursor position if requested
-    if (!reload && restoreCursor != 0) {
-        if (restoreCursor == 1 || restoreCursor == -1) {
-            // restore cursor from settings
-            const QHash<QString, QVariant> cursorPos =
-                (restoreCursor == 1) ? config.savedCursorPos() : config.getLastFilesCursorPos();
+    // the line index comes from the loader's scan; a complete text can be checked at once
+    QSharedPointer<LineIndex> lineIndex = loader && !largeFile ? loader->lineIndex() : QSharedPointer<LineIndex>();
+    if (lineIndex && !streaming && lineIndex->lineCount() != textEdit->document()->blockCount())
+        lineIndex.reset();  // other block separators (like U+2029) were decoded
+    textEdit->setLineIndex(lineIndex);
+    // the soft breaks of a streamed text are known with its last part
+    textEdit->setSoftBreaks(loader && !largeFile && !streaming ? loader->softBreaks() : QList<int>());
 
-            auto it = cursorPos.constFind(fileName);
-            if (it != cursorPos.constEnd()) {
-                QTextCursor cur = textEdit->textCursor();
-                cur.movePosition(QTextCursor::End);
-                const int pos = std::clamp(it.value().toInt(), 0, cur.position());
-                cur.setPosition(pos);
-                QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
-            }
-        }
-        else if (restoreCursor < -1) {
-            // doc end in commandline
-            QTextCursor cur = textEdit->textCursor();
-            cur.movePosition(QTextCursor::End);
-            QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
-        }
-        else {
-            // restoreCursor >= 2 means 1-based line number
-            const int line0 = restoreCursor - 2;  // Qt blocks start at 0
-            if (line0 < textEdit->document()->blockCount()) {
-                const QTextBlock block = textEdit->document()->findBlockByNumber(line0);
-                QTextCursor cur(block);
-                QTextCursor tmp = cur;
-                tmp.movePosition(QTextCursor::EndOfBlock);
-                if (posInLine < 0 || posInLine >= tmp.positionInBlock())
-                    cur = tmp;
-                else
-                    cur.setPosition(block.position() + posInLine);
-                QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
-            }
-            else {
-                QTextCursor cur = textEdit->textCursor();
-                cur.movePosition(QTextCursor::End);
-                QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
-            }
-        }
-    }
+    // restore cursor position if requested (a streamed text is complete only later)
+    if (!reload && !streaming)
+        restoreCursorOnLoading(textEdit, fileName, restoreCursor, posInLine);
 
     // file metadata and bookkeeping
     textEdit->setFileName(fileName);
-    textEdit->setSize(fInfo.size());
+    textEdit->setSize(loader ? loader->fileSize() : fInfo.size());  // followed from there
     textEdit->setLastModified(fInfo.lastModified());
+    textEdit->setContentHash(loader ? loader->contentHash() : 0);
+    FileWatcher* watcher = static_cast<TexxyApplication*>(qApp)->getFileWatcher();
+    watcher->watch(fileName, textEdit);
+    if (textEdit->getContentHash() != 0)
+        watcher->noteContent(fileName, fInfo.lastModified(), textEdit->getSize(), textEdit->getContentHash());
     lastFile_ = fileName;
     if (config.getRecentOpened())
         addRecentFile(lastFile_);
     textEdit->setEncoding(charset);
+    textEdit->setLineEnd(loader && !largeFile ? loader->lineEnd() : LineEnd::Lf);
+    textEdit->setMixedLineEnds(loader && !largeFile && loader->hasMixedLineEnds());
     textEdit->setWordNumber(-1);
 
     if (sidePane_ && !fileName.isEmpty())
         sidePane_->revealFile(fileName);
 
     textEdit->makeUneditable(uneditable);
-    if (uneditable) {
+    if (largeFile) {
+        if (!reload)
+            connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningLargeFiles, Qt::UniqueConnection);
+    }
+    else if (loader && loader->isCompressed()) {
+        // a streamed text may still turn out to be truncated (see appendText)
+        connect(this, &TexxyWindow::finishedLoading, this,
+                loader->isTruncated() ? &TexxyWindow::onOpeningTruncatedFiles : &TexxyWindow::onOpeningCompressedFiles,
+                Qt::UniqueConnection);
+    }
+    else if (uneditable) {
         if (!reload)  // on reload this will be connected later
             connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningUneditable, Qt::UniqueConnection);
     }
 
     setProgLang(textEdit);
-    if (ui->actionSyntax->isChecked())
+    if (keepHighlighter && textEdit->getProg() != prevProg)
+        syntaxHighlighting(textEdit, false);
+    if (ui->actionSyntax->isChecked() && !streaming)
         syntaxHighlighting(textEdit);
 
     setTitle(fileName, (multiple && !openInCurrentTab) ? ui->tabWidget->indexOf(tabPage) : -1);
@@ -455,70 +521,25 @@ void TexxyWindow::addText(const QString& text,
     if (!sideItems_.isEmpty()) {
         if (QListWidgetItem* wi = sideItems_.key(tabPage)) {
             wi->setToolTip(elidedTip);
-            if (scrollToFirstItem &&
-                (!firstItem || *(static_cast<ListWidgetItem*>(wi)) < *(static_cast<ListWidgetItem*>(firstItem)))) {
-                firstItem = wi;
+            if (scrollToFirstItem_ && (!firstSideItem_ || *(static_cast<ListWidgetItem*>(wi)) <
+                                                              *(static_cast<ListWidgetItem*>(firstSideItem_)))) {
+                firstSideItem_ = wi;
             }
         }
     }
 
-    // adjust readonly and UI state if uneditable or opened in another tab
-    if (uneditable || alreadyOpen(tabPage)) {
-        textEdit->setReadOnly(true);
-
-        // lightweight palette tweak via stylesheet for readonly view
-        if (!textEdit->hasDarkScheme()) {
-            if (uneditable)
-                textEdit->viewport()->setStyleSheet(
-                    ".QWidget {"
-                    "color: black;"
-                    "background-color: rgb(225, 238, 255);}");
-            else
-                textEdit->viewport()->setStyleSheet(
-                    ".QWidget {"
-                    "color: black;"
-                    "background-color: rgb(236, 236, 208);}");
-        }
-        else {
-            if (uneditable)
-                textEdit->viewport()->setStyleSheet(
-                    ".QWidget {"
-                    "color: white;"
-                    "background-color: rgb(0, 60, 110);}");
-            else
-                textEdit->viewport()->setStyleSheet(
-                    ".QWidget {"
-                    "color: white;"
-                    "background-color: rgb(60, 0, 0);}");
-        }
-
-        if (!multiple || openInCurrentTab) {
-            if (!uneditable)
-                ui->actionEdit->setVisible(true);
-            else {
-                ui->actionSaveAs->setDisabled(true);
-                ui->actionSaveCodec->setDisabled(true);
-            }
-            ui->actionCut->setDisabled(true);
-            ui->actionPaste->setDisabled(true);
-            ui->actionSoftTab->setDisabled(true);
-            ui->actionDate->setDisabled(true);
-            ui->actionDelete->setDisabled(true);
-            ui->actionUpperCase->setDisabled(true);
-            ui->actionLowerCase->setDisabled(true);
-            ui->actionStartCase->setDisabled(true);
-            if (config.getSaveUnmodified())
-                ui->actionSave->setDisabled(true);
-        }
-
-        // disconnect actions that depend on copy availability
-        disconnect(textEdit, &TextEdit::canCopy, ui->actionCut, &QAction::setEnabled);
-        disconnect(textEdit, &TextEdit::canCopy, ui->actionDelete, &QAction::setEnabled);
-        disconnect(textEdit, &QPlainTextEdit::copyAvailable, ui->actionUpperCase, &QAction::setEnabled);
-        disconnect(textEdit, &QPlainTextEdit::copyAvailable, ui->actionLowerCase, &QAction::setEnabled);
-        disconnect(textEdit, &QPlainTextEdit::copyAvailable, ui->actionStartCase, &QAction::setEnabled);
+    // a followed file that is reopened is followed from its new end
+    if (textEdit->isFollowing()) {
+        if (reload && canFollow(textEdit))
+            textEdit->startFollowing();
+        else
+            textEdit->stopFollowing();
     }
-    else if (textEdit->isReadOnly()) {
+
+    // adjust readonly and UI state if uneditable or opened in another tab
+    if (uneditable || alreadyOpen(tabPage))
+        showReadOnly(textEdit, uneditable, !multiple || openInCurrentTab);
+    else if (textEdit->isReadOnly() && !textEdit->isFollowing()) {
         QTimer::singleShot(0, this, &TexxyWindow::makeEditable);
     }
 
@@ -541,6 +562,8 @@ void TexxyWindow::addText(const QString& text,
 
         encodingToCheck(charset);
         ui->actionReload->setEnabled(true);
+        ui->actionFollow->setChecked(textEdit->isFollowing());
+        ui->actionFollow->setEnabled(canFollow(textEdit));
         textEdit->setFocus();
 
         if (openInCurrentTab) {
@@ -551,7 +574,91 @@ void TexxyWindow::addText(const QString& text,
         }
     }
 
-    // a file is completely loaded
+    if (streaming) {
+        // the rest of the text is appended in time slices; the file is loaded after that
+        textEdit->setReadOnly(true);
+        textEdit->startQueuingText();
+        streamedTexts_.insert(loader, textEdit);
+        // if the tab is closed before the rest arrives, the loader is stopped and counted off here
+        const QMetaObject::Connection closed =
+            connect(textEdit, &QObject::destroyed, this, [this, key = static_cast<QObject*>(loader),
+                                                          thread = QPointer<Loading>(loader)] {
+                streamedTexts_.remove(key);
+                if (thread)
+                    static_cast<TexxyApplication*>(qApp)->getLoaderPool()->cancelThread(thread);
+                dropLoadingProcess();
+            });
+        // the line index tells where a line will be, so the cursor can go there when it arrives
+        const bool restoreByIndex = restoreCursor >= 2 && lineIndex;
+        if (restoreByIndex)
+            restoreCursorOnLoading(textEdit, fileName, restoreCursor, posInLine);
+        connect(
+            textEdit, &TextEdit::queuedTextAppended, this,
+            [this, tabPage, textEdit, fileName, restoreCursor, posInLine, restoreByIndex, closed] {
+                disconnect(closed);
+                if (!textEdit->isUneditable() && !alreadyOpen(tabPage))
+                    textEdit->setReadOnly(false);
+                else if (textEdit->isUneditable()) {
+                    // decoding errors may be found only in the last part
+                    const bool current = ui->tabWidget->currentWidget() == tabPage;
+                    showReadOnly(textEdit, true, current);
+                    const Config& config = static_cast<TexxyApplication*>(qApp)->getConfig();
+                    if (current && config.getShowLangSelector() && config.getSyntaxByDefault())
+                        updateLangBtn(textEdit);  // its language cannot be changed anymore
+                }
+                if (ui->tabWidget->currentWidget() == tabPage)
+                    ui->actionFollow->setEnabled(canFollow(textEdit));
+                if (const LineIndex* index = textEdit->getLineIndex();
+                    index && index->lineCount() != textEdit->document()->blockCount())
+                    textEdit->setLineIndex(QSharedPointer<LineIndex>());
+                if (!restoreByIndex)
+                    restoreCursorOnLoading(textEdit, fileName, restoreCursor, posInLine);
+                if (ui->actionSyntax->isChecked())
+                    syntaxHighlighting(textEdit);
+                finishLoading(textEdit, false, textEdit->isUneditable(), TextEdit::viewPosition());
+            },
+            Qt::SingleShotConnection);
+        return;
+    }
+
+    finishLoading(textEdit, reload, uneditable && !largeFile && !(loader && loader->isCompressed()), vPos);
+}
+
+void TexxyWindow::appendText(const QString& text, bool last) {
+    const auto it = streamedTexts_.find(QObject::sender());
+    if (it == streamedTexts_.end())
+        return;
+    const QPointer<TextEdit> textEdit = it.value();
+    if (last)
+        streamedTexts_.erase(it);
+    if (!textEdit)
+        return;
+    if (last) {
+        // the text was guessed to be UTF-8 and isn't; saving it would replace the invalid bytes
+        const auto* loader = qobject_cast<Loading*>(QObject::sender());
+        if (loader && loader->isTruncated()) {
+            disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningCompressedFiles);
+            connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningTruncatedFiles,
+                    Qt::UniqueConnection);
+        }
+        else if (loader && loader->hasDecodingErrors() && !loader->isCompressed()) {
+            textEdit->makeUneditable(true);
+            connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningUneditable, Qt::UniqueConnection);
+        }
+        if (loader)
+            textEdit->setSoftBreaks(loader->softBreaks());  // applied after appending
+    }
+    textEdit->queueText(text, last);
+}
+
+void TexxyWindow::finishLoading(TextEdit* textEdit, bool reload, bool uneditable, const TextEdit::viewPosition& vPos) {
+    // a file is completely loaded; a window of a large file cannot be journaled
+    if (!textEdit->getLargeFile()) {
+        static_cast<TexxyApplication*>(qApp)->getJournal()->track(textEdit->document(), textEdit->getFileName(),
+                                                                   textEdit->getEncoding(), textEdit->getContentHash());
+    }
+    recoverText(textEdit);
+
     --loadingProcesses_;
     if (!isLoading()) {
         ui->tabWidget->tabBar()->lockTabs(false);
@@ -567,14 +674,14 @@ void TexxyWindow::addText(const QString& text,
                 connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningUneditable,
                         Qt::UniqueConnection);
         }
-        else if (firstItem) {
+        else if (firstSideItem_) {
             // select the first item when sidePane exists
-            sidePane_->listWidget()->setCurrentItem(firstItem);
+            sidePane_->listWidget()->setCurrentItem(firstSideItem_);
         }
 
-        // reset static side-pane helpers
-        scrollToFirstItem = false;
-        firstItem = nullptr;
+        // reset side-pane helpers
+        scrollToFirstItem_ = false;
+        firstSideItem_ = nullptr;
 
         closeWarningBar(true);  // allow closing animation to finish
         emit finishedLoading();
@@ -583,6 +690,141 @@ void TexxyWindow::addText(const QString& text,
     }
 }
 
+/* Shows that a text edit is read-only, because its file is uneditable or is
+   opened in another tab, and disables the editing actions if it is current. */
+void TexxyWindow::showReadOnly(TextEdit* textEdit, bool uneditable, bool updateActions) {
+    textEdit->setReadOnly(true);
+
+    // lightweight palette tweak via stylesheet for readonly view
+    if (!textEdit->hasDarkScheme()) {
+        if (uneditable)
+            textEdit->viewport()->setStyleSheet(
+                ".QWidget {"
+                "color: black;"
+                "background-color: rgb(225, 238, 255);}");
+        else
+            textEdit->viewport()->setStyleSheet(
+                ".QWidget {"
+                "color: black;"
+                "background-color: rgb(236, 236, 208);}");
+    }
+    else {
+        if (uneditable)
+            textEdit->viewport()->setStyleSheet(
+                ".QWidget {"
+                "color: white;"
+                "background-color: rgb(0, 60, 110);}");
+        else
+            textEdit->viewport()->setStyleSheet(
+                ".QWidget {"
+                "color: white;"
+                "background-color: rgb(60, 0, 0);}");
+    }
+
+    if (updateActions) {
+        if (!uneditable)
+            ui->actionEdit->setVisible(true);
+        else {
+            ui->actionSaveAs->setDisabled(true);
+            ui->actionSaveCodec->setDisabled(true);
+        }
+        ui->actionCut->setDisabled(true);
+        ui->actionPaste->setDisabled(true);
+        ui->actionSoftTab->setDisabled(true);
+        ui->actionDate->setDisabled(true);
+        ui->actionDelete->setDisabled(true);
+        ui->actionUpperCase->setDisabled(true);
+        ui->actionLowerCase->setDisabled(true);
+        ui->actionStartCase->setDisabled(true);
+        if (static_cast<TexxyApplication*>(qApp)->getConfig().getSaveUnmodified())
+            ui->actionSave->setDisabled(true);
+    }
+
+    // disconnect actions that depend on copy availability
+    disconnect(textEdit, &TextEdit::canCopy, ui->actionCut, &QAction::setEnabled);
+    disconnect(textEdit, &TextEdit::canCopy, ui->actionDelete, &QAction::setEnabled);
+    disconnect(textEdit, &QPlainTextEdit::copyAvailable, ui->actionUpperCase, &QAction::setEnabled);
+    disconnect(textEdit, &QPlainTextEdit::copyAvailable, ui->actionLowerCase, &QAction::setEnabled);
+    disconnect(textEdit, &QPlainTextEdit::copyAvailable, ui->actionStartCase, &QAction::setEnabled);
+}
+
+/* Counts off a loader whose text didn't reach a tab (or whose tab was closed). */
+void TexxyWindow::dropLoadingProcess() {
+    --loadingProcesses_;  // cannot become negative
+    if (!isLoading()) {
+        ui->tabWidget->tabBar()->lockTabs(false);
+        updateShortcuts(false, false);
+        closeWarningBar();
+        emit finishedLoading();
+        QTimer::singleShot(0, this, &TexxyWindow::unbusy);
+        stealFocus();
+    }
+}
+
+void TexxyWindow::restoreCursorOnLoading(TextEdit* textEdit,
+                                         const QString& fileName,
+                                         int restoreCursor,
+                                         int posInLine) {
+    if (LargeFile* largeFile = textEdit->getLargeFile()) {
+        // positions saved as document offsets are meaningless in a window, so only lines are restored
+        if (restoreCursor < -1 || restoreCursor >= 2) {
+            const qint64 line0 = restoreCursor < -1 ? largeFile->lineCount() - 1 : restoreCursor - 2;
+            const int pos = restoreCursor < -1 ? -1 : posInLine;
+            QTimer::singleShot(0, textEdit, [textEdit, line0, pos] { textEdit->goToLargeLine(line0, pos); });
+        }
+    }
+    else if (restoreCursor != 0) {
+        if (restoreCursor == 1 || restoreCursor == -1) {
+            // restore cursor from settings
+            Config& config = static_cast<TexxyApplication*>(qApp)->getConfig();
+            const QHash<QString, QVariant> cursorPos =
+                (restoreCursor == 1) ? config.savedCursorPos() : config.getLastFilesCursorPos();
+
+            auto it = cursorPos.constFind(fileName);
+            if (it != cursorPos.constEnd()) {
+                QTextCursor cur = textEdit->textCursor();
+                cur.movePosition(QTextCursor::End);
+                const int pos = std::clamp(it.value().toInt(), 0, cur.position());
+                cur.setPosition(pos);
+                QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
+            }
+        }
+        else if (restoreCursor < -1) {
+            // doc end in commandline
+            QTextCursor cur = textEdit->textCursor();
+            cur.movePosition(QTextCursor::End);
+            QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
+        }
+        else {
+            // restoreCursor >= 2 means 1-based line number
+            const int line0 = restoreCursor - 2;  // Qt blocks start at 0
+            if (textEdit->isQueuingText()) {
+                // the line count is known from the line index, but the line may not be appended yet
+                if (line0 < textEdit->lineCount())
+                    textEdit->goToLineWhenAppended(line0, posInLine);
+                else
+                    textEdit->goToLineWhenAppended(textEdit->lineCount() - 1, -1);
+            }
+            else if (line0 < textEdit->lineCount()) {
+                const QTextBlock block = textEdit->document()->findBlockByNumber(textEdit->blockOfLine(line0));
+                QTextCursor cur(block);
+                QTextCursor tmp = cur;
+                tmp.movePosition(QTextCursor::EndOfBlock);
+                if (posInLine < 0 || posInLine >= tmp.positionInBlock())
+                    cur = tmp;
+                else
+                    cur.setPosition(block.position() + posInLine);
+                QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
+            }
+            else {
+                QTextCursor cur = textEdit->textCursor();
+                cur.movePosition(QTextCursor::End);
+                QTimer::singleShot(0, textEdit, [textEdit, cur] { textEdit->setTextCursor(cur); });
+            }
+        }
+    }
+}
+
 void TexxyWindow::disconnectLambda() {
     QObject::disconnect(lambdaConnection_);
 }
@@ -591,7 +833,36 @@ void TexxyWindow::onOpeningHugeFiles() {
     disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningHugeFiles);
     QTimer::singleShot(0, this, [=]() {
         showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
-                           .arg(tr("Huge file(s) not opened!"), tr("Texxy does not open files larger than 100 MiB.")));
+                           .arg(tr("Huge file(s) not opened!"),
+                                tr("Files larger than 100 MiB can be viewed only in UTF-8 or 8-bit encodings.")));
+    });
+}
+
+void TexxyWindow::onOpeningLargeFiles() {
+    disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningLargeFiles);
+    QTimer::singleShot(0, this, [=]() {
+        showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
+                           .arg(tr("Large file(s) opened read-only!"),
+                                tr("Files larger than 100 MiB are shown a part at a time and cannot be edited.")));
+    });
+}
+
+void TexxyWindow::onOpeningCompressedFiles() {
+    disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningCompressedFiles);
+    QTimer::singleShot(0, this, [=]() {
+        showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
+                           .arg(tr("Compressed file(s) opened read-only!"),
+                                tr("Compressed files are decompressed for viewing and cannot be edited.")));
+    });
+}
+
+void TexxyWindow::onOpeningTruncatedFiles() {
+    disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningTruncatedFiles);
+    QTimer::singleShot(0, this, [=]() {
+        showWarningBar(
+            QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
+                .arg(tr("Compressed file(s) opened in part!"),
+                     tr("Damaged files, and files larger than 100 MiB when decompressed, are shown only in part.")));
     });
 }
 
@@ -620,23 +891,77 @@ void TexxyWindow::onOpeningUneditable() {
     QTimer::singleShot(0, this, [=]() {
         showWarningBar(
             QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
-                .arg(tr("Uneditable file(s)!"), tr("Non-text files or files with huge lines cannot be edited.")));
+                .arg(tr("Uneditable file(s)!"), tr("Non-text files cannot be edited.")));
     });
 }
 
 void TexxyWindow::onOpeningNonexistent() {
     disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningNonexistent);
     QTimer::singleShot(0, this, [=]() {
-        // show the bar only if the current file doesn't exist at this very moment
+        // show the bar only if the current file doesn't exist now
         if (TabPage* tabPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget())) {
             const QString fname = tabPage->textEdit()->getFileName();
-            if (!fname.isEmpty() && !QFile::exists(fname))
+            if (fname.isEmpty())
+                return;
+            // the file system is accessed only if the file watcher doesn't know the file
+            const FileWatcher::State state = static_cast<TexxyApplication*>(qApp)->getFileWatcher()->state(fname);
+            if (state.known ? !state.exists : !QFile::exists(fname))
                 showWarningBar(
                     QStringLiteral("<center><b><big>%1</big></b></center>").arg(tr("The file does not exist.")));
         }
     });
 }
 
+/* Warns about a file that is removed or modified elsewhere, as far as the file
+   watcher knows; the file system isn't accessed here. */
+void TexxyWindow::warnAboutFileState(TextEdit* textEdit) {
+    const QString fname = textEdit->getFileName();
+    if (fname.isEmpty())
+        return;
+    const FileWatcher::State state = static_cast<TexxyApplication*>(qApp)->getFileWatcher()->state(fname);
+    if (!state.known)
+        return;
+    if (!state.exists) {
+        if (isLoading())
+            connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onOpeningNonexistent,
+                    Qt::UniqueConnection);
+        else
+            onOpeningNonexistent();
+    }
+    else if (!textEdit->isFollowing() && textEdit->getLastModified() != state.lastModified) {
+        if (state.sameContent) {  // only touched
+            textEdit->setLastModified(state.lastModified);
+            return;
+        }
+        showWarningBar(QStringLiteral("<center><b><big>") +
+                           tr("This file has been modified elsewhere or in another way!") +
+                           QStringLiteral("</big></b></center>\n<center>") +
+                           tr("Please be careful about reloading or saving this document!") +
+                           QStringLiteral("</center>"),
+                       15);
+    }
+}
+
+void TexxyWindow::onFileStateChanged(const QString& path) {
+    // a large file is checked for a truncation here rather than before each read of it
+    for (int i = 0; i < ui->tabWidget->count(); ++i) {
+        auto* tabPage = qobject_cast<TabPage*>(ui->tabWidget->widget(i));
+        if (tabPage && tabPage->textEdit()->getFileName() == path) {
+            if (LargeFile* largeFile = tabPage->textEdit()->getLargeFile())
+                largeFile->checkFile();
+        }
+    }
+
+    TextEdit* textEdit = currentTextEdit();
+    if (textEdit == nullptr || textEdit->getFileName() != path)
+        return;
+    auto* singleton = static_cast<TexxyApplication*>(qApp);
+    ui->actionRun->setVisible(isScriptLang(textEdit->getProg()) && singleton->getConfig().getExecuteScripts() &&
+                              singleton->getFileWatcher()->state(path).executable);
+    if (isActiveWindow())  // otherwise, the state is checked on activation
+        warnAboutFileState(textEdit);
+}
+
 void TexxyWindow::columnWarning() {
     showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
                        .arg(tr("Huge column!"), tr("Columns with more than 1000 rows are not supported.")));
@@ -827,6 +1152,60 @@ void TexxyWindow::reload() {
         loadText(fname, false, true, textEdit->getSaveCursor() ? 1 : 0);
 }
 
+bool TexxyWindow::canFollow(TextEdit* textEdit) const {
+    // only what is shown as it is in the file can be appended to
+    return textEdit && !textEdit->getFileName().isEmpty() && !textEdit->document()->isModified() &&
+           !textEdit->isUneditable() && !textEdit->getLargeFile() && !textEdit->isQueuingText();
+}
+
+void TexxyWindow::toggleFollowing(bool follow) {
+    TabPage* tabPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget());
+    if (!tabPage)
+        return;
+    TextEdit* textEdit = tabPage->textEdit();
+    if (follow == textEdit->isFollowing())
+        return;
+
+    if (follow) {
+        if (isLoading() || !canFollow(textEdit)) {
+            ui->actionFollow->setChecked(false);
+            return;
+        }
+        textEdit->startFollowing();
+        textEdit->setReadOnly(true);  // the text is the file's
+        QTextCursor cur = textEdit->textCursor();
+        cur.movePosition(QTextCursor::End);
+        textEdit->setTextCursor(cur);
+        textEdit->ensureCursorVisible();
+    }
+    else {
+        textEdit->stopFollowing();
+        if (!alreadyOpen(tabPage))
+            textEdit->setReadOnly(false);
+    }
+    tabSwitch(ui->tabWidget->currentIndex());  // update the actions
+}
+
+void TexxyWindow::onFollowedFileReplaced() {
+    // a followed file in another tab is reopened when its tab is selected (see tabSwitch)
+    auto* tabPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget());
+    if (tabPage && tabPage->textEdit() == QObject::sender())
+        reopenFollowed();
+}
+
+void TexxyWindow::reopenFollowed() {
+    disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::reopenFollowed);
+    auto* tabPage = qobject_cast<TabPage*>(ui->tabWidget->currentWidget());
+    if (!tabPage || !tabPage->textEdit()->needsReopening())
+        return;
+    if (isLoading()) {
+        connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::reopenFollowed, Qt::UniqueConnection);
+        return;
+    }
+    // a truncated or rotated file is loaded again and followed from its new end
+    loadText(tabPage->textEdit()->getFileName(), false, true);
+}
+
 void TexxyWindow::reloadSyntaxHighlighter(TextEdit* textEdit) {
     // uninstall and reinstall the syntax highlighter if the programming language is changed
     const QString prevLan = textEdit->getProg();
@@ -1055,8 +1434,12 @@ void TexxyWindow::statusMsgWithLineCount(const int lines) {
         syntaxStr = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1</b> <i>%2</i>").arg(tr("Syntax:"), textEdit->getProg());
 
     const QLocale l = locale();
+    // a large file has more lines than its loaded window, a streamed one more than it has received
+    // and a file with split lines fewer than its blocks
+    const bool fileLines = textEdit->getLargeFile() || textEdit->isQueuingText() || textEdit->hasSoftBreaks();
+    const qint64 total = fileLines ? textEdit->lineCount() : lines;
     const QString lineStr =
-        QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1</b> <i>%2</i>").arg(tr("Lines:"), l.toString(lines));
+        QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1</b> <i>%2</i>").arg(tr("Lines:"), l.toString(total));
     const QString selStr = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1</b> <i>%2</i>")
                                .arg(tr("Sel. Chars:"), l.toString(textEdit->selectionSize()));
     const QString wordStr = QStringLiteral("&nbsp;&nbsp;&nbsp;<b>%1</b>").arg(tr("Words"));
@@ -1092,7 +1475,9 @@ void TexxyWindow::showCursorPos() {
     if (!tabPage)
         return;
 
-    const int pos = tabPage->textEdit()->textCursor().positionInBlock();
+    TextEdit* textEdit = tabPage->textEdit();
+    const int pos = textEdit->hasSoftBreaks() ? textEdit->positionInLine(textEdit->textCursor())
+                                              : textEdit->textCursor().positionInBlock();
     const QString charN = QStringLiteral("<i> %1</i>").arg(locale().toString(pos));
     QString str = posLabel->text();
     const QString scursorStr = QStringLiteral("<b>%1</b>").arg(tr("Position:"));
@@ -1,6 +1,7 @@
 // src/ui/window_edit.cpp
 
 #include "texxy_ui_prelude.h"
+#include <climits>
 
 namespace Texxy {
 
@@ -605,7 +606,7 @@ void TexxyWindow::jumpTo() {
 
     if (TabPage* tabPage = curTab(this)) {
         if (!visibility && ui->tabWidget->count() > 0)
-            ui->spinBox->setMaximum(tabPage->textEdit()->document()->blockCount());
+            setMax(tabPage->textEdit()->document()->blockCount());
     }
     ui->spinBox->setVisible(!visibility);
     ui->label->setVisible(!visibility);
@@ -620,6 +621,14 @@ void TexxyWindow::jumpTo() {
 }
 
 void TexxyWindow::setMax(const int max) {
+    // the block count of a large file is that of its window, a streamed file may have more lines
+    // and the segments of split lines aren't lines of the file
+    if (TextEdit* te = curEdit(this)) {
+        if (te->getLargeFile() || te->isQueuingText() || te->hasSoftBreaks()) {
+            ui->spinBox->setMaximum(static_cast<int>(std::min<qint64>(te->lineCount(), INT_MAX)));
+            return;
+        }
+    }
     ui->spinBox->setMaximum(max);
 }
 
@@ -629,7 +638,15 @@ void TexxyWindow::goTo() {
         return;
 
     if (TextEdit* te = curEdit(this)) {
-        QTextBlock block = te->document()->findBlockByNumber(ui->spinBox->value() - 1);
+        if (te->getLargeFile()) {
+            te->goToLargeLine(ui->spinBox->value() - 1);
+            return;
+        }
+        if (te->isQueuingText() && ui->spinBox->value() > te->document()->blockCount() - 1) {
+            te->goToLineWhenAppended(ui->spinBox->value() - 1);
+            return;
+        }
+        QTextBlock block = te->document()->findBlockByNumber(te->blockOfLine(ui->spinBox->value() - 1));
         const int pos = block.position();
         QTextCursor start = te->textCursor();
         if (ui->checkBox->isChecked())
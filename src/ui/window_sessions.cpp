@@ -169,4 +169,84 @@ void TexxyWindow::autoSave() {
     });
 }
 
+/* Opens the unsaved texts of a process that didn't end properly (see Journal).
+   An untitled text gets a tab of its own, while the text of a file is put into
+   its document when the file is loaded (see recoverText). */
+void TexxyWindow::recoverDocuments(const QList<Journal::Recovery>& recoveries) {
+    for (const Journal::Recovery& recovery : recoveries) {
+        if (recovery.fileName.isEmpty()) {
+            replayRecovery(createEmptyTab(!isLoading()), recovery);
+        }
+        else if (!recoveries_.contains(recovery.fileName)) {
+            recoveries_.insert(recovery.fileName, recovery);
+            newTabFromName(recovery.fileName, 0, 0, true);
+        }
+    }
+    if (!recoveries_.isEmpty())
+        connect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onRecoveringFiles, Qt::UniqueConnection);
+}
+
+/* Called when a file is loaded. The edits of a journal that started from the file
+   are replayed only if the file has the same text. */
+void TexxyWindow::recoverText(TextEdit* textEdit) {
+    const auto it = recoveries_.constFind(textEdit->getFileName());
+    if (it == recoveries_.constEnd())
+        return;
+    TabPage* tabPage = nullptr;
+    for (int i = 0; i < ui->tabWidget->count(); ++i) {
+        auto* page = qobject_cast<TabPage*>(ui->tabWidget->widget(i));
+        if (page && page->textEdit() == textEdit) {
+            tabPage = page;
+            break;
+        }
+    }
+    if (!tabPage || textEdit->getLargeFile() || textEdit->isUneditable() || alreadyOpen(tabPage))
+        return;  // see onRecoveringFiles()
+    if (it->fromFile && (it->contentHash != textEdit->getContentHash() ||
+                         it->characterCount != textEdit->document()->characterCount())) {
+        return;
+    }
+    const Journal::Recovery recovery = it.value();
+    recoveries_.erase(it);
+    replayRecovery(tabPage, recovery);
+}
+
+void TexxyWindow::replayRecovery(TabPage* tabPage, const Journal::Recovery& recovery) {
+    // the recovered text is an undoable edit, so the document is modified
+    const bool current = tabPage == ui->tabWidget->currentWidget();
+    inactiveTabModified_ = !current;
+    recovery.replay(tabPage->textEdit()->document());
+    inactiveTabModified_ = false;
+    if (current)
+        return;
+    const int index = ui->tabWidget->indexOf(tabPage);
+    ui->tabWidget->setTabText(index, QLatin1Char('*') + ui->tabWidget->tabText(index));
+    if (sidePane_ && !sideItems_.isEmpty()) {
+        if (QListWidgetItem* wi = sideItems_.key(tabPage))
+            wi->setText(wi->text() + QLatin1Char('*'));
+    }
+}
+
+/* The texts that couldn't be put into their files when loading finished. A snapshot
+   is opened as an untitled text, but the edits of a changed file are lost. */
+void TexxyWindow::onRecoveringFiles() {
+    disconnect(this, &TexxyWindow::finishedLoading, this, &TexxyWindow::onRecoveringFiles);
+    bool lost = false;
+    for (const Journal::Recovery& recovery : std::as_const(recoveries_)) {
+        if (recovery.fromFile)
+            lost = true;
+        else
+            replayRecovery(createEmptyTab(false), recovery);
+    }
+    recoveries_.clear();
+    if (lost) {
+        QTimer::singleShot(0, this, [=]() {
+            showWarningBar(QStringLiteral("<center><b><big>%1</big></b></center>\n<center>%2</center>")
+                               .arg(tr("Some unsaved changes could not be recovered!"),
+                                    tr("Their files were changed after the changes were made.")),
+                           20);
+        });
+    }
+}
+
 }  // namespace Texxy
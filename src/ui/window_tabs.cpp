@@ -455,7 +455,8 @@ void TexxyWindow::changeTab(QListWidgetItem* current) {
 void TexxyWindow::onTabChanged(int index) {
     if (index > -1) {
         const QString fname = qobject_cast<TabPage*>(ui->tabWidget->widget(index))->textEdit()->getFileName();
-        if (fname.isEmpty() || QFile::exists(fname))
+        const FileWatcher::State state = static_cast<TexxyApplication*>(qApp)->getFileWatcher()->state(fname);
+        if (fname.isEmpty() || !state.known || state.exists)
             closeWarningBar();
     }
     else {
@@ -471,6 +472,8 @@ void TexxyWindow::tabSwitch(int index) {
         if (auto* label = qobject_cast<QLabel*>(ui->menuBar->cornerWidget()))
             label->clear();
         setWindowModified(false);
+        ui->actionFollow->setChecked(false);
+        ui->actionFollow->setEnabled(false);
         return;
     }
 
@@ -481,6 +484,7 @@ void TexxyWindow::tabSwitch(int index) {
     const QString fname = textEdit->getFileName();
     const bool modified = textEdit->document()->isModified();
 
+    FileWatcher* fileWatcher = static_cast<TexxyApplication*>(qApp)->getFileWatcher();
     QFileInfo info;
     QString shownName;
     if (fname.isEmpty()) {
@@ -491,14 +495,9 @@ void TexxyWindow::tabSwitch(int index) {
     else {
         info.setFile(fname);
         shownName = (fname.contains(QLatin1Char('/')) ? fname : info.absolutePath() + QLatin1Char('/') + fname);
-        if (!QFile::exists(fname))
-            onOpeningNonexistent();
-        else if (textEdit->getLastModified() != info.lastModified())
-            showWarningBar(
-                QStringLiteral("<center><b><big>") + tr("This file has been modified elsewhere or in another way!") +
-                    QStringLiteral("</big></b></center>\n<center>") +
-                    tr("Please be careful about reloading or saving this document!") + QStringLiteral("</center>"),
-                15);
+        // the cached state is used now; a change found by the new check comes later
+        warnAboutFileState(textEdit);
+        fileWatcher->refresh(fname);
     }
     if (modified)
         shownName.prepend(QLatin1Char('*'));
@@ -518,13 +517,17 @@ void TexxyWindow::tabSwitch(int index) {
         ui->actionSave->setDisabled(readOnly || textEdit->isUneditable());
 
     ui->actionReload->setEnabled(!fname.isEmpty());
+    ui->actionFollow->setChecked(textEdit->isFollowing());
+    ui->actionFollow->setEnabled(canFollow(textEdit));
+    if (textEdit->needsReopening())
+        QTimer::singleShot(0, this, &TexxyWindow::reopenFollowed);  // it was replaced in the background
     if (fname.isEmpty() && !modified && !textEdit->document()->isEmpty()) {
         ui->actionEdit->setVisible(false);
         ui->actionSaveAs->setEnabled(true);
         ui->actionSaveCodec->setEnabled(true);
     }
     else {
-        ui->actionEdit->setVisible(readOnly && !textEdit->isUneditable());
+        ui->actionEdit->setVisible(readOnly && !textEdit->isUneditable() && !textEdit->isFollowing());
         ui->actionSaveAs->setEnabled(!textEdit->isUneditable());
         ui->actionSaveCodec->setEnabled(!textEdit->isUneditable());
     }
@@ -542,13 +545,13 @@ void TexxyWindow::tabSwitch(int index) {
     ui->actionLowerCase->setEnabled(!readOnly && textIsSelected);
     ui->actionStartCase->setEnabled(!readOnly && textIsSelected);
 
-    if (isScriptLang(textEdit->getProg()) && info.isExecutable())
+    if (isScriptLang(textEdit->getProg()) && fileWatcher->state(fname).executable)
         ui->actionRun->setVisible(config.getExecuteScripts());
     else
         ui->actionRun->setVisible(false);
 
     if (ui->spinBox->isVisible())
-        ui->spinBox->setMaximum(textEdit->document()->blockCount());
+        setMax(textEdit->document()->blockCount());
 
     if (ui->statusBar->isVisible()) {
         statusMsgWithLineCount(textEdit->document()->blockCount());
@@ -976,6 +979,7 @@ void TexxyWindow::detachTab() {
     disconnect(textEdit, &QWidget::customContextMenuRequested, this, &TexxyWindow::editorContextMenu);
     disconnect(textEdit, &TextEdit::zoomedOut, this, &TexxyWindow::reformat);
     disconnect(textEdit, &TextEdit::hugeColumn, this, &TexxyWindow::columnWarning);
+    disconnect(textEdit, &TextEdit::followedFileReplaced, this, &TexxyWindow::onFollowedFileReplaced);
     disconnect(textEdit, &TextEdit::filePasted, this, &TexxyWindow::newTabFromName);
     disconnect(textEdit, &TextEdit::updateBracketMatching, this, &TexxyWindow::matchBrackets);
     disconnect(textEdit, &QPlainTextEdit::blockCountChanged, this, &TexxyWindow::formatOnBlockChange);
@@ -1081,7 +1085,7 @@ void TexxyWindow::detachTab() {
     if (spin) {
         dropTarget->ui->spinBox->setVisible(true);
         dropTarget->ui->label->setVisible(true);
-        dropTarget->ui->spinBox->setMaximum(textEdit->document()->blockCount());
+        dropTarget->setMax(textEdit->document()->blockCount());
         connect(textEdit->document(), &QTextDocument::blockCountChanged, dropTarget, &TexxyWindow::setMax);
     }
     if (ln)
@@ -1147,6 +1151,7 @@ void TexxyWindow::detachTab() {
     connect(textEdit, &TextEdit::filePasted, dropTarget, &TexxyWindow::newTabFromName);
     connect(textEdit, &TextEdit::zoomedOut, dropTarget, &TexxyWindow::reformat);
     connect(textEdit, &TextEdit::hugeColumn, dropTarget, &TexxyWindow::columnWarning);
+    connect(textEdit, &TextEdit::followedFileReplaced, dropTarget, &TexxyWindow::onFollowedFileReplaced);
     connect(textEdit, &QWidget::customContextMenuRequested, dropTarget, &TexxyWindow::editorContextMenu);
 
     textEdit->setFocus();
@@ -1207,6 +1212,7 @@ void TexxyWindow::dropTab(const QString& str, QObject* source) {
     disconnect(textEdit, &QWidget::customContextMenuRequested, dragSource, &TexxyWindow::editorContextMenu);
     disconnect(textEdit, &TextEdit::zoomedOut, dragSource, &TexxyWindow::reformat);
     disconnect(textEdit, &TextEdit::hugeColumn, dragSource, &TexxyWindow::columnWarning);
+    disconnect(textEdit, &TextEdit::followedFileReplaced, dragSource, &TexxyWindow::onFollowedFileReplaced);
     disconnect(textEdit, &TextEdit::filePasted, dragSource, &TexxyWindow::newTabFromName);
     disconnect(textEdit, &TextEdit::updateBracketMatching, dragSource, &TexxyWindow::matchBrackets);
     disconnect(textEdit, &QPlainTextEdit::blockCountChanged, dragSource, &TexxyWindow::formatOnBlockChange);
@@ -1372,6 +1378,7 @@ void TexxyWindow::dropTab(const QString& str, QObject* source) {
     connect(textEdit, &TextEdit::filePasted, this, &TexxyWindow::newTabFromName);
     connect(textEdit, &TextEdit::zoomedOut, this, &TexxyWindow::reformat);
     connect(textEdit, &TextEdit::hugeColumn, this, &TexxyWindow::columnWarning);
+    connect(textEdit, &TextEdit::followedFileReplaced, this, &TexxyWindow::onFollowedFileReplaced);
     connect(textEdit, &QWidget::customContextMenuRequested, this, &TexxyWindow::editorContextMenu);
 
     textEdit->setFocus();